@@ -0,0 +1,13 @@
+#include <benchmark/benchmark.h>
+
+// Benchmarks register themselves (statically or via registrars reading HB_BENCH_* env vars); this main only
+// runs them so every bench file can add inputs without touching a shared list.
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
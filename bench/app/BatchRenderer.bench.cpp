@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "app/BatchRenderer.h"
+#include "support/BenchGraphicsContext.h"
+
+// Throughput of the batch renderer over an in-memory corpus as the worker count grows. Items are documents, so
+// items_per_second should scale with the thread count until memory bandwidth (or the machine) runs out. Real time is
+// reported because the work happens on threads the benchmark does not time itself.
+
+namespace {
+constexpr int kCorpusSize = 64;
+
+std::string make_page_html(int index) {
+    std::string html = "<html><head><style>h1 { margin: 8px; } .note { padding: 4px; } td { padding: 2px; }</style>";
+    html += "</head><body><h1>Page " + std::to_string(index) + "</h1>";
+    for (int p = 0; p < 20 + index % 7 * 10; ++p) {
+        html += "<p>Paragraph " + std::to_string(p) +
+                " with enough ordinary words in it to wrap across several lines of the viewport, <b>some bold</b> "
+                "and <i>some italic</i> runs, and <span class=\"note\">an annotated span</span>.</p>";
+    }
+    html += "<table>";
+    for (int r = 0; r < 10 + index % 3 * 10; ++r) {
+        html += "<tr><td>" + std::to_string(r) + "</td><td>name</td><td>a longer free text cell</td></tr>";
+    }
+    html += "</table></body></html>";
+    return html;
+}
+
+struct Corpus {
+    std::vector<std::string> inputs;
+    std::map<std::string, std::string> pages;
+};
+
+const Corpus& corpus() {
+    static const Corpus instance = [] {
+        Corpus c;
+        for (int i = 0; i < kCorpusSize; ++i) {
+            c.inputs.push_back("page" + std::to_string(i));
+            c.pages.emplace(c.inputs.back(), make_page_html(i));
+        }
+        return c;
+    }();
+    return instance;
+}
+
+std::optional<std::string> load_page(const std::string& input) {
+    return corpus().pages.at(input);
+}
+
+BatchSettings make_settings(benchmark::State& state) {
+    BatchSettings settings;
+    settings.width = 1024;
+    settings.height = 768;
+    settings.worker_count = static_cast<size_t>(state.range(0));
+    return settings;
+}
+
+std::unique_ptr<IOffscreenGraphicsContext> make_bench_context(int width, int height) {
+    return std::make_unique<BenchOffscreenContext>(width, height);
+}
+
+// One renderer for the whole run: the steady state of a long batch, with warm workers and recycled arenas.
+void BM_BatchRender(benchmark::State& state) {
+    BatchRenderer renderer(make_settings(state), nullptr, make_bench_context);
+    renderer.render(corpus().inputs, load_page);
+    for (auto _ : state) {
+        auto results = renderer.render(corpus().inputs, load_page);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kCorpusSize);
+}
+BENCHMARK(BM_BatchRender)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// A new renderer per batch: pays for worker setup, UA stylesheet parsing and first-touch arena pages every time.
+void BM_BatchRenderCold(benchmark::State& state) {
+    for (auto _ : state) {
+        BatchRenderer renderer(make_settings(state), nullptr, make_bench_context);
+        auto results = renderer.render(corpus().inputs, load_page);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kCorpusSize);
+}
+BENCHMARK(BM_BatchRenderCold)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+}  // namespace
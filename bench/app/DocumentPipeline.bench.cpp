@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "app/DocumentPipeline.h"
+#include "renderer/Painter.h"
+#include "renderer/RecordingGraphicsContext.h"
+#include "support/AllocationMeter.h"
+#include "support/SyntheticDocument.h"
+
+// One navigation through a warm pipeline: parse, style, render tree, full layout and paint of a synthetic page whose
+// stylesheet sits in a <style> block, then the document goes back to the pipeline for reuse. Reports the heap
+// allocations of every stage per navigation ("parse_allocs", "style_bytes", ...); these are the counters
+// check_allocation_budgets.py holds to allocation_budgets.json.
+
+namespace {
+constexpr float kViewportWidth = 1024.0f;
+constexpr float kViewportHeight = 768.0f;
+
+std::string make_styled_page(int section_count) {
+    std::string html = BenchDocuments::make_page_html(section_count);
+    html.insert(html.find("</head>"), "<style>" + BenchDocuments::make_page_css() + "</style>");
+    return html;
+}
+
+void BM_PipelineNavigation(benchmark::State& state) {
+    const std::string html = make_styled_page(static_cast<int>(state.range(0)));
+    Hummingbird::Renderer::RecordingGraphicsContext context;
+    DocumentPipeline pipeline(context, nullptr, DocumentPipeline::load_ua_stylesheet(nullptr));
+    Hummingbird::Renderer::Painter painter;
+    const Hummingbird::Layout::Rect viewport{0.0f, 0.0f, kViewportWidth, kViewportHeight};
+    Hummingbird::Renderer::PaintOptions options;
+    options.viewport = viewport;
+
+    uint64_t nav_id = 0;
+    auto navigate = [&] {
+        auto document = pipeline.build(++nav_id, html, viewport, LayoutScope::Full);
+        {
+            Hummingbird::Core::Allocations::StageScope allocation_stage(Hummingbird::Core::Allocations::Stage::Paint);
+            context.reset();
+            painter.paint(*document->render_tree, context, options);
+        }
+        pipeline.recycle(std::move(document));
+    };
+    // The first navigation misses the stylesheet cache, grows the arena and interns every string; keep it out of
+    // both the timing and the allocation counters.
+    navigate();
+    BenchAllocations::AllocationMeter allocations;
+    for (auto _ : state) {
+        navigate();
+        allocations.iteration_done();
+    }
+    allocations.report_stages(state);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(html.size()));
+}
+}  // namespace
+
+BENCHMARK(BM_PipelineNavigation)->Apply(BenchDocuments::apply_document_sizes)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""Holds HummingbirdBench allocation counters to the budgets in allocation_budgets.json.
+
+    python3 bench/check_allocation_budgets.py build/Release/HummingbirdBench
+    python3 bench/check_allocation_budgets.py build/Release/HummingbirdBench --update
+
+Runs the budgeted benchmarks at the document size the budget file names (HB_BENCH_SECTIONS) and compares their
+steady-state allocation counters (see bench/support/AllocationMeter.h), which do not depend on timing or iteration
+counts. Exits with status 1 when a counter grows past its budget by more than the file's tolerance, or when a
+budgeted benchmark or counter is missing. --update rewrites the budgets from the current run, for commits that
+change allocation behavior on purpose.
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+DEFAULT_BUDGETS = os.path.join(os.path.dirname(os.path.abspath(__file__)), "allocation_budgets.json")
+
+
+def run_benchmarks(bench, names, sections):
+    pattern = "^(" + "|".join(re.escape(name) for name in names) + ")$"
+    env = dict(os.environ, HB_BENCH_SECTIONS=str(sections))
+    result = subprocess.run(
+        [bench, f"--benchmark_filter={pattern}", "--benchmark_format=json", "--benchmark_min_time=0.01"],
+        env=env,
+        check=True,
+        stdout=subprocess.PIPE,
+        text=True,
+    )
+    report = json.loads(result.stdout)
+    return {run["name"]: run for run in report["benchmarks"] if run.get("run_type") != "aggregate"}
+
+
+def check(budgets, runs, tolerance):
+    failures = []
+    for name, counters in sorted(budgets.items()):
+        run = runs.get(name)
+        if run is None:
+            failures.append(f"{name}: benchmark did not run")
+            continue
+        for counter, budget in sorted(counters.items()):
+            if counter not in run:
+                failures.append(f"{name}: no counter {counter} (are the allocation hooks linked in?)")
+                continue
+            value = run[counter]
+            limit = budget * (1.0 + tolerance)
+            change = (value - budget) / budget * 100.0 if budget else 0.0
+            status = "ok"
+            if value > limit:
+                status = "OVER BUDGET"
+                failures.append(f"{name}: {counter} {value:.0f} > budget {budget:.0f} (+{change:.1f}%)")
+            elif value < budget * (1.0 - tolerance):
+                status = "below budget, consider --update"
+            print(f"{name:<32} {counter:<22} {value:>12.0f} {budget:>12.0f} {change:>+7.1f}%  {status}")
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("bench", help="path to the HummingbirdBench executable")
+    parser.add_argument("--budgets", default=DEFAULT_BUDGETS, help="budget file (default: %(default)s)")
+    parser.add_argument("--update", action="store_true", help="rewrite the budgets from this run")
+    args = parser.parse_args()
+
+    with open(args.budgets, encoding="utf-8") as f:
+        config = json.load(f)
+    budgets = config["benchmarks"]
+    runs = run_benchmarks(args.bench, budgets.keys(), config["sections"])
+
+    if args.update:
+        for name, counters in budgets.items():
+            for counter in counters:
+                if name in runs and counter in runs[name]:
+                    counters[counter] = round(runs[name][counter])
+        with open(args.budgets, "w", encoding="utf-8") as f:
+            json.dump(config, f, indent=2)
+            f.write("\n")
+        print(f"updated {args.budgets}")
+        return 0
+
+    failures = check(budgets, runs, config["tolerance"])
+    for failure in failures:
+        print(f"error: {failure}", file=sys.stderr)
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,143 @@
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "corpus/PageGenerator.h"
+
+// Writes a generated corpus to disk:
+//
+//   HummingbirdCorpus --out DIR [--seed N] [--pages N] [--nodes N[,N...]] [--depth N] [--fan-out N] [--words N]
+//                     [--attributes N] [--classes N] [--tables N] [--table-rows N] [--table-columns N] [--rules N]
+//
+// Every node count gets --pages pages with consecutive seeds, named nodes<N>-seed<S>.html with the stylesheet
+// inlined. DIR/corpus.txt lists them all, so `Hummingbird --headless @DIR/corpus.txt` renders the corpus.
+
+namespace {
+template <typename T>
+std::optional<T> parse_number(std::string_view text) {
+    T value{};
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc() || end != text.data() + text.size()) return std::nullopt;
+    return value;
+}
+
+std::optional<std::vector<size_t>> parse_list(std::string_view text) {
+    std::vector<size_t> values;
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = text.find(',', start);
+        if (end == std::string_view::npos) end = text.size();
+        auto value = parse_number<size_t>(text.substr(start, end - start));
+        if (!value) return std::nullopt;
+        values.push_back(*value);
+        start = end + 1;
+    }
+    return values;
+}
+
+void print_usage() {
+    std::cerr << "usage: HummingbirdCorpus --out DIR [--seed N] [--pages N] [--nodes N[,N...]] [--depth N] "
+                 "[--fan-out N] [--words N] [--attributes N] [--classes N] [--tables N] [--table-rows N] "
+                 "[--table-columns N] [--rules N]\n";
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    PageCorpus::PageShape shape;
+    std::filesystem::path output_dir;
+    std::vector<size_t> node_counts = {shape.node_count};
+    int page_count = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (i + 1 >= argc) {
+            print_usage();
+            return 2;
+        }
+        const std::string_view value = argv[++i];
+        bool valid = true;
+        auto set_int = [&](int& target) {
+            auto parsed = parse_number<int>(value);
+            valid = parsed && *parsed >= 0;
+            if (valid) target = *parsed;
+        };
+        if (arg == "--out") {
+            output_dir = value;
+        } else if (arg == "--seed") {
+            auto parsed = parse_number<uint64_t>(value);
+            valid = parsed.has_value();
+            if (valid) shape.seed = *parsed;
+        } else if (arg == "--nodes") {
+            auto parsed = parse_list(value);
+            valid = parsed.has_value();
+            if (valid) node_counts = std::move(*parsed);
+        } else if (arg == "--rules") {
+            auto parsed = parse_number<size_t>(value);
+            valid = parsed.has_value();
+            if (valid) shape.rule_count = *parsed;
+        } else if (arg == "--pages") {
+            set_int(page_count);
+        } else if (arg == "--depth") {
+            set_int(shape.max_depth);
+        } else if (arg == "--fan-out") {
+            set_int(shape.fan_out);
+        } else if (arg == "--words") {
+            set_int(shape.words_per_text);
+        } else if (arg == "--attributes") {
+            set_int(shape.attributes_per_element);
+        } else if (arg == "--classes") {
+            set_int(shape.class_count);
+        } else if (arg == "--tables") {
+            set_int(shape.table_count);
+        } else if (arg == "--table-rows") {
+            set_int(shape.table_rows);
+        } else if (arg == "--table-columns") {
+            set_int(shape.table_columns);
+        } else {
+            std::cerr << "unknown option: " << arg << "\n";
+            print_usage();
+            return 2;
+        }
+        if (!valid) {
+            std::cerr << "invalid " << arg << ": " << value << "\n";
+            return 2;
+        }
+    }
+    if (output_dir.empty()) {
+        print_usage();
+        return 2;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(output_dir, ec);
+    std::ofstream list(output_dir / "corpus.txt");
+    if (!list) {
+        std::cerr << "cannot write to " << output_dir << "\n";
+        return 1;
+    }
+    list << "# generated by HummingbirdCorpus\n";
+
+    const uint64_t first_seed = shape.seed;
+    for (size_t node_count : node_counts) {
+        for (int page = 0; page < page_count; ++page) {
+            shape.node_count = node_count;
+            shape.seed = first_seed + static_cast<uint64_t>(page);
+            const auto path = output_dir / ("nodes" + std::to_string(node_count) + "-seed" +
+                                            std::to_string(shape.seed) + ".html");
+            std::ofstream out(path, std::ios::binary);
+            out << PageCorpus::standalone_html(PageCorpus::generate_page(shape));
+            if (!out) {
+                std::cerr << "cannot write " << path << "\n";
+                return 1;
+            }
+            list << path.string() << "\n";
+        }
+    }
+    return 0;
+}
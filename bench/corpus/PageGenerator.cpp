@@ -0,0 +1,216 @@
+#include "corpus/PageGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+
+namespace PageCorpus {
+namespace {
+constexpr std::array<std::string_view, 17> kWords = {
+    "lorem", "ipsum",  "dolor",  "sit",        "amet",   "consectetur", "adipiscing", "elit",  "sed",
+    "do",    "tempor", "magna",  "incididunt", "labore", "dolore",      "aliqua",     "veniam"};
+constexpr std::array<std::string_view, 4> kContainerTags = {"div", "section", "article", "ul"};
+constexpr std::array<std::string_view, 4> kInlineTags = {"span", "b", "i", "a"};
+constexpr std::array<std::string_view, 8> kDeclarations = {
+    "margin: 4px",         "padding: 2px",     "color: #336699",     "background-color: #f4f4f4",
+    "border-width: 1px",   "font-size: 14px",  "line-height: 18px",  "padding-left: 8px"};
+
+// splitmix64: tiny, fast, and fully specified, so corpora reproduce bit for bit.
+class Random {
+public:
+    explicit Random(uint64_t seed) : m_state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (m_state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, bound); bound must be positive. The modulo bias is irrelevant at these bounds.
+    size_t below(size_t bound) { return static_cast<size_t>(next() % bound); }
+
+    template <typename T, size_t N>
+    T pick(const std::array<T, N>& values) {
+        return values[below(N)];
+    }
+
+private:
+    uint64_t m_state;
+};
+
+class HtmlWriter {
+public:
+    HtmlWriter(const PageShape& shape, Random& random) : m_shape(shape), m_random(random) {}
+
+    std::string write() {
+        m_html = "<html><head><title>corpus</title></head><body>";
+        const size_t table_interval =
+            m_shape.table_count > 0 ? std::max<size_t>(1, m_shape.node_count / (m_shape.table_count + 1)) : 0;
+        int tables_written = 0;
+        size_t next_table_at = table_interval;
+        while (m_written < m_shape.node_count) {
+            write_element(1);
+            if (tables_written < m_shape.table_count && m_written >= next_table_at) {
+                write_table();
+                ++tables_written;
+                next_table_at += table_interval;
+            }
+        }
+        for (; tables_written < m_shape.table_count; ++tables_written) {
+            write_table();
+        }
+        m_html += "</body></html>";
+        return std::move(m_html);
+    }
+
+private:
+    void write_element(int depth) {
+        ++m_written;
+        const size_t remaining = m_shape.node_count - m_written;
+        if (depth >= m_shape.max_depth || remaining == 0 || m_random.below(4) == 0) {
+            write_leaf();
+            return;
+        }
+
+        const std::string_view tag = m_random.pick(kContainerTags);
+        const std::string_view child_tag = tag == "ul" ? "li" : std::string_view{};
+        open_tag(tag);
+        const size_t children = 1 + m_random.below(static_cast<size_t>(std::max(1, m_shape.fan_out)));
+        for (size_t i = 0; i < children && m_written < m_shape.node_count; ++i) {
+            if (!child_tag.empty()) {
+                ++m_written;
+                open_tag(child_tag);
+                if (m_written < m_shape.node_count && depth + 1 < m_shape.max_depth) {
+                    write_element(depth + 2);
+                } else {
+                    write_text();
+                }
+                close_tag(child_tag);
+            } else {
+                write_element(depth + 1);
+            }
+        }
+        close_tag(tag);
+    }
+
+    // A paragraph of text, sometimes with one inline element inside.
+    void write_leaf() {
+        open_tag("p");
+        write_text();
+        if (m_written < m_shape.node_count && m_random.below(2) == 0) {
+            ++m_written;
+            const std::string_view tag = m_random.pick(kInlineTags);
+            open_tag(tag);
+            write_text();
+            close_tag(tag);
+            write_text();
+        }
+        close_tag("p");
+    }
+
+    void write_text() {
+        const int mean = std::max(1, m_shape.words_per_text);
+        const size_t words = 1 + m_random.below(static_cast<size_t>(2 * mean - 1));
+        for (size_t i = 0; i < words; ++i) {
+            if (i > 0) m_html += ' ';
+            m_html += m_random.pick(kWords);
+        }
+    }
+
+    void write_table() {
+        m_html += "<table>";
+        for (int r = 0; r < m_shape.table_rows; ++r) {
+            m_html += "<tr>";
+            for (int c = 0; c < m_shape.table_columns; ++c) {
+                open_tag("td");
+                write_text();
+                close_tag("td");
+            }
+            m_html += "</tr>";
+        }
+        m_html += "</table>";
+    }
+
+    void open_tag(std::string_view tag) {
+        m_html += '<';
+        m_html += tag;
+        for (int a = 0; a < m_shape.attributes_per_element; ++a) {
+            if (a == 0) {
+                m_html += " class=\"c" + std::to_string(m_random.below(std::max(1, m_shape.class_count))) + "\"";
+            } else if (a == 1) {
+                m_html += " id=\"n" + std::to_string(m_written) + "\"";
+            } else {
+                m_html += " data-k" + std::to_string(a) + "=\"" + std::to_string(m_random.below(1000)) + "\"";
+            }
+        }
+        m_html += '>';
+    }
+
+    void close_tag(std::string_view tag) {
+        m_html += "</";
+        m_html += tag;
+        m_html += '>';
+    }
+
+    const PageShape& m_shape;
+    Random& m_random;
+    std::string m_html;
+    size_t m_written = 0;
+};
+
+// Rules mix the selector forms the matcher handles differently: class, tag.class, descendant chains (Bloom filter
+// candidates), ids and bare tags. Classes come from the markup's pool, so a predictable share of rules match.
+std::string write_css(const PageShape& shape, Random& random) {
+    std::string css;
+    const size_t classes = static_cast<size_t>(std::max(1, shape.class_count));
+    for (size_t i = 0; i < shape.rule_count; ++i) {
+        const std::string cls = ".c" + std::to_string(random.below(classes));
+        switch (random.below(5)) {
+            case 0:
+                css += cls;
+                break;
+            case 1:
+                css += std::string(random.pick(kContainerTags)) + cls;
+                break;
+            case 2:
+                css += std::string(random.pick(kContainerTags)) + " " + cls + " " +
+                       std::string(random.pick(kInlineTags));
+                break;
+            case 3:
+                css += "#n" + std::to_string(random.below(std::max<size_t>(1, shape.node_count)));
+                break;
+            default:
+                css += random.pick(kInlineTags);
+                break;
+        }
+        css += " { ";
+        const size_t declarations = 1 + random.below(3);
+        for (size_t d = 0; d < declarations; ++d) {
+            css += random.pick(kDeclarations);
+            css += "; ";
+        }
+        css += "}\n";
+    }
+    return css;
+}
+}  // namespace
+
+GeneratedPage generate_page(const PageShape& shape) {
+    // Separate streams, so changing the rule count leaves the markup untouched and vice versa.
+    Random markup_random(shape.seed);
+    Random css_random(shape.seed ^ 0x5851f42d4c957f2dull);
+    GeneratedPage page;
+    page.html = HtmlWriter(shape, markup_random).write();
+    page.css = write_css(shape, css_random);
+    return page;
+}
+
+std::string standalone_html(const GeneratedPage& page) {
+    std::string html = page.html;
+    const size_t head_end = html.find("</head>");
+    html.insert(head_end == std::string::npos ? 0 : head_end, "<style>\n" + page.css + "</style>");
+    return html;
+}
+
+}  // namespace PageCorpus
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Seeded generator for pages of controlled size and shape, for scaling benchmarks. The same shape (seed included)
+// always yields byte-identical output on every platform: the generator uses its own PRNG rather than <random>
+// distributions, whose results are implementation-defined.
+namespace PageCorpus {
+
+struct PageShape {
+    uint64_t seed = 1;
+    size_t node_count = 1000;    // elements in the body, tables excluded
+    int max_depth = 8;           // deepest element nesting below <body>
+    int fan_out = 4;             // most element children per container
+    int words_per_text = 12;     // mean words per text node (uniform in [1, 2 * words_per_text - 1])
+    int attributes_per_element = 2;  // class, id, then data-* (the tokenizer keeps at most 8)
+    int class_count = 64;        // size of the class name pool shared by markup and selectors
+    int table_count = 0;         // tables spread evenly through the body
+    int table_rows = 10;
+    int table_columns = 5;
+    size_t rule_count = 100;     // stylesheet rules
+};
+
+struct GeneratedPage {
+    std::string html;  // no <style>: pair with css, or use standalone_html()
+    std::string css;
+};
+
+GeneratedPage generate_page(const PageShape& shape);
+
+// The page with its stylesheet inlined in <head>, as the corpus tool writes it.
+std::string standalone_html(const GeneratedPage& page);
+
+}  // namespace PageCorpus
@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "core/ArenaAllocator.h"
+#include "corpus/PageGenerator.h"
+#include "html/HtmlParser.h"
+#include "layout/TreeBuilder.h"
+#include "renderer/Painter.h"
+#include "renderer/RecordingGraphicsContext.h"
+#include "style/CssParser.h"
+#include "style/StyleEngine.h"
+#include "support/SyntheticDocument.h"
+
+// Stage time against document size on generated corpora. Each family runs at growing sizes and asks Google Benchmark
+// for a complexity fit, so the output ends with a _BigO row (the fitted growth) and an _RMS row (how well it fits).
+// Every stage should fit O(N) in nodes; bench/corpus/plot_scaling.py turns a JSON run into a log-log plot with
+// per-stage slopes.
+//
+// The style families separate the two factors of selector matching: nodes at a fixed rule count, rules at a fixed
+// node count, and both growing together as they do on real sites, where matching every rule against every node
+// shows up as O(N^2).
+
+namespace {
+constexpr int64_t kMinNodes = 256;
+constexpr int64_t kMaxNodes = 64 * 1024;
+constexpr float kViewportWidth = 1024.0f;
+
+PageCorpus::PageShape shape_for(int64_t node_count, size_t rule_count = 100) {
+    PageCorpus::PageShape shape;
+    shape.node_count = static_cast<size_t>(node_count);
+    shape.rule_count = rule_count;
+    shape.table_count = static_cast<int>(node_count / 2048);
+    return shape;
+}
+
+void BM_ScaleHtmlParse(benchmark::State& state) {
+    const auto page = PageCorpus::generate_page(shape_for(state.range(0)));
+    ArenaAllocator arena(page.html.size() * 16);
+    for (auto _ : state) {
+        {
+            Hummingbird::Html::Parser parser(arena, page.html);
+            auto result = parser.parse();
+            benchmark::DoNotOptimize(result.dom.get());
+            state.PauseTiming();
+        }
+        arena.reset();
+        state.ResumeTiming();
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void run_style_apply(benchmark::State& state, int64_t node_count, size_t rule_count, int64_t complexity_n) {
+    const auto page = PageCorpus::generate_page(shape_for(node_count, rule_count));
+    Hummingbird::Renderer::RecordingGraphicsContext context;
+    auto document = BenchDocuments::prepare(page.html, {}, BenchDocuments::Stage::Parsed, context, kViewportWidth);
+    Hummingbird::Css::Parser css_parser(page.css);
+    const auto sheet = css_parser.parse();
+    Hummingbird::Css::StyleEngine engine;
+    for (auto _ : state) {
+        engine.apply(sheet, document.dom.get());
+        benchmark::ClobberMemory();
+    }
+    state.SetComplexityN(complexity_n);
+}
+
+void BM_ScaleStyleNodes(benchmark::State& state) {
+    run_style_apply(state, state.range(0), 100, state.range(0));
+}
+
+void BM_ScaleStyleRules(benchmark::State& state) {
+    run_style_apply(state, 4096, static_cast<size_t>(state.range(0)), state.range(0));
+}
+
+// One rule per 16 nodes.
+void BM_ScaleStyleNodesAndRules(benchmark::State& state) {
+    run_style_apply(state, state.range(0), static_cast<size_t>(state.range(0) / 16), state.range(0));
+}
+
+void BM_ScaleTreeBuild(benchmark::State& state) {
+    const auto page = PageCorpus::generate_page(shape_for(state.range(0)));
+    Hummingbird::Renderer::RecordingGraphicsContext context;
+    auto document =
+        BenchDocuments::prepare(page.html, page.css, BenchDocuments::Stage::Styled, context, kViewportWidth);
+    Hummingbird::Layout::TreeBuilder builder;
+    for (auto _ : state) {
+        auto render_tree = builder.build(document.dom.get());
+        benchmark::DoNotOptimize(render_tree.get());
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void BM_ScaleLayout(benchmark::State& state) {
+    const auto page = PageCorpus::generate_page(shape_for(state.range(0)));
+    Hummingbird::Renderer::RecordingGraphicsContext context;
+    auto document =
+        BenchDocuments::prepare(page.html, page.css, BenchDocuments::Stage::LaidOut, context, kViewportWidth);
+    for (auto _ : state) {
+        BenchDocuments::mark_subtree_needs_layout(*document.render_tree);
+        document.render_tree->layout(context, {0, 0, kViewportWidth, 600});
+        benchmark::ClobberMemory();
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+void BM_ScalePaint(benchmark::State& state) {
+    const auto page = PageCorpus::generate_page(shape_for(state.range(0)));
+    Hummingbird::Renderer::RecordingGraphicsContext context;
+    auto document =
+        BenchDocuments::prepare(page.html, page.css, BenchDocuments::Stage::LaidOut, context, kViewportWidth);
+    Hummingbird::Renderer::Painter painter;
+    for (auto _ : state) {
+        context.reset();
+        painter.paint(*document.render_tree, context);
+        benchmark::DoNotOptimize(context.commands().data());
+    }
+    state.SetComplexityN(state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_ScaleHtmlParse)->RangeMultiplier(4)->Range(kMinNodes, kMaxNodes)->Complexity();
+BENCHMARK(BM_ScaleStyleNodes)->RangeMultiplier(4)->Range(kMinNodes, kMaxNodes)->Complexity();
+BENCHMARK(BM_ScaleStyleRules)->RangeMultiplier(4)->Range(64, 4096)->Complexity();
+BENCHMARK(BM_ScaleStyleNodesAndRules)->RangeMultiplier(4)->Range(kMinNodes * 4, kMaxNodes)->Complexity();
+BENCHMARK(BM_ScaleTreeBuild)->RangeMultiplier(4)->Range(kMinNodes, kMaxNodes)->Complexity();
+BENCHMARK(BM_ScaleLayout)->RangeMultiplier(4)->Range(kMinNodes, kMaxNodes)->Complexity();
+BENCHMARK(BM_ScalePaint)->RangeMultiplier(4)->Range(kMinNodes, kMaxNodes)->Complexity();
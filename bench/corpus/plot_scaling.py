@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""Plots stage time against document size from a HummingbirdBench JSON run.
+
+    HummingbirdBench --benchmark_filter=BM_Scale --benchmark_format=json --benchmark_out=scaling.json
+    python3 bench/corpus/plot_scaling.py scaling.json --out scaling.png
+
+Prints the log-log slope of each benchmark family (1.0 is linear, 2.0 quadratic) and exits with status 1 when a
+family's slope exceeds --max-slope, so CI can track it. The plot needs matplotlib; the table does not.
+"""
+
+import argparse
+import json
+import math
+import sys
+from collections import defaultdict
+
+TIME_SCALE_TO_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_series(path):
+    with open(path, encoding="utf-8") as f:
+        report = json.load(f)
+    series = defaultdict(list)
+    for run in report["benchmarks"]:
+        if run.get("run_type") == "aggregate":
+            continue  # _BigO / _RMS rows and repetition aggregates
+        family, _, size = run["name"].partition("/")
+        if not size.isdigit():
+            continue
+        time_ns = run["real_time"] * TIME_SCALE_TO_NS[run.get("time_unit", "ns")]
+        series[family].append((int(size), time_ns))
+    return {family: sorted(points) for family, points in series.items()}
+
+
+def log_log_slope(points):
+    xs = [math.log(size) for size, _ in points]
+    ys = [math.log(time) for _, time in points]
+    mean_x = sum(xs) / len(xs)
+    mean_y = sum(ys) / len(ys)
+    denominator = sum((x - mean_x) ** 2 for x in xs)
+    if denominator == 0:
+        return float("nan")
+    return sum((x - mean_x) * (y - mean_y) for x, y in zip(xs, ys)) / denominator
+
+
+def plot(series, slopes, out_path):
+    import matplotlib
+
+    matplotlib.use("Agg")
+    import matplotlib.pyplot as plt
+
+    fig, ax = plt.subplots(figsize=(9, 6))
+    for family, points in sorted(series.items()):
+        sizes = [size for size, _ in points]
+        times_ms = [time / 1e6 for _, time in points]
+        ax.plot(sizes, times_ms, marker="o", label=f"{family} (slope {slopes[family]:.2f})")
+    ax.set_xscale("log", base=2)
+    ax.set_yscale("log")
+    ax.set_xlabel("document size (nodes, or rules for *Rules)")
+    ax.set_ylabel("time per iteration (ms)")
+    ax.grid(True, which="both", alpha=0.3)
+    ax.legend(fontsize="small")
+    fig.tight_layout()
+    fig.savefig(out_path, dpi=120)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("json", help="output of --benchmark_format=json / --benchmark_out")
+    parser.add_argument("--out", help="write a log-log plot to this image file")
+    parser.add_argument("--max-slope", type=float, default=None,
+                        help="fail when any family grows faster than size^MAX_SLOPE")
+    args = parser.parse_args()
+
+    series = {family: points for family, points in load_series(args.json).items() if len(points) >= 2}
+    if not series:
+        print("no size-parameterized benchmarks in", args.json, file=sys.stderr)
+        return 1
+
+    slopes = {family: log_log_slope(points) for family, points in series.items()}
+    failed = False
+    print(f"{'family':<32} {'sizes':>14} {'slope':>7}")
+    for family in sorted(series):
+        points = series[family]
+        over = args.max_slope is not None and slopes[family] > args.max_slope
+        failed |= over
+        size_range = f"{points[0][0]}..{points[-1][0]}"
+        print(f"{family:<32} {size_range:>14} {slopes[family]:>7.2f}{'  <-- superlinear' if over else ''}")
+
+    if args.out:
+        plot(series, slopes, args.out)
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
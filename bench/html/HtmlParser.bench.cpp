@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "core/ArenaAllocator.h"
+#include "html/HtmlParser.h"
+#include "html/HtmlTokenizer.h"
+#include "support/AllocationMeter.h"
+#include "support/SyntheticDocument.h"
+
+// Tokenizer and tree construction throughput (bytes/s) on synthetic pages of growing size. The parser case reuses
+// one arena, reset between iterations, so it measures parsing rather than first-touch page faults.
+
+using namespace Hummingbird::Html;
+
+namespace {
+void BM_HtmlTokenizer(benchmark::State& state) {
+    const std::string html = BenchDocuments::make_page_html(static_cast<int>(state.range(0)));
+    size_t token_count = 0;
+    auto tokenize = [&] {
+        Tokenizer tokenizer(html);
+        token_count = 0;
+        while (tokenizer.next_token().type != TokenType::EndOfFile) {
+            ++token_count;
+        }
+        benchmark::DoNotOptimize(token_count);
+    };
+    tokenize();  // warm-up, outside the allocation counters
+    BenchAllocations::AllocationMeter allocations;
+    for (auto _ : state) {
+        tokenize();
+        allocations.iteration_done();
+    }
+    allocations.report(state);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(html.size()));
+    state.counters["tokens"] = static_cast<double>(token_count);
+}
+
+void BM_HtmlParser(benchmark::State& state) {
+    const std::string html = BenchDocuments::make_page_html(static_cast<int>(state.range(0)));
+    ArenaAllocator arena(html.size() * 16);
+    size_t node_count = 0;
+    {
+        // Warm-up, outside the allocation counters: grows the arena to the page's size.
+        Parser parser(arena, html);
+        benchmark::DoNotOptimize(parser.parse().dom.get());
+    }
+    arena.reset();
+    BenchAllocations::AllocationMeter allocations;
+    for (auto _ : state) {
+        {
+            Parser parser(arena, html);
+            auto result = parser.parse();
+            benchmark::DoNotOptimize(result.dom.get());
+            state.PauseTiming();
+            node_count = BenchDocuments::count_nodes(result.dom.get());
+        }
+        arena.reset();
+        allocations.iteration_done();
+        state.ResumeTiming();
+    }
+    allocations.report(state);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(html.size()));
+    state.counters["nodes"] = static_cast<double>(node_count);
+}
+}  // namespace
+
+BENCHMARK(BM_HtmlTokenizer)->Apply(BenchDocuments::apply_document_sizes);
+BENCHMARK(BM_HtmlParser)->Apply(BenchDocuments::apply_document_sizes)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "layout/RenderObject.h"
+#include "support/AllocationMeter.h"
+#include "support/BenchGraphicsContext.h"
+#include "support/SyntheticDocument.h"
+
+// Block flow layout of a synthetic page: nested blocks with margins, padding and borders around paragraphs, lists
+// and the occasional table. The whole tree is invalidated before each pass; text stays measured, so this is block
+// and line placement rather than text shaping.
+
+namespace {
+size_t count_render_objects(const Hummingbird::Layout::RenderObject& object) {
+    size_t total = 1;
+    for (const auto& child : object.get_children()) {
+        total += count_render_objects(*child);
+    }
+    return total;
+}
+
+void BM_BlockLayout(benchmark::State& state) {
+    const std::string html = BenchDocuments::make_page_html(static_cast<int>(state.range(0)));
+    BenchGraphicsContext context;
+    auto document =
+        BenchDocuments::prepare(html, BenchDocuments::make_page_css(), BenchDocuments::Stage::LaidOut, context, 1024);
+    auto& root = *document.render_tree;
+    auto relayout = [&] {
+        BenchDocuments::mark_subtree_needs_layout(root);
+        root.layout(context, {0, 0, 1024, 600});
+        benchmark::ClobberMemory();
+    };
+
+    relayout();  // warm-up, outside the allocation counters
+    BenchAllocations::AllocationMeter allocations;
+    for (auto _ : state) {
+        relayout();
+        allocations.iteration_done();
+    }
+    allocations.report(state);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count_render_objects(root)));
+}
+}  // namespace
+
+BENCHMARK(BM_BlockLayout)->Apply(BenchDocuments::apply_document_sizes)->Unit(benchmark::kMicrosecond);
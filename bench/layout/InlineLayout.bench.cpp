@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include <iterator>
+#include <string>
+
+#include "core/ArenaAllocator.h"
+#include "html/HtmlParser.h"
+#include "layout/RenderObject.h"
+#include "layout/TreeBuilder.h"
+#include "style/CssParser.h"
+#include "style/StyleEngine.h"
+#include "support/AllocationMeter.h"
+#include "support/BenchGraphicsContext.h"
+
+// Inline layout of a text-heavy page: many paragraphs of words interleaved with inline elements. Reports the
+// number of heap allocations per layout pass alongside time. The full-layout cases invalidate the whole tree before
+// each pass so the layout caches don't hide the work; the resize case alternates widths over warm caches.
+
+namespace {
+constexpr int kParagraphCount = 200;
+constexpr int kWordsPerParagraph = 120;
+
+std::string make_text_heavy_html() {
+    static constexpr const char* kWords[] = {"lorem", "ipsum", "dolor", "sit", "amet", "consectetur",
+                                             "adipiscing", "elit", "sed", "do", "eiusmod", "tempor"};
+    std::string html = "<html><body>";
+    for (int p = 0; p < kParagraphCount; ++p) {
+        html += "<p>";
+        for (int w = 0; w < kWordsPerParagraph; ++w) {
+            if (w % 25 == 10) html += "<b>";
+            html += kWords[(p * 7 + w) % std::size(kWords)];
+            if (w % 25 == 14) html += "</b>";
+            html += ' ';
+        }
+        html += "</p>";
+    }
+    html += "</body></html>";
+    return html;
+}
+
+void mark_subtree_needs_layout(Hummingbird::Layout::RenderObject& object) {
+    object.mark_needs_layout();
+    for (const auto& child : object.get_children()) {
+        mark_subtree_needs_layout(*child);
+    }
+}
+
+// Builds the styled render tree for the text-heavy page, then times |layout_pass| and counts its allocations.
+template <typename LayoutPass>
+void run_text_heavy_layout(benchmark::State& state, const char* css, LayoutPass&& layout_pass) {
+    const std::string html = make_text_heavy_html();
+    ArenaAllocator arena(html.size() * 8);
+    Hummingbird::Html::Parser parser(arena, html);
+    auto document = parser.parse();
+
+    Hummingbird::Css::Parser css_parser(css);
+    auto sheet = css_parser.parse();
+    Hummingbird::Css::StyleEngine engine;
+    engine.apply(sheet, document.dom.get());
+
+    Hummingbird::Layout::TreeBuilder builder;
+    auto render_root = builder.build(document.dom.get());
+    BenchGraphicsContext context;
+    const float width = static_cast<float>(state.range(0));
+    layout_pass(*render_root, context, width);  // warm caches (prepared text etc.)
+
+    BenchAllocations::AllocationMeter allocations;
+    for (auto _ : state) {
+        layout_pass(*render_root, context, width);
+        benchmark::ClobberMemory();
+        allocations.iteration_done();
+    }
+    allocations.report(state);
+}
+
+void full_layout(Hummingbird::Layout::RenderObject& root, IGraphicsContext& context, float width) {
+    mark_subtree_needs_layout(root);
+    root.layout(context, {0, 0, width, 600});
+}
+
+void BM_InlineLayoutTextHeavy(benchmark::State& state) {
+    run_text_heavy_layout(state, "p { margin: 8px; } b { color: #336699; }", full_layout);
+}
+
+// Same page with the total-fit line breaker; compare against BM_InlineLayoutTextHeavy at the same width.
+void BM_InlineLayoutTextHeavyPretty(benchmark::State& state) {
+    run_text_heavy_layout(state, "p { margin: 8px; text-wrap: pretty; } b { color: #336699; }", full_layout);
+}
+
+// Alternates between two widths: runs stay measured and both line layouts stay cached per paragraph.
+void BM_InlineLayoutTextHeavyResize(benchmark::State& state) {
+    run_text_heavy_layout(state, "p { margin: 8px; } b { color: #336699; }",
+                          [](Hummingbird::Layout::RenderObject& root, IGraphicsContext& context, float width) {
+                              root.layout(context, {0, 0, width, 600});
+                              root.layout(context, {0, 0, width * 0.75f, 600});
+                          });
+}
+}  // namespace
+
+BENCHMARK(BM_InlineLayoutTextHeavy)->Arg(480)->Arg(1280)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_InlineLayoutTextHeavyPretty)->Arg(480)->Arg(1280)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_InlineLayoutTextHeavyResize)->Arg(480)->Arg(1280)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <vector>
+
+#include "layout/InlineLineBuilder.h"
+
+// Greedy vs total-fit (text-wrap: pretty) line breaking of one long paragraph. The optimal case also reports its
+// time relative to greedy on the same runs.
+
+namespace {
+using Hummingbird::Layout::InlineLineBuilder;
+using Hummingbird::Layout::InlineRun;
+using Hummingbird::Layout::LineBreakMode;
+
+constexpr float kLineWidth = 600.0f;
+
+// Word/space runs with a deterministic spread of word widths, shaped like TextBox output.
+std::vector<InlineRun> make_paragraph_runs(size_t word_count) {
+    std::vector<InlineRun> runs;
+    runs.reserve(word_count * 2);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < word_count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        float word_width = 16.0f + static_cast<float>((seed >> 16) % 80);
+        runs.push_back({nullptr, i * 2, 0, 0, word_width, 19.2f});
+        runs.push_back({nullptr, i * 2 + 1, 0, 0, 4.0f, 19.2f});
+    }
+    return runs;
+}
+
+InlineLineBuilder make_builder(const std::vector<InlineRun>& runs) {
+    InlineLineBuilder builder;
+    builder.reserve(runs.size());
+    for (const auto& run : runs) {
+        builder.add_run(run);
+    }
+    return builder;
+}
+
+double seconds_per_layout(InlineLineBuilder& builder, LineBreakMode mode, int repetitions) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; ++i) {
+        auto lines = builder.layout(kLineWidth, 0.0f, mode);
+        benchmark::DoNotOptimize(lines.data());
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / repetitions;
+}
+
+void run_line_breaking(benchmark::State& state, LineBreakMode mode) {
+    auto runs = make_paragraph_runs(static_cast<size_t>(state.range(0)));
+    InlineLineBuilder builder = make_builder(runs);
+
+    size_t line_count = 0;
+    for (auto _ : state) {
+        auto lines = builder.layout(kLineWidth, 0.0f, mode);
+        line_count = lines.size();
+        benchmark::DoNotOptimize(lines.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(runs.size()));
+    state.counters["lines"] = static_cast<double>(line_count);
+
+    if (mode == LineBreakMode::Optimal) {
+        constexpr int kRepetitions = 20;
+        double greedy = seconds_per_layout(builder, LineBreakMode::Greedy, kRepetitions);
+        double optimal = seconds_per_layout(builder, LineBreakMode::Optimal, kRepetitions);
+        state.counters["x_greedy"] = greedy > 0.0 ? optimal / greedy : 0.0;
+    }
+}
+
+void BM_LineBreakGreedy(benchmark::State& state) {
+    run_line_breaking(state, LineBreakMode::Greedy);
+}
+
+void BM_LineBreakOptimal(benchmark::State& state) {
+    run_line_breaking(state, LineBreakMode::Optimal);
+}
+}  // namespace
+
+BENCHMARK(BM_LineBreakGreedy)->Arg(200)->Arg(5000);
+BENCHMARK(BM_LineBreakOptimal)->Arg(200)->Arg(5000);
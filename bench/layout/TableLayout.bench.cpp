@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "core/ArenaAllocator.h"
+#include "html/HtmlParser.h"
+#include "layout/RenderObject.h"
+#include "layout/TreeBuilder.h"
+#include "style/CssParser.h"
+#include "style/StyleEngine.h"
+#include "support/BenchGraphicsContext.h"
+
+// Layout of a large data table, invalidated before each pass. Auto layout measures every cell's min/max-content
+// width; fixed layout sizes the columns from the first row and only lays each cell out once at its final width.
+
+namespace {
+constexpr int kColumnCount = 6;
+
+std::string make_data_table_html(int row_count) {
+    std::string html = "<html><body><table>";
+    html += "<tr><td class=\"id\">id</td><td>name</td><td>status</td><td>owner</td><td>updated</td><td>notes</td></tr>";
+    for (int r = 0; r < row_count; ++r) {
+        html += "<tr>";
+        for (int c = 0; c < kColumnCount; ++c) {
+            html += "<td>";
+            html += std::to_string(r * kColumnCount + c);
+            html += c == kColumnCount - 1 ? " a longer free text note that wraps" : " cell";
+            html += "</td>";
+        }
+        html += "</tr>";
+    }
+    html += "</table></body></html>";
+    return html;
+}
+
+void mark_subtree_needs_layout(Hummingbird::Layout::RenderObject& object) {
+    object.mark_needs_layout();
+    for (const auto& child : object.get_children()) {
+        mark_subtree_needs_layout(*child);
+    }
+}
+
+void run_table_layout(benchmark::State& state, const char* css) {
+    const std::string html = make_data_table_html(static_cast<int>(state.range(0)));
+    ArenaAllocator arena(html.size() * 32);  // dense markup: far more nodes per byte than the text pages
+    Hummingbird::Html::Parser parser(arena, html);
+    auto document = parser.parse();
+
+    Hummingbird::Css::Parser css_parser(css);
+    auto sheet = css_parser.parse();
+    Hummingbird::Css::StyleEngine engine;
+    engine.apply(sheet, document.dom.get());
+
+    Hummingbird::Layout::TreeBuilder builder;
+    auto render_root = builder.build(document.dom.get());
+    BenchGraphicsContext context;
+    render_root->layout(context, {0, 0, 1024, 600});  // warm caches (prepared text etc.)
+
+    for (auto _ : state) {
+        mark_subtree_needs_layout(*render_root);
+        render_root->layout(context, {0, 0, 1024, 600});
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_TableLayoutAuto(benchmark::State& state) {
+    run_table_layout(state, "table { width: 100%; } td { padding: 2px; }");
+}
+
+void BM_TableLayoutFixed(benchmark::State& state) {
+    run_table_layout(state, "table { width: 100%; table-layout: fixed; } td { padding: 2px; } td.id { width: 48px; }");
+}
+}  // namespace
+
+BENCHMARK(BM_TableLayoutAuto)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TableLayoutFixed)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "layout/TreeBuilder.h"
+#include "support/AllocationMeter.h"
+#include "support/BenchGraphicsContext.h"
+#include "support/SyntheticDocument.h"
+
+// Render tree construction from a styled synthetic page (box creation, anonymous block wrapping, text boxes).
+// Items are DOM nodes.
+
+namespace {
+void BM_TreeBuild(benchmark::State& state) {
+    const std::string html = BenchDocuments::make_page_html(static_cast<int>(state.range(0)));
+    BenchGraphicsContext context;
+    auto document =
+        BenchDocuments::prepare(html, BenchDocuments::make_page_css(), BenchDocuments::Stage::Styled, context, 1024);
+    const size_t node_count = BenchDocuments::count_nodes(document.dom.get());
+
+    Hummingbird::Layout::TreeBuilder builder;
+    builder.build(document.dom.get());  // warm-up, outside the allocation counters
+    BenchAllocations::AllocationMeter allocations;
+    for (auto _ : state) {
+        auto render_tree = builder.build(document.dom.get());
+        benchmark::DoNotOptimize(render_tree.get());
+        allocations.iteration_done();
+    }
+    allocations.report(state);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(node_count));
+}
+}  // namespace
+
+BENCHMARK(BM_TreeBuild)->Apply(BenchDocuments::apply_document_sizes)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "core/platform_api/WindowFactory.h"
+#include "renderer/Painter.h"
+#include "renderer/RecordingGraphicsContext.h"
+#include "support/AllocationMeter.h"
+#include "support/SyntheticDocument.h"
+
+// Painting a laid-out synthetic page into a recording context: tree traversal plus command emission, without any
+// rasterization. The full-page case paints everything; the viewport case paints one screen from the middle of the
+// page and shows what culling saves, and what it still sends off screen ("off_viewport"); the outline case adds the
+// debug outlines (F1 in the app) to that screen. The raster case replays the recorded viewport frame on the offscreen
+// backend, so it times rasterization without the traversal; the threads case does so with Blend2D worker threads,
+// timed in wall time since the work leaves the benchmark thread.
+
+namespace {
+constexpr float kViewportWidth = 1024.0f;
+constexpr float kViewportHeight = 768.0f;
+
+Hummingbird::Renderer::PaintOptions middle_of_page(const BenchDocuments::PreparedDocument& document) {
+    Hummingbird::Renderer::PaintOptions options;
+    options.viewport = {0, 0, kViewportWidth, kViewportHeight};
+    options.scroll_y = document.render_tree->get_rect().height / 2.0f;
+    return options;
+}
+
+void run_paint(benchmark::State& state, bool cull_to_viewport, bool debug_outlines = false) {
+    const std::string html = BenchDocuments::make_page_html(static_cast<int>(state.range(0)));
+    Hummingbird::Renderer::RecordingGraphicsContext context;
+    auto document = BenchDocuments::prepare(html, BenchDocuments::make_page_css(), BenchDocuments::Stage::LaidOut,
+                                            context, kViewportWidth);
+
+    auto options = cull_to_viewport ? middle_of_page(document) : Hummingbird::Renderer::PaintOptions{};
+    options.debug_outlines = debug_outlines;
+    Hummingbird::Renderer::Painter painter;
+    auto paint = [&] {
+        context.reset();
+        painter.paint(*document.render_tree, context, options);
+        benchmark::DoNotOptimize(context.commands().data());
+    };
+    paint();  // warm-up, outside the allocation counters: grows the command buffer
+    BenchAllocations::AllocationMeter allocations;
+    for (auto _ : state) {
+        paint();
+        allocations.iteration_done();
+    }
+    allocations.report(state);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(context.commands().size()));
+    state.counters["commands"] = static_cast<double>(context.commands().size());
+    const auto analysis = context.analyze();
+    state.counters["off_viewport"] = static_cast<double>(analysis.off_viewport_draws);
+    state.counters["overdraw"] = analysis.overdraw();
+}
+
+void BM_PaintFullPage(benchmark::State& state) {
+    run_paint(state, false);
+}
+
+void BM_PaintViewport(benchmark::State& state) {
+    run_paint(state, true);
+}
+
+void BM_PaintViewportOutlines(benchmark::State& state) {
+    run_paint(state, true, true);
+}
+
+void run_raster(benchmark::State& state, int sections, uint32_t raster_threads) {
+    auto backend = create_offscreen_graphics_context(static_cast<int>(kViewportWidth),
+                                                     static_cast<int>(kViewportHeight), raster_threads);
+    if (!backend) {
+        state.SkipWithError("no offscreen graphics backend");
+        return;
+    }
+    const std::string html = BenchDocuments::make_page_html(sections);
+    // Recorded with the backend's own text metrics, so the replayed frame is laid out for the fonts it rasterizes.
+    Hummingbird::Renderer::RecordingGraphicsContext recording(backend.get());
+    auto document = BenchDocuments::prepare(html, BenchDocuments::make_page_css(), BenchDocuments::Stage::LaidOut,
+                                            recording, kViewportWidth);
+    recording.clear({255, 255, 255, 255});
+    Hummingbird::Renderer::Painter painter;
+    painter.paint(*document.render_tree, recording, middle_of_page(document));
+    recording.present();  // waits for the worker threads, if any
+
+    for (auto _ : state) {
+        recording.replay(*backend);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(recording.commands().size()));
+    state.counters["commands"] = static_cast<double>(recording.commands().size());
+}
+
+void BM_PaintRasterViewport(benchmark::State& state) {
+    run_raster(state, static_cast<int>(state.range(0)), 0);
+}
+
+// One frame of the mid-size page, rasterized by Blend2D on 0 (the calling thread), 2, 4 or 8 worker threads.
+void BM_PaintRasterThreads(benchmark::State& state) {
+    run_raster(state, 128, static_cast<uint32_t>(state.range(0)));
+}
+}  // namespace
+
+BENCHMARK(BM_PaintFullPage)->Apply(BenchDocuments::apply_document_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PaintViewport)->Apply(BenchDocuments::apply_document_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PaintViewportOutlines)->Apply(BenchDocuments::apply_document_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PaintRasterViewport)->Apply(BenchDocuments::apply_document_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PaintRasterThreads)->Arg(0)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "style/CssParser.h"
+#include "style/CssTokenizer.h"
+
+// Measures CSS tokenizer/parser throughput (bytes/s). Real-world inputs (e.g. framework CSS bundles) can be
+// supplied via HB_BENCH_CSS_FILES, a list of paths separated by ';' (or ':' on POSIX); a synthetic
+// framework-like sheet is always benchmarked as a baseline.
+
+using namespace Hummingbird::Css;
+
+namespace {
+constexpr size_t kSyntheticRuleCount = 8000;
+
+std::string make_synthetic_css(size_t rule_count) {
+    std::string css;
+    css.reserve(rule_count * 96);
+    for (size_t i = 0; i < rule_count; ++i) {
+        css += ".component-" + std::to_string(i) + ", #node-" + std::to_string(i % 97) + ", div {\n";
+        css += "  margin: " + std::to_string(i % 16) + "px;\n";
+        css += "  padding-left: " + std::to_string(i % 8) + "px;\n";
+        css += "  color: #" + std::string(i % 2 ? "336699" : "abc") + ";\n";
+        css += "  display: " + std::string(i % 3 ? "block" : "inline-block") + ";\n";
+        css += "}\n";
+    }
+    return css;
+}
+
+void run_tokenizer(benchmark::State& state, const std::string& css) {
+    for (auto _ : state) {
+        Tokenizer tokenizer(css);
+        size_t count = 0;
+        while (tokenizer.next_token().type != TokenType::End) {
+            ++count;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(css.size()));
+}
+
+void run_parser(benchmark::State& state, const std::string& css) {
+    for (auto _ : state) {
+        Parser parser(css);
+        auto sheet = parser.parse();
+        benchmark::DoNotOptimize(sheet.rules.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(css.size()));
+}
+
+std::vector<std::string> split_paths(std::string_view list) {
+#ifdef _WIN32
+    constexpr std::string_view kSeparators = ";";
+#else
+    constexpr std::string_view kSeparators = ";:";
+#endif
+    std::vector<std::string> paths;
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t end = list.find_first_of(kSeparators, start);
+        if (end == std::string_view::npos) end = list.size();
+        if (end > start) paths.emplace_back(list.substr(start, end - start));
+        start = end + 1;
+    }
+    return paths;
+}
+
+void register_input(const std::string& label, std::string css) {
+    auto shared = std::make_shared<const std::string>(std::move(css));
+    benchmark::RegisterBenchmark(("CssTokenizer/" + label).c_str(),
+                                 [shared](benchmark::State& state) { run_tokenizer(state, *shared); });
+    benchmark::RegisterBenchmark(("CssParser/" + label).c_str(),
+                                 [shared](benchmark::State& state) { run_parser(state, *shared); });
+}
+
+struct CssInputRegistrar {
+    CssInputRegistrar() {
+        register_input("synthetic", make_synthetic_css(kSyntheticRuleCount));
+
+        const char* files = std::getenv("HB_BENCH_CSS_FILES");
+        if (!files) return;
+        for (const auto& path : split_paths(files)) {
+            std::ifstream in(path, std::ios::in | std::ios::binary);
+            if (!in) continue;
+            std::ostringstream contents;
+            contents << in.rdbuf();
+            register_input(path, contents.str());
+        }
+    }
+};
+
+const CssInputRegistrar kRegistrar;
+}  // namespace
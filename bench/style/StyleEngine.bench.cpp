@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "style/CssParser.h"
+#include "style/StyleEngine.h"
+#include "support/AllocationMeter.h"
+#include "support/BenchGraphicsContext.h"
+#include "support/SyntheticDocument.h"
+
+// Full cascade over a parsed synthetic page: selector matching against every rule, cascade and computed style for
+// each node. Items are DOM nodes, so items_per_second stays flat if styling scales linearly with the page.
+
+namespace {
+void BM_StyleApply(benchmark::State& state) {
+    const std::string html = BenchDocuments::make_page_html(static_cast<int>(state.range(0)));
+    BenchGraphicsContext context;
+    auto document = BenchDocuments::prepare(html, {}, BenchDocuments::Stage::Parsed, context, 1024);
+    const std::string css = BenchDocuments::make_page_css();
+    Hummingbird::Css::Parser css_parser(css);
+    const auto sheet = css_parser.parse();
+    const size_t node_count = BenchDocuments::count_nodes(document.dom.get());
+
+    Hummingbird::Css::StyleEngine engine;
+    engine.apply(sheet, document.dom.get());  // warm-up, outside the allocation counters
+    BenchAllocations::AllocationMeter allocations;
+    for (auto _ : state) {
+        engine.apply(sheet, document.dom.get());
+        benchmark::ClobberMemory();
+        allocations.iteration_done();
+    }
+    allocations.report(state);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(node_count));
+    state.counters["rules"] = static_cast<double>(sheet.rules.size());
+}
+}  // namespace
+
+BENCHMARK(BM_StyleApply)->Apply(BenchDocuments::apply_document_sizes)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,33 @@
+#include "support/AllocationMeter.h"
+
+#include <string>
+
+namespace Allocations = Hummingbird::Core::Allocations;
+
+namespace BenchAllocations {
+
+AllocationMeter::AllocationMeter() : m_start(Allocations::thread_snapshot()), m_last(m_start) {}
+
+double AllocationMeter::iterations() const {
+    return m_iterations > 0 ? static_cast<double>(m_iterations) : 1.0;
+}
+
+void AllocationMeter::report(benchmark::State& state) const {
+    const Allocations::Counts total = (m_last - m_start).total();
+    state.counters["allocs_per_iter"] = static_cast<double>(total.count) / iterations();
+    state.counters["alloc_bytes_per_iter"] = static_cast<double>(total.bytes) / iterations();
+}
+
+void AllocationMeter::report_stages(benchmark::State& state) const {
+    report(state);
+    const Allocations::Snapshot snapshot = m_last - m_start;
+    for (size_t i = 0; i < Allocations::kStageCount; ++i) {
+        const auto stage = static_cast<Allocations::Stage>(i);
+        if (snapshot[stage].count == 0) continue;
+        const std::string name = Allocations::stage_name(stage);
+        state.counters[name + "_allocs"] = static_cast<double>(snapshot[stage].count) / iterations();
+        state.counters[name + "_bytes"] = static_cast<double>(snapshot[stage].bytes) / iterations();
+    }
+}
+
+}  // namespace BenchAllocations
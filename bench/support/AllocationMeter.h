@@ -0,0 +1,36 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include "core/utils/AllocationStats.h"
+
+// Heap allocations of a benchmark loop, from the allocation hooks linked into the benchmark binary (see
+// core/utils/AllocationStats.h). Run one untimed warm-up pass of the loop body first, so caches are filled and
+// buffers grown, and construct the meter after it; call iteration_done() at the end of every iteration. report()
+// then publishes the per-iteration average, which does not depend on how many iterations the library chose to run,
+// so check_allocation_budgets.py can hold it to fixed budgets.
+namespace BenchAllocations {
+
+class AllocationMeter {
+public:
+    AllocationMeter();
+
+    void iteration_done() {
+        m_last = Hummingbird::Core::Allocations::thread_snapshot();
+        ++m_iterations;
+    }
+
+    // "allocs_per_iter" and "alloc_bytes_per_iter" over all stages.
+    void report(benchmark::State& state) const;
+    // Also "<stage>_allocs" and "<stage>_bytes" for every pipeline stage that allocated.
+    void report_stages(benchmark::State& state) const;
+
+private:
+    double iterations() const;
+
+    Hummingbird::Core::Allocations::Snapshot m_start;
+    Hummingbird::Core::Allocations::Snapshot m_last;
+    uint64_t m_iterations = 0;
+};
+
+}  // namespace BenchAllocations
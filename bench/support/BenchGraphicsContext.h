@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "core/platform_api/IOffscreenGraphicsContext.h"
+
+// Headless context for benchmarks: drawing is a no-op and text metrics come from a character-count heuristic, so
+// layout cost is measured without any font rasterization.
+class BenchGraphicsContext : public IGraphicsContext {
+public:
+    void set_viewport(const Hummingbird::Layout::Rect& /*viewport*/) override {}
+    void clear(const Color& /*color*/) override {}
+    void present() override {}
+    void fill_rect(const Hummingbird::Layout::Rect& /*rect*/, const Color& /*color*/) override {}
+
+    TextMetrics measure_text(std::string_view text, const TextStyle& style) override {
+        return TextMetrics{static_cast<float>(text.size()) * style.font_size * 0.5f, style.font_size * 1.2f};
+    }
+
+    void draw_text(std::string_view /*text*/, float /*x*/, float /*y*/, const TextStyle& /*style*/) override {}
+};
+
+// BenchGraphicsContext as an offscreen surface: "encoding" returns a single byte, so batch benchmarks measure the
+// pipeline and painter rather than PNG compression.
+class BenchOffscreenContext : public IOffscreenGraphicsContext {
+public:
+    BenchOffscreenContext(int width, int height) : m_width(width), m_height(height) {}
+
+    void set_viewport(const Hummingbird::Layout::Rect& viewport) override { m_context.set_viewport(viewport); }
+    void clear(const Color& color) override { m_context.clear(color); }
+    void present() override { m_context.present(); }
+    void fill_rect(const Hummingbird::Layout::Rect& rect, const Color& color) override {
+        m_context.fill_rect(rect, color);
+    }
+    TextMetrics measure_text(std::string_view text, const TextStyle& style) override {
+        return m_context.measure_text(text, style);
+    }
+    void draw_text(std::string_view text, float x, float y, const TextStyle& style) override {
+        m_context.draw_text(text, x, y, style);
+    }
+
+    std::pair<int, int> get_size() const override { return {m_width, m_height}; }
+    void resize(int width, int height) override {
+        m_width = width;
+        m_height = height;
+    }
+    std::vector<uint8_t> encode_png() override { return {0}; }
+
+private:
+    BenchGraphicsContext m_context;
+    int m_width = 0;
+    int m_height = 0;
+};
@@ -0,0 +1,168 @@
+#include "support/SyntheticDocument.h"
+
+#include <cstdlib>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+#include "html/HtmlParser.h"
+#include "layout/TreeBuilder.h"
+#include "style/CssParser.h"
+#include "style/StyleEngine.h"
+
+namespace BenchDocuments {
+namespace {
+constexpr int kParagraphsPerSection = 4;
+constexpr int kWordsPerParagraph = 40;
+constexpr int kListItemsPerSection = 3;
+constexpr int kTableEverySections = 4;
+constexpr int kTableRows = 4;
+constexpr int kTableColumns = 5;
+// Markup arena bytes per source byte; the same ratio DocumentPipeline uses for dense pages.
+constexpr size_t kArenaBytesPerHtmlByte = 16;
+
+constexpr const char* kWords[] = {"lorem",      "ipsum", "dolor", "sit", "amet",    "consectetur", "adipiscing",
+                                  "elit",       "sed",   "do",    "eiusmod", "tempor", "incididunt", "labore",
+                                  "dolore",     "magna", "aliqua"};
+
+void append_paragraph(std::string& html, int section, int paragraph) {
+    html += "<p class=\"body-text\">";
+    for (int w = 0; w < kWordsPerParagraph; ++w) {
+        const int word = section * 31 + paragraph * 7 + w;
+        if (w % 13 == 3) html += "<b>";
+        if (w % 17 == 8) html += "<a href=\"#sec" + std::to_string(section) + "\">";
+        if (w % 19 == 11) html += "<span class=\"note\">";
+        html += kWords[word % std::size(kWords)];
+        if (w % 19 == 13) html += "</span>";
+        if (w % 17 == 9) html += "</a>";
+        if (w % 13 == 5) html += "</b>";
+        html += ' ';
+    }
+    html += "</p>";
+}
+
+void append_table(std::string& html, int section) {
+    html += "<table class=\"data\">";
+    for (int r = 0; r < kTableRows; ++r) {
+        html += "<tr>";
+        for (int c = 0; c < kTableColumns; ++c) {
+            html += "<td>";
+            html += std::to_string(section * kTableRows + r);
+            html += c == kTableColumns - 1 ? " a longer note that wraps" : " cell";
+            html += "</td>";
+        }
+        html += "</tr>";
+    }
+    html += "</table>";
+}
+
+std::vector<int> parse_sizes(std::string_view list) {
+    std::vector<int> sizes;
+    size_t start = 0;
+    while (start < list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string_view::npos) end = list.size();
+        const int size = std::atoi(std::string(list.substr(start, end - start)).c_str());
+        if (size > 0) sizes.push_back(size);
+        start = end + 1;
+    }
+    return sizes;
+}
+}  // namespace
+
+std::string make_page_html(int section_count) {
+    std::string html = "<html><head><title>synthetic</title></head><body><div id=\"page\" class=\"layout\">";
+    for (int s = 0; s < section_count; ++s) {
+        html += "<div class=\"section tone-" + std::to_string(s % 4) + "\" id=\"sec" + std::to_string(s) + "\">";
+        html += "<h2>Section " + std::to_string(s) + "</h2>";
+        for (int p = 0; p < kParagraphsPerSection; ++p) {
+            append_paragraph(html, s, p);
+        }
+        html += "<ul class=\"links\">";
+        for (int i = 0; i < kListItemsPerSection; ++i) {
+            html += "<li><a href=\"#sec" + std::to_string((s + i + 1) % section_count) + "\">related " +
+                    std::to_string(i) + "</a></li>";
+        }
+        html += "</ul>";
+        if (s % kTableEverySections == 0) append_table(html, s);
+        html += "</div>";
+    }
+    html += "</div></body></html>";
+    return html;
+}
+
+std::string make_page_css() {
+    std::string css =
+        "body { margin: 8px; }\n"
+        "#page { padding: 4px; }\n"
+        ".section { margin: 12px; padding: 8px; border-width: 1px; border-style: solid; border-color: #cccccc; }\n"
+        ".section h2 { font-size: 24px; margin: 6px; }\n"
+        "p.body-text { margin: 4px; line-height: 20px; }\n"
+        "p b { color: #222222; }\n"
+        "a { color: #1a4d99; }\n"
+        ".section ul a { color: #003366; }\n"
+        ".note { color: #666666; }\n"
+        "ul.links li { margin: 2px; }\n"
+        "table.data { width: 100%; }\n"
+        "table.data td { padding: 2px; border-width: 1px; border-style: solid; border-color: #dddddd; }\n";
+    for (int tone = 0; tone < 4; ++tone) {
+        css += ".tone-" + std::to_string(tone) + " { background-color: #f" + std::to_string(tone) + "f" +
+               std::to_string(tone) + "f" + std::to_string(tone) + "; }\n";
+    }
+    // Rules that match nothing still cost selector matching on every element.
+    for (int i = 0; i < 200; ++i) {
+        css += ".unused-" + std::to_string(i) + " div span { margin: " + std::to_string(i % 16) + "px; }\n";
+    }
+    return css;
+}
+
+PreparedDocument prepare(const std::string& html, const std::string& css, Stage last_stage,
+                         IGraphicsContext& context, float width) {
+    PreparedDocument document;
+    document.arena = std::make_unique<ArenaAllocator>(html.size() * kArenaBytesPerHtmlByte);
+    Hummingbird::Html::Parser parser(*document.arena, html);
+    document.dom = std::move(parser.parse().dom);
+    if (last_stage == Stage::Parsed) return document;
+
+    Hummingbird::Css::Parser css_parser(css);
+    document.sheet = std::make_unique<Hummingbird::Css::Stylesheet>(css_parser.parse());
+    Hummingbird::Css::StyleEngine engine;
+    engine.apply(*document.sheet, document.dom.get());
+    if (last_stage == Stage::Styled) return document;
+
+    Hummingbird::Layout::TreeBuilder builder;
+    document.render_tree = builder.build(document.dom.get());
+    if (last_stage == Stage::RenderTree) return document;
+
+    document.render_tree->layout(context, {0, 0, width, 600});
+    return document;
+}
+
+size_t count_nodes(const Hummingbird::DOM::Node* node) {
+    if (!node) return 0;
+    size_t total = 1;
+    for (const auto& child : node->get_children()) {
+        total += count_nodes(child.get());
+    }
+    return total;
+}
+
+void mark_subtree_needs_layout(Hummingbird::Layout::RenderObject& object) {
+    object.mark_needs_layout();
+    for (const auto& child : object.get_children()) {
+        mark_subtree_needs_layout(*child);
+    }
+}
+
+void apply_document_sizes(benchmark::internal::Benchmark* benchmark) {
+    std::vector<int> sizes = {16, 128, 1024};
+    if (const char* env = std::getenv("HB_BENCH_SECTIONS")) {
+        auto requested = parse_sizes(env);
+        if (!requested.empty()) sizes = std::move(requested);
+    }
+    for (int size : sizes) {
+        benchmark->Arg(size);
+    }
+}
+
+}  // namespace BenchDocuments
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+
+#include "core/ArenaAllocator.h"
+#include "core/dom/Node.h"
+#include "core/platform_api/IGraphicsContext.h"
+#include "layout/RenderObject.h"
+#include "style/Stylesheet.h"
+
+// Synthetic pages for the per-stage benchmarks. A page is a run of sections, each with a heading, paragraphs of
+// words mixed with inline elements, a list and (every fourth section) a small table, so every stage sees the kinds of
+// nodes it handles on real pages. Sizes are in sections (roughly 1.5KB of markup and 60 DOM nodes each).
+namespace BenchDocuments {
+
+std::string make_page_html(int section_count);
+// Rules targeting the classes, ids and nesting make_page_html() emits, plus unmatched ones.
+std::string make_page_css();
+
+// How far prepare() runs the pipeline.
+enum class Stage {
+    Parsed,
+    Styled,
+    RenderTree,
+    LaidOut,
+};
+
+// One document run through the pipeline up to a stage. Members are declared in dependency order: the arena outlives
+// the DOM it holds, and the DOM outlives the render tree that points into it.
+struct PreparedDocument {
+    std::unique_ptr<ArenaAllocator> arena;
+    ArenaPtr<Hummingbird::DOM::Node> dom;
+    std::unique_ptr<Hummingbird::Css::Stylesheet> sheet;
+    std::unique_ptr<Hummingbird::Layout::RenderObject> render_tree;
+};
+
+PreparedDocument prepare(const std::string& html, const std::string& css, Stage last_stage,
+                         IGraphicsContext& context, float width);
+
+size_t count_nodes(const Hummingbird::DOM::Node* node);
+void mark_subtree_needs_layout(Hummingbird::Layout::RenderObject& object);
+
+// Registers the document sizes (in sections) a size-driven benchmark runs at: HB_BENCH_SECTIONS, a comma-separated
+// list such as "16,256,4096", or a default small/medium/large spread.
+void apply_document_sizes(benchmark::internal::Benchmark* benchmark);
+
+}  // namespace BenchDocuments
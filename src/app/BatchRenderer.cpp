@@ -0,0 +1,184 @@
+#include "app/BatchRenderer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include "core/platform_api/WindowFactory.h"
+#include "core/utils/Timing.h"
+#include "core/utils/Trace.h"
+#include "renderer/Painter.h"
+#include "style/StylesheetCache.h"
+
+// Include concrete definitions:
+#include "layout/RenderObject.h"
+
+bool is_url_input(std::string_view input) {
+    return input.starts_with("http://") || input.starts_with("https://");
+}
+
+namespace {
+constexpr Color kPageBackground{255, 255, 255, 255};
+
+bool write_file(const std::filesystem::path& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(out);
+}
+
+// "0003-index.png" for "pages/index.html", "0004-example_com_a.png" for "https://example.com/a". The index keeps
+// names unique and in input order.
+std::filesystem::path output_name(size_t index, const std::string& input) {
+    std::string stem =
+        is_url_input(input) ? input.substr(input.find("://") + 3) : std::filesystem::path(input).stem().string();
+    for (char& c : stem) {
+        const bool keep = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-';
+        if (!keep) c = '_';
+    }
+    std::ostringstream name;
+    name << std::setw(4) << std::setfill('0') << index << '-' << stem << ".png";
+    return name.str();
+}
+}  // namespace
+
+class BatchRenderer::Worker {
+public:
+    Worker(const BatchSettings& settings, IResourceProvider* resources,
+           std::shared_ptr<const Hummingbird::Css::Stylesheet> ua_stylesheet,
+           std::shared_ptr<Hummingbird::Css::StylesheetCache> stylesheet_cache,
+           const OffscreenContextFactory& make_context)
+        : settings_(settings),
+          graphics_(make_context(settings.width, settings.height)),
+          pipeline_(*graphics_, resources, std::move(ua_stylesheet), std::move(stylesheet_cache)) {}
+
+    BatchDocumentResult render(size_t index, const std::string& input, const DocumentLoader& load) {
+        HB_TRACE_ZONE("batch", "BatchRenderer::render_document");
+        // Measured around the whole document so inputs that fail part way report what they did allocate.
+        const auto allocations_before = Hummingbird::Core::Allocations::thread_snapshot();
+        BatchDocumentResult result = render_document(index, input, load);
+        result.allocations = Hummingbird::Core::Allocations::thread_snapshot() - allocations_before;
+        return result;
+    }
+
+private:
+    BatchDocumentResult render_document(size_t index, const std::string& input, const DocumentLoader& load) {
+        BatchDocumentResult result;
+        result.input = input;
+
+        const auto load_start = Hummingbird::Core::Clock::now();
+        auto html = load(input);
+        result.load_ms = Hummingbird::Core::duration_ms(load_start, Hummingbird::Core::Clock::now());
+        if (!html) {
+            result.error = "failed to load input";
+            return result;
+        }
+
+        const Hummingbird::Layout::Rect viewport{0.0f, 0.0f, static_cast<float>(settings_.width),
+                                                 static_cast<float>(settings_.height)};
+        std::unique_ptr<DocumentSnapshot> document;
+        try {
+            document = pipeline_.build(index + 1, *html, viewport, LayoutScope::Full, {}, &result.pipeline);
+        } catch (const std::bad_alloc&) {
+            result.error = "out of memory";
+            return result;
+        }
+        if (!document) {
+            result.error = "empty document";
+            return result;
+        }
+
+        const auto paint_start = Hummingbird::Core::Clock::now();
+        {
+            Hummingbird::Core::Allocations::StageScope allocation_stage(Hummingbird::Core::Allocations::Stage::Paint);
+            graphics_->set_viewport(viewport);
+            graphics_->clear(kPageBackground);
+            Hummingbird::Renderer::PaintOptions paint_options;
+            paint_options.viewport = viewport;
+            painter_.paint(*document->render_tree, *graphics_, paint_options);
+            graphics_->present();
+        }
+        const auto paint_end = Hummingbird::Core::Clock::now();
+        result.paint_ms = Hummingbird::Core::duration_ms(paint_start, paint_end);
+        pipeline_.recycle(std::move(document));
+
+        std::vector<uint8_t> png;
+        {
+            HB_TRACE_ZONE("paint", "encode_png");
+            png = graphics_->encode_png();
+        }
+        result.encode_ms = Hummingbird::Core::duration_ms(paint_end, Hummingbird::Core::Clock::now());
+        if (png.empty()) {
+            result.error = "png encode failed";
+            return result;
+        }
+
+        if (settings_.write_png) {
+            result.output = settings_.output_dir / output_name(index, input);
+            if (!write_file(result.output, png)) {
+                result.error = "failed to write " + result.output.string();
+                return result;
+            }
+        }
+        result.ok = true;
+        return result;
+    }
+
+    const BatchSettings& settings_;
+    std::unique_ptr<IOffscreenGraphicsContext> graphics_;
+    DocumentPipeline pipeline_;
+    Hummingbird::Renderer::Painter painter_;
+};
+
+BatchRenderer::BatchRenderer(BatchSettings settings, IResourceProvider* resources,
+                             OffscreenContextFactory make_context)
+    : settings_(std::move(settings)) {
+    if (!make_context) {
+        make_context = [raster_threads = settings_.raster_threads](int width, int height) {
+            return create_offscreen_graphics_context(width, height, raster_threads);
+        };
+    }
+    settings_.worker_count = std::max<size_t>(1, settings_.worker_count);
+
+    auto ua_stylesheet = DocumentPipeline::load_ua_stylesheet(resources);
+    auto stylesheet_cache = std::make_shared<Hummingbird::Css::StylesheetCache>();
+    workers_.reserve(settings_.worker_count);
+    for (size_t i = 0; i < settings_.worker_count; ++i) {
+        workers_.push_back(
+            std::make_unique<Worker>(settings_, resources, ua_stylesheet, stylesheet_cache, make_context));
+    }
+}
+
+BatchRenderer::~BatchRenderer() = default;
+
+std::vector<BatchDocumentResult> BatchRenderer::render(const std::vector<std::string>& inputs,
+                                                       const DocumentLoader& load) {
+    std::vector<BatchDocumentResult> results(inputs.size());
+    std::atomic<size_t> next_input{0};
+    auto drain = [&](size_t worker_index) {
+        HB_TRACE_THREAD_NAME("batch worker " + std::to_string(worker_index));
+        Worker& worker = *workers_[worker_index];
+        for (size_t i = next_input.fetch_add(1, std::memory_order_relaxed); i < inputs.size();
+             i = next_input.fetch_add(1, std::memory_order_relaxed)) {
+            results[i] = worker.render(i, inputs[i], load);
+            results[i].worker = worker_index;
+        }
+    };
+
+    // The calling thread works as worker 0.
+    const size_t active = std::min(workers_.size(), inputs.size());
+    std::vector<std::thread> threads;
+    threads.reserve(active > 0 ? active - 1 : 0);
+    for (size_t w = 1; w < active; ++w) {
+        threads.emplace_back(drain, w);
+    }
+    if (active > 0) drain(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return results;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "app/DocumentPipeline.h"
+#include "core/platform_api/IOffscreenGraphicsContext.h"
+#include "core/platform_api/IResourceProvider.h"
+#include "core/utils/AllocationStats.h"
+
+struct BatchSettings {
+    int width = 1024;
+    int height = 768;
+    size_t worker_count = 1;
+    uint32_t raster_threads = 0;       // Blend2D worker threads per worker's context (default factory only)
+    std::filesystem::path output_dir;  // where PNGs go when write_png is set
+    bool write_png = false;            // PNGs are always encoded, so encode cost shows up in the timings either way
+};
+
+struct BatchDocumentResult {
+    std::string input;
+    std::filesystem::path output;
+    bool ok = false;
+    std::string error;
+    size_t worker = 0;
+    double load_ms = 0.0;
+    PipelineTimings pipeline;
+    double paint_ms = 0.0;
+    double encode_ms = 0.0;
+    // Heap allocations of the whole document, load, encode and write included (those count as Stage::Other), also
+    // for inputs that fail; all zero unless the allocation hooks are linked in.
+    Hummingbird::Core::Allocations::Snapshot allocations;
+
+    // Everything but loading: the CPU cost of turning markup into an image.
+    double render_ms() const {
+        return pipeline.parse_ms + pipeline.style_ms + pipeline.tree_ms + pipeline.layout_ms + paint_ms + encode_ms;
+    }
+};
+
+// Whether a batch input names an http(s) URL rather than a local file.
+bool is_url_input(std::string_view input);
+
+// Produces the markup for an input; nullopt when it cannot be loaded. Called concurrently from every worker.
+using DocumentLoader = std::function<std::optional<std::string>(const std::string& input)>;
+using OffscreenContextFactory = std::function<std::unique_ptr<IOffscreenGraphicsContext>(int width, int height)>;
+
+// Renders many documents in parallel with a fixed pool of workers. Each worker owns everything that is mutated while
+// rendering (pipeline with its style engine, tree builder and recycled DOM arena; painter; graphics context) and keeps
+// it across documents and across render() calls. Workers share only read-only or internally synchronized state: the
+// parsed UA stylesheet, the author stylesheet cache, the resource provider and the process-wide font faces.
+class BatchRenderer {
+public:
+    // |make_context| defaults to create_offscreen_graphics_context() with settings.raster_threads.
+    BatchRenderer(BatchSettings settings, IResourceProvider* resources, OffscreenContextFactory make_context = {});
+    ~BatchRenderer();
+    BatchRenderer(const BatchRenderer&) = delete;
+    BatchRenderer& operator=(const BatchRenderer&) = delete;
+
+    // Renders every input; results come back in input order. Inputs are handed out one at a time, so a few slow
+    // documents do not leave the other workers idle.
+    std::vector<BatchDocumentResult> render(const std::vector<std::string>& inputs, const DocumentLoader& load);
+
+    const BatchSettings& settings() const { return settings_; }
+
+private:
+    class Worker;
+
+    BatchSettings settings_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+};
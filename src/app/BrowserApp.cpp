@@ -1,19 +1,19 @@
 #include "app/BrowserApp.h"
 
 #include <algorithm>
+#include <fstream>
+#include <sstream>
 #include <utility>
 
 #include "core/platform_api/NetworkFactory.h"
 #include "core/platform_api/ResourceProviderFactory.h"
+#include "core/utils/AllocationStats.h"
 #include "core/utils/AssetPath.h"
 #include "core/utils/Log.h"
 #include "core/utils/Timing.h"
-#include "html/HtmlParser.h"
-#include "style/CssParser.h"
-#include "style/StylesheetSource.h"
 
 // Include concrete definitions:
-#include "core/dom/Node.h"
+#include "core/utils/Trace.h"
 #include "layout/RenderObject.h"
 
 namespace {
@@ -21,15 +21,6 @@ namespace {
 constexpr Color kClearColor{255, 255, 255, 255};
 constexpr Color kOverlayBg{220, 220, 220, 255};
 constexpr Color kOverlayText{0, 0, 0, 255};
-
-size_t count_nodes_recursive(const Hummingbird::DOM::Node* node) {
-    if (!node) return 0;
-    size_t total = 1;
-    for (const auto& child : node->get_children()) {
-        total += count_nodes_recursive(child.get());
-    }
-    return total;
-}
 }  // namespace
 
 BrowserApp::BrowserApp(std::unique_ptr<IWindow> window) : window_(std::move(window)) {
@@ -43,6 +34,11 @@ BrowserApp::BrowserApp(std::unique_ptr<IWindow> window) : window_(std::move(wind
     if (!resource_provider_) {
         HB_LOG_WARN("[resource] no resource provider available");
     }
+    ua_stylesheet_ = DocumentPipeline::load_ua_stylesheet(resource_provider_.get());
+    if (graphics_) {
+        layout_worker_ =
+            std::make_unique<LayoutWorker>(*graphics_, resource_provider_.get(), ua_stylesheet_, active_nav_);
+    }
 }
 
 BrowserApp::~BrowserApp() {
@@ -62,6 +58,8 @@ void BrowserApp::shutdown() {
     // stop/join async work BEFORE pending_mutex_ etc can die
     if (network_) network_->shutdown();
     if (fallback_network_) fallback_network_->shutdown();
+    // the layout thread sees the invalidated nav id and abandons its document at the next stage
+    if (layout_worker_) layout_worker_->stop();
 
     // optional: clear pending html
     {
@@ -71,6 +69,22 @@ void BrowserApp::shutdown() {
 
     // close window last (or earlier if you prefer to hide UI immediately)
     if (window_ && window_->is_open()) window_->close();
+
+    if (frame_stats_.frames() > 0) {
+        std::ostringstream report;
+        frame_stats_.write_report(report);
+        HB_LOG_INFO("[perf] frame stats\n" << report.str());
+    }
+    if (Hummingbird::Core::Allocations::hooks_installed()) {
+        std::ostringstream summary;
+        Hummingbird::Core::Allocations::write_summary(summary, Hummingbird::Core::Allocations::thread_snapshot());
+        HB_LOG_INFO("[alloc] main thread: " << summary.str());
+    }
+    if (!frame_stats_path_.empty()) {
+        std::ofstream out(frame_stats_path_);
+        frame_stats_.write_json(out);
+        if (!out) HB_LOG_ERROR("[perf] cannot write frame stats to " << frame_stats_path_.string());
+    }
 }
 
 void BrowserApp::start() {
@@ -89,12 +103,16 @@ bool BrowserApp::tick() {
 
     window_->update();
 
+    frame_stats_.begin_frame();
     pump_events();
 
     if (!window_->is_open()) return false;
 
     consume_pending_html_and_rebuild();
+    adopt_ready_document();
     render_if_needed();
+    advance_progressive_layout();
+    frame_stats_.end_frame();
 
     return window_->is_open();
 }
@@ -113,6 +131,8 @@ void BrowserApp::pump_events() {
 }
 
 void BrowserApp::handle_event(const InputEvent& event) {
+    HB_TRACE_ZONE("app", "BrowserApp::handle_event");
+    FrameStats::Scope frame_phase(frame_stats_, FramePhase::EventPump);
     switch (event.type) {
         case EventType::Quit:
             handle_quit_event();
@@ -174,6 +194,13 @@ void BrowserApp::handle_key_down_event(const InputEvent& event) {
         return;
     }
 
+    if (event.key.key == Key::F2) {
+        frame_stats_overlay_ = !frame_stats_overlay_;
+        HB_LOG_INFO("[ui] Frame stats overlay " << (frame_stats_overlay_ ? "ON" : "OFF"));
+        needs_repaint_ = true;
+        return;
+    }
+
     if (event.key.key == Key::L && event.mods.ctrl) {
         set_url_bar_active(true, "[ui] URL bar focused");
         needs_repaint_ = true;
@@ -200,6 +227,7 @@ void BrowserApp::handle_mouse_wheel_event(const InputEvent& event) {
     auto [win_w, win_h] = window_->get_size();
     const float viewport_h = static_cast<float>(win_h - url_bar_height_);
     clamp_scroll(viewport_h);
+    layout_for_scroll();
 
     needs_repaint_ = true;
 }
@@ -228,20 +256,67 @@ void BrowserApp::clamp_scroll(float viewport_height) {
     scroll_y_ = std::clamp(scroll_y_, 0.0f, max_scroll);
 }
 
+Hummingbird::Layout::Rect BrowserApp::document_viewport(int win_w, int win_h) const {
+    const int content_h = std::max(0, win_h - url_bar_height_);
+    return {0.0f, static_cast<float>(url_bar_height_), static_cast<float>(win_w), static_cast<float>(content_h)};
+}
+
+// Only what the viewport shows is laid out here; the rest of the document starts with estimated heights and is
+// filled in by advance_progressive_layout() between frames.
 void BrowserApp::relayout_for_window(int win_w, int win_h) {
-    if (!render_tree_ || !graphics_) return;
+    HB_TRACE_ZONE("layout", "BrowserApp::relayout_for_window");
+    auto* root = render_tree();
+    if (!root || !graphics_) return;
+    FrameStats::Scope frame_phase(frame_stats_, FramePhase::Layout);
+    Hummingbird::Core::Allocations::StageScope allocation_stage(Hummingbird::Core::Allocations::Stage::Layout);
 
     const auto layout_start = Hummingbird::Core::Clock::now();
-    const int content_h = std::max(0, win_h - url_bar_height_);
-    Hummingbird::Layout::Rect viewport{0.0f, static_cast<float>(url_bar_height_), static_cast<float>(win_w),
-                                       static_cast<float>(content_h)};
-
-    render_tree_->layout(*graphics_, viewport);
+    const auto viewport = document_viewport(win_w, win_h);
+    scroll_y_ = progressive_layout_.layout_viewport(*root, *graphics_, viewport, scroll_y_);
     const auto layout_end = Hummingbird::Core::Clock::now();
-    content_height_ = render_tree_->get_rect().height;
+    content_height_ = root->get_rect().height;
     clamp_scroll(viewport.height);
     HB_LOG_INFO("[perf] layout ms=" << Hummingbird::Core::duration_ms(layout_start, layout_end)
-                                    << " viewport=" << viewport.width << "x" << viewport.height);
+                                    << " viewport=" << viewport.width << "x" << viewport.height << " complete="
+                                    << Hummingbird::Layout::ProgressiveLayout::is_complete(*root));
+}
+
+void BrowserApp::layout_for_scroll() {
+    auto* root = render_tree();
+    if (!root || !graphics_ || Hummingbird::Layout::ProgressiveLayout::is_complete(*root)) return;
+    FrameStats::Scope frame_phase(frame_stats_, FramePhase::Layout);
+    Hummingbird::Core::Allocations::StageScope allocation_stage(Hummingbird::Core::Allocations::Stage::Layout);
+
+    auto [win_w, win_h] = window_->get_size();
+    const auto viewport = document_viewport(win_w, win_h);
+    scroll_y_ = progressive_layout_.layout_viewport(*root, *graphics_, viewport, scroll_y_);
+    content_height_ = root->get_rect().height;
+    clamp_scroll(viewport.height);
+}
+
+// Idle-time layout: each tick replaces more estimates around the viewport until the document is fully laid out.
+void BrowserApp::advance_progressive_layout() {
+    auto* root = render_tree();
+    if (!root || !graphics_ || Hummingbird::Layout::ProgressiveLayout::is_complete(*root)) return;
+    FrameStats::Scope frame_phase(frame_stats_, FramePhase::Layout);
+    Hummingbird::Core::Allocations::StageScope allocation_stage(Hummingbird::Core::Allocations::Stage::Layout);
+
+    auto [win_w, win_h] = window_->get_size();
+    const auto viewport = document_viewport(win_w, win_h);
+    const float previous_scroll = scroll_y_;
+    const auto layout_start = Hummingbird::Core::Clock::now();
+    scroll_y_ = progressive_layout_.advance(*root, *graphics_, viewport, scroll_y_);
+    const auto layout_end = Hummingbird::Core::Clock::now();
+    content_height_ = root->get_rect().height;
+    clamp_scroll(viewport.height);
+    if (scroll_y_ != previous_scroll) {
+        needs_repaint_ = true;
+    }
+    HB_LOG_DEBUG("[perf] progressive layout ms=" << Hummingbird::Core::duration_ms(layout_start, layout_end)
+                                                 << " content_height=" << content_height_);
+    if (Hummingbird::Layout::ProgressiveLayout::is_complete(*root)) {
+        HB_LOG_INFO("[perf] progressive layout complete content_height=" << content_height_);
+    }
 }
 
 void BrowserApp::load_url(const std::string& url) {
@@ -255,7 +330,7 @@ void BrowserApp::load_url(const std::string& url) {
         fallback_network_->get(url, [this, id](std::string body) {
             if (id != active_nav_.load(std::memory_order_relaxed)) return;
             std::lock_guard<std::mutex> lg(pending_mutex_);
-            pending_html_ = std::move(body);
+            pending_html_ = PendingHtml{id, std::move(body)};
         });
         return;
     }
@@ -266,7 +341,7 @@ void BrowserApp::load_url(const std::string& url) {
             fallback_network_->get(url, [this, id](std::string body) {
                 if (id != active_nav_.load(std::memory_order_relaxed)) return;
                 std::lock_guard<std::mutex> lg(pending_mutex_);
-                pending_html_ = std::move(body);
+                pending_html_ = PendingHtml{id, std::move(body)};
             });
         }
         return;
@@ -282,139 +357,48 @@ void BrowserApp::load_url(const std::string& url) {
             fallback_network_->get(url, [this, id](std::string fallback) {
                 if (id != active_nav_.load(std::memory_order_relaxed)) return;
                 std::lock_guard<std::mutex> lg(pending_mutex_);
-                pending_html_ = std::move(fallback);
+                pending_html_ = PendingHtml{id, std::move(fallback)};
             });
             return;
         }
 
         HB_LOG_INFO("[network] fetched " << body.size() << " bytes from " << url);
         std::lock_guard<std::mutex> lg(pending_mutex_);
-        pending_html_ = std::move(body);
+        pending_html_ = PendingHtml{id, std::move(body)};
     });
 }
 
+// Hands the newest fetched HTML to the layout thread; the current document stays on screen until the new one is ready.
 void BrowserApp::consume_pending_html_and_rebuild() {
-    auto html = take_pending_html();
-    if (!html) return;
-    rebuild_from_html(*html);
-}
-
-std::optional<std::string> BrowserApp::take_pending_html() {
-    std::optional<std::string> html;
-    std::lock_guard<std::mutex> lg(pending_mutex_);
-    if (pending_html_) {
-        html = std::move(pending_html_);
+    std::optional<PendingHtml> pending;
+    {
+        std::lock_guard<std::mutex> lg(pending_mutex_);
+        pending = std::move(pending_html_);
         pending_html_.reset();
     }
-    return html;
-}
-
-void BrowserApp::rebuild_from_html(const std::string& html) {
-    reset_document_state();
-    HB_LOG_INFO("[pipeline] html size: " << html.size());
+    if (!pending || !layout_worker_) return;
+    FrameStats::Scope frame_phase(frame_stats_, FramePhase::Rebuild);
 
-    std::vector<std::string> style_blocks;
-    std::vector<std::string> stylesheet_links;
-    if (!parse_html(html, style_blocks, stylesheet_links)) {
-        return;
-    }
-    if (!stylesheet_links.empty()) {
-        HB_LOG_INFO("[pipeline] discovered stylesheet links: " << stylesheet_links.size());
-    }
-
-    std::string css = build_css_source(style_blocks, stylesheet_links);
-    parse_and_apply_css(css);
+    auto [win_w, win_h] = window_->get_size();
+    layout_worker_->submit(pending->nav_id, std::move(pending->html), document_viewport(win_w, win_h));
+}
 
-    if (!build_render_tree()) {
-        return;
-    }
+void BrowserApp::adopt_ready_document() {
+    HB_TRACE_ZONE("app", "BrowserApp::adopt_ready_document");
+    if (!layout_worker_) return;
+    auto ready = layout_worker_->take_ready();
+    if (!ready || ready->nav_id != active_nav_.load(std::memory_order_relaxed)) return;
+    FrameStats::Scope frame_phase(frame_stats_, FramePhase::Rebuild);
 
+    document_ = std::move(ready);
+    scroll_y_ = 0.0f;
+    // Cheap when the window size is unchanged (the worker laid out this viewport), and catches resizes meanwhile.
     layout_current_window();
-    HB_LOG_INFO("[pipeline] render tree root children: " << render_tree_->get_children().size());
     needs_repaint_ = true;
 }
 
-void BrowserApp::reset_document_state() {
-    dom_tree_.reset();
-    render_tree_.reset();
-    dom_arena_.reset();
-}
-
-bool BrowserApp::parse_html(const std::string& html, std::vector<std::string>& style_blocks,
-                            std::vector<std::string>& stylesheet_links) {
-    const auto parse_start = Hummingbird::Core::Clock::now();
-    Hummingbird::Html::Parser parser(dom_arena_, html);
-    auto parse_result = parser.parse();
-    const auto parse_end = Hummingbird::Core::Clock::now();
-
-    dom_tree_ = std::move(parse_result.dom);
-    style_blocks = std::move(parse_result.style_blocks);
-    stylesheet_links = std::move(parse_result.stylesheet_links);
-
-    if (!dom_tree_) {
-        HB_LOG_WARN("[pipeline] parsed empty DOM");
-        return false;
-    }
-
-    HB_LOG_INFO("[pipeline] parsed DOM children: " << dom_tree_->get_children().size()
-                                                   << " total nodes: " << count_nodes_recursive(dom_tree_.get()));
-    HB_LOG_INFO("[perf] html parse ms=" << Hummingbird::Core::duration_ms(parse_start, parse_end));
-    return true;
-}
-
-std::string BrowserApp::build_css_source(const std::vector<std::string>& style_blocks,
-                                         const std::vector<std::string>& stylesheet_links) const {
-    std::string ua_css;
-    if (resource_provider_) {
-        if (auto ua = resource_provider_->load_text("assets/ua.css")) {
-            ua_css = std::move(*ua);
-        }
-    }
-    if (ua_css.empty()) {
-        ua_css = "body { padding: 8px; } p { margin: 4px; }";
-    }
-
-    std::vector<std::string> link_sources;
-    if (resource_provider_) {
-        link_sources.reserve(stylesheet_links.size());
-        for (const auto& href : stylesheet_links) {
-            auto text = resource_provider_->load_text(href);
-            if (!text) {
-                HB_LOG_WARN("[resource] missing stylesheet: " << href);
-                continue;
-            }
-            link_sources.push_back(std::move(*text));
-        }
-    }
-
-    return Hummingbird::Css::merge_css_sources(ua_css, link_sources, style_blocks);
-}
-
-void BrowserApp::parse_and_apply_css(const std::string& css) {
-    const auto css_parse_start = Hummingbird::Core::Clock::now();
-    Hummingbird::Css::Parser css_parser(css);
-    auto stylesheet = css_parser.parse();
-    const auto css_parse_end = Hummingbird::Core::Clock::now();
-    HB_LOG_INFO("[perf] css parse ms=" << Hummingbird::Core::duration_ms(css_parse_start, css_parse_end)
-                                       << " rules=" << stylesheet.rules.size());
-
-    const auto style_start = Hummingbird::Core::Clock::now();
-    style_engine_.apply(stylesheet, dom_tree_.get());
-    const auto style_end = Hummingbird::Core::Clock::now();
-    HB_LOG_INFO("[pipeline] applied stylesheet rules: " << stylesheet.rules.size());
-    HB_LOG_INFO("[perf] style apply ms=" << Hummingbird::Core::duration_ms(style_start, style_end));
-}
-
-bool BrowserApp::build_render_tree() {
-    const auto render_start = Hummingbird::Core::Clock::now();
-    render_tree_ = tree_builder_.build(dom_tree_.get());
-    const auto render_end = Hummingbird::Core::Clock::now();
-    if (!render_tree_ || !graphics_) {
-        HB_LOG_WARN("[pipeline] render tree build skipped");
-        return false;
-    }
-    HB_LOG_INFO("[perf] render tree build ms=" << Hummingbird::Core::duration_ms(render_start, render_end));
-    return true;
+Hummingbird::Layout::RenderObject* BrowserApp::render_tree() const {
+    return document_ ? document_->render_tree.get() : nullptr;
 }
 
 void BrowserApp::layout_current_window() {
@@ -423,7 +407,10 @@ void BrowserApp::layout_current_window() {
 }
 
 void BrowserApp::render_if_needed() {
+    HB_TRACE_ZONE("paint", "BrowserApp::render");
     if (!needs_repaint_ || !graphics_) return;
+    FrameStats::Scope frame_phase(frame_stats_, FramePhase::Paint);
+    Hummingbird::Core::Allocations::StageScope allocation_stage(Hummingbird::Core::Allocations::Stage::Paint);
 
     auto [win_w, win_h] = window_->get_size();
 
@@ -443,8 +430,15 @@ void BrowserApp::render_if_needed() {
 
     graphics_->draw_text(url_bar_text_ + (url_bar_active_ ? "|" : ""), 8.0f, 8.0f, url_style);
 
+    // Stats of the frames before this one, right-aligned in the URL bar.
+    if (frame_stats_overlay_) {
+        const std::string stats = frame_stats_.overlay_text();
+        const float stats_width = graphics_->measure_text(stats, url_style).width;
+        graphics_->draw_text(stats, std::max(8.0f, static_cast<float>(win_w) - stats_width - 8.0f), 8.0f, url_style);
+    }
+
     // Document paint
-    if (render_tree_) {
+    if (auto* root = render_tree()) {
         const int content_h = std::max(0, win_h - url_bar_height_);
         Hummingbird::Layout::Rect viewport{0.0f, static_cast<float>(url_bar_height_), static_cast<float>(win_w),
                                            static_cast<float>(content_h)};
@@ -457,12 +451,15 @@ void BrowserApp::render_if_needed() {
         opts.viewport = viewport;
 
         const auto paint_start = Hummingbird::Core::Clock::now();
-        painter_.paint(*render_tree_, *graphics_, opts);
+        painter_.paint(*root, *graphics_, opts);
         const auto paint_end = Hummingbird::Core::Clock::now();
         HB_LOG_DEBUG("[perf] paint ms=" << Hummingbird::Core::duration_ms(paint_start, paint_end)
                                         << " scroll_y=" << scroll_y_);
     }
 
-    graphics_->present();
+    {
+        FrameStats::Scope present_phase(frame_stats_, FramePhase::Present);
+        graphics_->present();
+    }
     needs_repaint_ = false;
 }
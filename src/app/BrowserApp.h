@@ -2,21 +2,22 @@
 
 #include <atomic>
 #include <cstdint>
+#include <filesystem>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
 
-#include "core/ArenaAllocator.h"
+#include "app/FrameStats.h"
+#include "app/LayoutWorker.h"
 #include "core/platform_api/IGraphicsContext.h"
 #include "core/platform_api/INetwork.h"
 #include "core/platform_api/IResourceProvider.h"
 #include "core/platform_api/IWindow.h"
 #include "core/platform_api/InputEvent.h"
-#include "layout/TreeBuilder.h"
+#include "layout/ProgressiveLayout.h"
 #include "renderer/Painter.h"
-#include "style/StyleEngine.h"
 
 // Forward decls (or include appropriate DOM/Layout headers if needed)
 namespace Hummingbird::DOM {
@@ -39,11 +40,17 @@ public:
     // Runs one iteration: events + pipeline + render. Returns false when app should exit.
     bool tick();
 
+    // Where shutdown() writes the frame statistics as JSON (empty: only log the summary).
+    void set_frame_stats_path(std::filesystem::path path) { frame_stats_path_ = std::move(path); }
+    const FrameStats& frame_stats() const { return frame_stats_; }
+
 private:
     // --- main tick phases ---
     void pump_events();
     void consume_pending_html_and_rebuild();
+    void adopt_ready_document();
     void render_if_needed();
+    void advance_progressive_layout();
 
     // --- event handling ---
     void handle_event(const InputEvent& e);
@@ -61,18 +68,17 @@ private:
     // --- helpers ---
     void clamp_scroll(float viewport_height);
     void relayout_for_window(int win_w, int win_h);
-    std::optional<std::string> take_pending_html();
-    void rebuild_from_html(const std::string& html);
-    void reset_document_state();
-    bool parse_html(const std::string& html, std::vector<std::string>& style_blocks,
-                    std::vector<std::string>& stylesheet_links);
-    std::string build_css_source(const std::vector<std::string>& style_blocks,
-                                 const std::vector<std::string>& stylesheet_links) const;
-    void parse_and_apply_css(const std::string& css);
-    bool build_render_tree();
+    void layout_for_scroll();
+    Hummingbird::Layout::Rect document_viewport(int win_w, int win_h) const;
+    Hummingbird::Layout::RenderObject* render_tree() const;
     void layout_current_window();
 
 private:
+    struct PendingHtml {
+        uint64_t nav_id = 0;
+        std::string html;
+    };
+
     // App Utils
     std::atomic<bool> shutting_down_{false};
     // Platform
@@ -81,14 +87,14 @@ private:
 
     // Async HTML handoff (network thread -> main thread)
     std::mutex pending_mutex_;
-    std::optional<std::string> pending_html_;
+    std::optional<PendingHtml> pending_html_;
 
     // Deps / subsystems
     std::unique_ptr<INetwork> network_;
     std::unique_ptr<INetwork> fallback_network_;
     ResourceProviderPtr resource_provider_;
-    Hummingbird::Css::StyleEngine style_engine_;
-    Hummingbird::Layout::TreeBuilder tree_builder_;
+    std::shared_ptr<const Hummingbird::Css::Stylesheet> ua_stylesheet_;  // parsed once at startup
+    Hummingbird::Layout::ProgressiveLayout progressive_layout_;
     Hummingbird::Renderer::Painter painter_;
 
     // UI state
@@ -96,6 +102,7 @@ private:
     std::string requested_url_ = url_bar_text_;
     bool url_bar_active_ = true;
     bool debug_outlines_ = false;
+    bool frame_stats_overlay_ = false;
     bool needs_repaint_ = true;
 
     int url_bar_height_ = 32;
@@ -106,10 +113,14 @@ private:
     std::atomic<uint64_t> nav_counter_{0};
     std::atomic<uint64_t> active_nav_{0};
 
-    // Document / layout state
-    ArenaAllocator dom_arena_{2 * 1024 * 1024};
-    ArenaPtr<Hummingbird::DOM::Node> dom_tree_;
-    std::unique_ptr<Hummingbird::Layout::RenderObject> render_tree_;
+    // Document / layout state. The worker builds the next document while this one keeps being painted; declared
+    // after everything the worker thread reads so it is stopped first on destruction.
+    std::unique_ptr<DocumentSnapshot> document_;
+    std::unique_ptr<LayoutWorker> layout_worker_;
+
+    // Frame timing (F2 toggles the overlay)
+    FrameStats frame_stats_;
+    std::filesystem::path frame_stats_path_;
 
     // Event draining controls
     int max_events_per_tick_ = 200;
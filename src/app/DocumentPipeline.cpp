@@ -0,0 +1,224 @@
+#include "app/DocumentPipeline.h"
+
+#include <algorithm>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "core/utils/Log.h"
+#include "core/utils/Timing.h"
+#include "core/utils/Trace.h"
+#include "html/HtmlParser.h"
+#include "layout/ProgressiveLayout.h"
+#include "style/CssParser.h"
+
+// Include concrete definitions:
+#include "core/dom/Node.h"
+#include "layout/RenderObject.h"
+
+namespace {
+constexpr std::string_view kUaStylesheetPath = "assets/ua.css";
+constexpr std::string_view kFallbackUaCss = "body { padding: 8px; } p { margin: 4px; }";
+
+// The DOM arena cannot grow, so it is sized from the markup; dense markup (tables, inline runs) needs roughly this
+// many arena bytes per source byte.
+constexpr size_t kMinArenaBytes = 2 * 1024 * 1024;
+constexpr size_t kArenaBytesPerHtmlByte = 16;
+
+size_t count_nodes_recursive(const Hummingbird::DOM::Node* node) {
+    if (!node) return 0;
+    size_t total = 1;
+    for (const auto& child : node->get_children()) {
+        total += count_nodes_recursive(child.get());
+    }
+    return total;
+}
+}  // namespace
+
+DocumentPipeline::DocumentPipeline(IGraphicsContext& graphics, IResourceProvider* resources,
+                                   std::shared_ptr<const Hummingbird::Css::Stylesheet> ua_stylesheet,
+                                   std::shared_ptr<Hummingbird::Css::StylesheetCache> stylesheet_cache)
+    : graphics_(graphics),
+      resources_(resources),
+      ua_stylesheet_(std::move(ua_stylesheet)),
+      stylesheet_cache_(stylesheet_cache ? std::move(stylesheet_cache)
+                                         : std::make_shared<Hummingbird::Css::StylesheetCache>()) {}
+
+std::shared_ptr<const Hummingbird::Css::Stylesheet> DocumentPipeline::load_ua_stylesheet(
+    IResourceProvider* resources) {
+    const auto css_parse_start = Hummingbird::Core::Clock::now();
+    std::optional<ResourceView> ua_view;
+    if (resources) {
+        ua_view = resources->map_resource(kUaStylesheetPath);
+    }
+    std::string_view ua_css = ua_view && !ua_view->bytes.empty() ? ua_view->bytes : kFallbackUaCss;
+    Hummingbird::Css::Parser css_parser(ua_css);
+    auto sheet = std::make_shared<const Hummingbird::Css::Stylesheet>(css_parser.parse());
+    const auto css_parse_end = Hummingbird::Core::Clock::now();
+    HB_LOG_INFO("[perf] ua css parse ms=" << Hummingbird::Core::duration_ms(css_parse_start, css_parse_end)
+                                          << " rules=" << sheet->rules.size());
+    return sheet;
+}
+
+std::unique_ptr<DocumentSnapshot> DocumentPipeline::build(uint64_t nav_id, const std::string& html,
+                                                          const Hummingbird::Layout::Rect& viewport, LayoutScope scope,
+                                                          const std::function<bool()>& cancelled,
+                                                          PipelineTimings* timings) {
+    HB_TRACE_ZONE("pipeline", "DocumentPipeline::build");
+    auto is_cancelled = [&cancelled] { return cancelled && cancelled(); };
+    PipelineTimings local_timings;
+    PipelineTimings& stage_timings = timings ? *timings : local_timings;
+    if (is_cancelled()) return nullptr;
+    HB_LOG_INFO("[pipeline] html size: " << html.size());
+    const auto allocations_before = Hummingbird::Core::Allocations::thread_snapshot();
+
+    auto document = std::make_unique<DocumentSnapshot>();
+    document->nav_id = nav_id;
+    document->viewport = viewport;
+    const size_t arena_bytes = std::max(kMinArenaBytes, html.size() * kArenaBytesPerHtmlByte);
+    if (spare_arena_ && spare_arena_->capacity() >= arena_bytes) {
+        document->arena = std::move(spare_arena_);
+    } else {
+        spare_arena_.reset();
+        document->arena = std::make_unique<ArenaAllocator>(arena_bytes);
+    }
+
+    std::vector<std::string> style_blocks;
+    std::vector<std::string> stylesheet_links;
+    if (!parse_html(html, *document, style_blocks, stylesheet_links, stage_timings) || is_cancelled()) {
+        recycle(std::move(document));
+        return nullptr;
+    }
+    if (!stylesheet_links.empty()) {
+        HB_LOG_INFO("[pipeline] discovered stylesheet links: " << stylesheet_links.size());
+    }
+
+    const auto style_start = Hummingbird::Core::Clock::now();
+    {
+        Hummingbird::Core::Allocations::StageScope allocation_stage(Hummingbird::Core::Allocations::Stage::Style);
+        auto author_sheets = load_author_stylesheets(style_blocks, stylesheet_links);
+        apply_stylesheets(*document, author_sheets);
+    }
+    stage_timings.style_ms = Hummingbird::Core::duration_ms(style_start, Hummingbird::Core::Clock::now());
+    if (is_cancelled() || !build_render_tree(*document, stage_timings) || is_cancelled()) {
+        recycle(std::move(document));
+        return nullptr;
+    }
+
+    layout_document(*document, scope, stage_timings);
+    HB_LOG_INFO("[pipeline] render tree root children: " << document->render_tree->get_children().size());
+    stage_timings.allocations = Hummingbird::Core::Allocations::thread_snapshot() - allocations_before;
+    return document;
+}
+
+void DocumentPipeline::recycle(std::unique_ptr<DocumentSnapshot> document) {
+    if (!document || !document->arena) return;
+    // The render tree points into the DOM, and the DOM lives in the arena: tear down in that order.
+    document->render_tree.reset();
+    document->dom.reset();
+    document->arena->reset();
+    if (!spare_arena_ || document->arena->capacity() > spare_arena_->capacity()) {
+        spare_arena_ = std::move(document->arena);
+    }
+}
+
+bool DocumentPipeline::parse_html(const std::string& html, DocumentSnapshot& document,
+                                  std::vector<std::string>& style_blocks, std::vector<std::string>& stylesheet_links,
+                                  PipelineTimings& timings) {
+    Hummingbird::Core::Allocations::StageScope allocation_stage(Hummingbird::Core::Allocations::Stage::Parse);
+    const auto parse_start = Hummingbird::Core::Clock::now();
+    Hummingbird::Html::Parser parser(*document.arena, html);
+    auto parse_result = parser.parse();
+    const auto parse_end = Hummingbird::Core::Clock::now();
+    timings.parse_ms = Hummingbird::Core::duration_ms(parse_start, parse_end);
+
+    document.dom = std::move(parse_result.dom);
+    style_blocks = std::move(parse_result.style_blocks);
+    stylesheet_links = std::move(parse_result.stylesheet_links);
+
+    if (!document.dom) {
+        HB_LOG_WARN("[pipeline] parsed empty DOM");
+        return false;
+    }
+
+    HB_LOG_INFO("[pipeline] parsed DOM children: " << document.dom->get_children().size()
+                                                   << " total nodes: " << count_nodes_recursive(document.dom.get()));
+    HB_LOG_INFO("[perf] html parse ms=" << timings.parse_ms);
+    return true;
+}
+
+std::vector<std::shared_ptr<const Hummingbird::Css::Stylesheet>> DocumentPipeline::load_author_stylesheets(
+    const std::vector<std::string>& style_blocks, const std::vector<std::string>& stylesheet_links) {
+    const auto css_parse_start = Hummingbird::Core::Clock::now();
+    std::vector<std::shared_ptr<const Hummingbird::Css::Stylesheet>> sheets;
+    sheets.reserve(stylesheet_links.size() + style_blocks.size());
+
+    if (resources_) {
+        for (const auto& href : stylesheet_links) {
+            auto view = resources_->map_resource(href);
+            if (!view) {
+                HB_LOG_WARN("[resource] missing stylesheet: " << href);
+                continue;
+            }
+            sheets.push_back(stylesheet_cache_->get_or_parse(href, view->bytes));
+        }
+    }
+    for (const auto& block : style_blocks) {
+        sheets.push_back(stylesheet_cache_->get_or_parse({}, block));
+    }
+
+    const auto css_parse_end = Hummingbird::Core::Clock::now();
+    HB_LOG_INFO("[perf] css parse ms=" << Hummingbird::Core::duration_ms(css_parse_start, css_parse_end)
+                                       << " sheets=" << sheets.size()
+                                       << " cached parses=" << stylesheet_cache_->parse_count());
+    return sheets;
+}
+
+void DocumentPipeline::apply_stylesheets(
+    DocumentSnapshot& document,
+    const std::vector<std::shared_ptr<const Hummingbird::Css::Stylesheet>>& author_sheets) {
+    std::vector<Hummingbird::Css::CascadeSheet> cascade;
+    cascade.reserve(author_sheets.size() + 1);
+    cascade.push_back({ua_stylesheet_.get(), Hummingbird::Css::Origin::UserAgent});
+    size_t rule_count = ua_stylesheet_ ? ua_stylesheet_->rules.size() : 0;
+    for (const auto& sheet : author_sheets) {
+        cascade.push_back({sheet.get(), Hummingbird::Css::Origin::Author});
+        rule_count += sheet->rules.size();
+    }
+
+    const auto style_start = Hummingbird::Core::Clock::now();
+    style_engine_.apply(cascade, document.dom.get());
+    const auto style_end = Hummingbird::Core::Clock::now();
+    HB_LOG_INFO("[pipeline] applied stylesheet rules: " << rule_count);
+    HB_LOG_INFO("[perf] style apply ms=" << Hummingbird::Core::duration_ms(style_start, style_end));
+}
+
+bool DocumentPipeline::build_render_tree(DocumentSnapshot& document, PipelineTimings& timings) {
+    Hummingbird::Core::Allocations::StageScope allocation_stage(Hummingbird::Core::Allocations::Stage::TreeBuild);
+    const auto render_start = Hummingbird::Core::Clock::now();
+    document.render_tree = tree_builder_.build(document.dom.get());
+    const auto render_end = Hummingbird::Core::Clock::now();
+    timings.tree_ms = Hummingbird::Core::duration_ms(render_start, render_end);
+    if (!document.render_tree) {
+        HB_LOG_WARN("[pipeline] render tree build skipped");
+        return false;
+    }
+    HB_LOG_INFO("[perf] render tree build ms=" << timings.tree_ms);
+    return true;
+}
+
+void DocumentPipeline::layout_document(DocumentSnapshot& document, LayoutScope scope, PipelineTimings& timings) {
+    Hummingbird::Core::Allocations::StageScope allocation_stage(Hummingbird::Core::Allocations::Stage::Layout);
+    const auto layout_start = Hummingbird::Core::Clock::now();
+    if (scope == LayoutScope::Viewport) {
+        Hummingbird::Layout::ProgressiveLayout progressive;
+        progressive.layout_viewport(*document.render_tree, graphics_, document.viewport, 0.0f);
+    } else {
+        document.render_tree->layout(graphics_, document.viewport);
+    }
+    const auto layout_end = Hummingbird::Core::Clock::now();
+    timings.layout_ms = Hummingbird::Core::duration_ms(layout_start, layout_end);
+    HB_LOG_INFO("[perf] layout ms=" << timings.layout_ms << " viewport=" << document.viewport.width << "x"
+                                    << document.viewport.height
+                                    << (scope == LayoutScope::Viewport ? " (viewport)" : " (full)"));
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/ArenaAllocator.h"
+#include "core/platform_api/IGraphicsContext.h"
+#include "core/platform_api/IResourceProvider.h"
+#include "core/utils/AllocationStats.h"
+#include "layout/Geometry.h"
+#include "layout/TreeBuilder.h"
+#include "style/StyleEngine.h"
+#include "style/StylesheetCache.h"
+
+namespace Hummingbird::DOM {
+class Node;
+}
+namespace Hummingbird::Layout {
+class RenderObject;
+}
+
+// A parsed, styled and laid-out document. Whoever builds it owns it outright; the interactive app builds it on the
+// layout thread and hands it over whole, after which the main thread may keep laying it out (resizes, progressive
+// layout).
+struct DocumentSnapshot {
+    uint64_t nav_id = 0;
+    // Declared first so it is destroyed last: the DOM nodes live in it.
+    std::unique_ptr<ArenaAllocator> arena;
+    ArenaPtr<Hummingbird::DOM::Node> dom;
+    std::unique_ptr<Hummingbird::Layout::RenderObject> render_tree;
+    Hummingbird::Layout::Rect viewport;  // what render_tree was laid out for
+};
+
+// Wall time spent in each pipeline stage of one build.
+struct PipelineTimings {
+    double parse_ms = 0.0;
+    double style_ms = 0.0;  // author stylesheet parsing + cascade
+    double tree_ms = 0.0;
+    double layout_ms = 0.0;
+    // Heap allocations made by the build, by stage; all zero unless the allocation hooks are linked in.
+    Hummingbird::Core::Allocations::Snapshot allocations;
+};
+
+enum class LayoutScope {
+    Viewport,  // lay out what the viewport shows; the rest keeps estimated heights (see ProgressiveLayout)
+    Full,
+};
+
+// parse -> style -> render tree build -> layout for one HTML document. Keeps the style engine, tree builder and
+// stylesheet cache warm across builds, so one instance should be reused, from a single thread at a time. Pipelines on
+// different threads may share the UA stylesheet and a stylesheet cache (which is thread-safe).
+class DocumentPipeline {
+public:
+    DocumentPipeline(IGraphicsContext& graphics, IResourceProvider* resources,
+                     std::shared_ptr<const Hummingbird::Css::Stylesheet> ua_stylesheet,
+                     std::shared_ptr<Hummingbird::Css::StylesheetCache> stylesheet_cache = nullptr);
+
+    // Parses the user-agent stylesheet from the resource provider, falling back to a built-in minimal sheet.
+    static std::shared_ptr<const Hummingbird::Css::Stylesheet> load_ua_stylesheet(IResourceProvider* resources);
+
+    // Returns nullptr for an empty document, or when |cancelled| returns true between stages. May throw
+    // std::bad_alloc when the document does not fit its arena.
+    std::unique_ptr<DocumentSnapshot> build(uint64_t nav_id, const std::string& html,
+                                            const Hummingbird::Layout::Rect& viewport, LayoutScope scope,
+                                            const std::function<bool()>& cancelled = {},
+                                            PipelineTimings* timings = nullptr);
+
+    // Takes back a document the caller is done with. Its arena is reset and handed to the next build() that fits,
+    // so a long-running pipeline stops allocating (and page-faulting in) a fresh arena per document.
+    void recycle(std::unique_ptr<DocumentSnapshot> document);
+
+private:
+    bool parse_html(const std::string& html, DocumentSnapshot& document, std::vector<std::string>& style_blocks,
+                    std::vector<std::string>& stylesheet_links, PipelineTimings& timings);
+    std::vector<std::shared_ptr<const Hummingbird::Css::Stylesheet>> load_author_stylesheets(
+        const std::vector<std::string>& style_blocks, const std::vector<std::string>& stylesheet_links);
+    void apply_stylesheets(DocumentSnapshot& document,
+                           const std::vector<std::shared_ptr<const Hummingbird::Css::Stylesheet>>& author_sheets);
+    bool build_render_tree(DocumentSnapshot& document, PipelineTimings& timings);
+    void layout_document(DocumentSnapshot& document, LayoutScope scope, PipelineTimings& timings);
+
+    IGraphicsContext& graphics_;
+    IResourceProvider* resources_;
+    std::shared_ptr<const Hummingbird::Css::Stylesheet> ua_stylesheet_;
+    Hummingbird::Css::StyleEngine style_engine_;
+    std::shared_ptr<Hummingbird::Css::StylesheetCache> stylesheet_cache_;
+    Hummingbird::Layout::TreeBuilder tree_builder_;
+    std::unique_ptr<ArenaAllocator> spare_arena_;
+};
@@ -0,0 +1,148 @@
+#include "app/FrameStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+
+namespace {
+constexpr double kPercentiles[] = {50.0, 95.0, 99.0};
+
+void write_histogram_json(std::ostream& out, const FrameHistogram& histogram) {
+    out << "{\"p50_ms\": " << histogram.percentile(50.0) << ", \"p95_ms\": " << histogram.percentile(95.0)
+        << ", \"p99_ms\": " << histogram.percentile(99.0) << ", \"mean_ms\": " << histogram.mean_ms()
+        << ", \"max_ms\": " << histogram.max_ms() << "}";
+}
+}  // namespace
+
+const char* frame_phase_name(FramePhase phase) {
+    switch (phase) {
+        case FramePhase::EventPump:
+            return "event_pump";
+        case FramePhase::Rebuild:
+            return "rebuild";
+        case FramePhase::Layout:
+            return "layout";
+        case FramePhase::Paint:
+            return "paint";
+        case FramePhase::Present:
+            return "present";
+    }
+    return "unknown";
+}
+
+double FrameTimes::total_ms() const {
+    double total = 0.0;
+    for (double ms : phase_ms) {
+        total += ms;
+    }
+    return total;
+}
+
+void FrameHistogram::add(double ms) {
+    ms = std::max(0.0, ms);
+    const auto bucket = static_cast<size_t>(ms / kBucketMs);
+    ++buckets_[std::min(bucket, kBucketCount)];
+    ++count_;
+    sum_ms_ += ms;
+    max_ms_ = std::max(max_ms_, ms);
+}
+
+double FrameHistogram::percentile(double p) const {
+    if (count_ == 0) return 0.0;
+    const auto rank = static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(count_)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets_[i];
+        if (seen >= std::max<uint64_t>(rank, 1)) {
+            return std::min(static_cast<double>(i + 1) * kBucketMs, max_ms_);
+        }
+    }
+    return max_ms_;
+}
+
+FrameStats::Scope::Scope(FrameStats& stats, FramePhase phase) : stats_(stats), enclosing_(stats.active_phase_) {
+    stats_.frame_has_work_ = true;
+    stats_.switch_phase(phase);
+}
+
+FrameStats::Scope::~Scope() {
+    stats_.switch_phase(enclosing_);
+}
+
+void FrameStats::switch_phase(std::optional<FramePhase> next) {
+    const auto now = Hummingbird::Core::Clock::now();
+    if (active_phase_) {
+        current_.phase_ms[static_cast<size_t>(*active_phase_)] += Hummingbird::Core::duration_ms(active_since_, now);
+    }
+    active_phase_ = next;
+    active_since_ = now;
+}
+
+void FrameStats::begin_frame() {
+    current_ = FrameTimes{};
+    frame_has_work_ = false;
+}
+
+void FrameStats::end_frame() {
+    if (frame_has_work_) record_frame(current_);
+    frame_has_work_ = false;
+}
+
+void FrameStats::record_frame(const FrameTimes& frame) {
+    for (size_t i = 0; i < kFramePhaseCount; ++i) {
+        phases_[i].add(frame.phase_ms[i]);
+    }
+    const double total_ms = frame.total_ms();
+    total_.add(total_ms);
+    if (total_ms > kFrameBudgetMs) {
+        ++janky_frames_;
+        missed_vsyncs_ += static_cast<uint64_t>(total_ms / kFrameBudgetMs);
+    }
+}
+
+std::string FrameStats::overlay_text() const {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1) << "frame p50 " << total_.percentile(50.0) << " p95 "
+         << total_.percentile(95.0) << " p99 " << total_.percentile(99.0) << " ms  jank " << janky_frames_ << "/"
+         << frames();
+    return text.str();
+}
+
+void FrameStats::write_report(std::ostream& out) const {
+    out << "frames: " << frames() << ", over " << std::fixed << std::setprecision(1) << kFrameBudgetMs
+        << "ms: " << janky_frames_ << " (" << missed_vsyncs_ << " missed vsyncs)\n";
+    out << std::left << std::setw(12) << "phase";
+    for (double p : kPercentiles) {
+        std::string label = "p";
+        label += std::to_string(static_cast<int>(p));
+        out << std::right << std::setw(8) << label;
+    }
+    out << std::setw(8) << "max" << "\n";
+    auto write_row = [&](const char* name, const FrameHistogram& histogram) {
+        out << std::left << std::setw(12) << name << std::right << std::setprecision(2);
+        for (double p : kPercentiles) {
+            out << std::setw(8) << histogram.percentile(p);
+        }
+        out << std::setw(8) << histogram.max_ms() << "\n";
+    };
+    for (size_t i = 0; i < kFramePhaseCount; ++i) {
+        write_row(frame_phase_name(static_cast<FramePhase>(i)), phases_[i]);
+    }
+    write_row("total", total_);
+}
+
+void FrameStats::write_json(std::ostream& out) const {
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"frames\": " << frames() << ",\n  \"budget_ms\": " << kFrameBudgetMs
+        << ",\n  \"janky_frames\": " << janky_frames_ << ",\n  \"missed_vsyncs\": " << missed_vsyncs_
+        << ",\n  \"total\": ";
+    write_histogram_json(out, total_);
+    out << ",\n  \"phases\": {";
+    for (size_t i = 0; i < kFramePhaseCount; ++i) {
+        out << (i == 0 ? "\n" : ",\n") << "    \"" << frame_phase_name(static_cast<FramePhase>(i)) << "\": ";
+        write_histogram_json(out, phases_[i]);
+    }
+    out << "\n  }\n}\n";
+}
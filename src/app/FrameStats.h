@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string>
+
+#include "core/utils/Timing.h"
+
+// Where the main thread spends a frame. Phases are exclusive: layout started from an event handler counts as
+// Layout, not EventPump.
+enum class FramePhase : uint8_t {
+    EventPump,  // handling input (not the blocking wait for it)
+    Rebuild,    // handing fetched HTML to the layout thread, adopting the document it built
+    Layout,
+    Paint,
+    Present,
+};
+inline constexpr size_t kFramePhaseCount = 5;
+
+const char* frame_phase_name(FramePhase phase);
+
+struct FrameTimes {
+    std::array<double, kFramePhaseCount> phase_ms{};
+
+    double total_ms() const;
+};
+
+// Fixed 0.1ms buckets up to 100ms plus an overflow bucket: percentiles are exact to a bucket, and recording never
+// allocates.
+class FrameHistogram {
+public:
+    void add(double ms);
+
+    uint64_t count() const { return count_; }
+    double max_ms() const { return max_ms_; }
+    double mean_ms() const { return count_ > 0 ? sum_ms_ / static_cast<double>(count_) : 0.0; }
+    // Upper edge of the bucket holding the |p|th percentile (0 < p <= 100), or the exact maximum for samples past the
+    // last bucket. 0 when empty.
+    double percentile(double p) const;
+
+private:
+    static constexpr double kBucketMs = 0.1;
+    static constexpr size_t kBucketCount = 1000;
+
+    std::array<uint32_t, kBucketCount + 1> buckets_{};  // the last one collects everything >= 100ms
+    uint64_t count_ = 0;
+    double sum_ms_ = 0.0;
+    double max_ms_ = 0.0;
+};
+
+// Frame timing for the interactive app. A frame is one BrowserApp::tick; only frames that did work (ran at least one
+// phase) are recorded, so idle ticks waiting for input do not drown out the frames a user sees.
+class FrameStats {
+public:
+    static constexpr double kFrameBudgetMs = 1000.0 / 60.0;
+
+    // Times one phase of the current frame. Nested scopes pause the enclosing one.
+    class Scope {
+    public:
+        Scope(FrameStats& stats, FramePhase phase);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        FrameStats& stats_;
+        std::optional<FramePhase> enclosing_;
+    };
+
+    void begin_frame();
+    void end_frame();
+    // Records a finished frame directly.
+    void record_frame(const FrameTimes& frame);
+
+    uint64_t frames() const { return total_.count(); }
+    // Frames over the 60Hz budget, and the vsync intervals they overran in total.
+    uint64_t janky_frames() const { return janky_frames_; }
+    uint64_t missed_vsyncs() const { return missed_vsyncs_; }
+    const FrameHistogram& total() const { return total_; }
+    const FrameHistogram& phase(FramePhase phase) const { return phases_[static_cast<size_t>(phase)]; }
+
+    // One line for the on-screen overlay.
+    std::string overlay_text() const;
+    void write_report(std::ostream& out) const;
+    void write_json(std::ostream& out) const;
+
+private:
+    void switch_phase(std::optional<FramePhase> next);
+
+    std::array<FrameHistogram, kFramePhaseCount> phases_;
+    FrameHistogram total_;
+    uint64_t janky_frames_ = 0;
+    uint64_t missed_vsyncs_ = 0;
+
+    FrameTimes current_;
+    bool frame_has_work_ = false;
+    std::optional<FramePhase> active_phase_;
+    Hummingbird::Core::Clock::time_point active_since_;
+};
@@ -0,0 +1,319 @@
+#include "app/HeadlessBatch.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include "app/BatchRenderer.h"
+#include "core/platform_api/INetwork.h"
+#include "core/platform_api/NetworkFactory.h"
+#include "core/platform_api/ResourceProviderFactory.h"
+#include "core/utils/AllocationStats.h"
+#include "core/utils/Log.h"
+#include "core/utils/Timing.h"
+#include "core/utils/Trace.h"
+
+namespace {
+constexpr std::chrono::seconds kFetchTimeout{30};
+constexpr int kMaxDimension = 16384;
+constexpr int kMaxJobs = 1024;
+
+std::optional<std::string> read_file(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return std::nullopt;
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    return std::move(contents).str();
+}
+
+void append_json_string(std::ostream& out, std::string_view value) {
+    out << '"';
+    for (char c : value) {
+        switch (c) {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            case '\t':
+                out << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec
+                        << std::setfill(' ');
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+void append_allocations_json(std::ostream& out, const Hummingbird::Core::Allocations::Snapshot& allocations) {
+    out << "{";
+    for (size_t i = 0; i < Hummingbird::Core::Allocations::kStageCount; ++i) {
+        const auto stage = static_cast<Hummingbird::Core::Allocations::Stage>(i);
+        out << (i == 0 ? "" : ", ") << '"' << Hummingbird::Core::Allocations::stage_name(stage)
+            << "\": {\"count\": " << allocations[stage].count << ", \"bytes\": " << allocations[stage].bytes << "}";
+    }
+    out << "}";
+}
+
+bool write_timings_json(const std::filesystem::path& path, const HeadlessOptions& options,
+                        size_t worker_count, const std::vector<BatchDocumentResult>& results, double wall_ms) {
+    size_t rendered = 0;
+    double render_ms = 0.0;
+    for (const auto& result : results) {
+        if (!result.ok) continue;
+        ++rendered;
+        render_ms += result.render_ms();
+    }
+
+    std::ofstream out(path);
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"width\": " << options.width << ",\n  \"height\": " << options.height
+        << ",\n  \"threads\": " << worker_count << ",\n  \"raster_threads\": " << options.raster_threads << ",\n";
+    out << "  \"documents\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"input\": ";
+        append_json_string(out, result.input);
+        out << ", \"ok\": " << (result.ok ? "true" : "false");
+        if (!result.ok) {
+            out << ", \"error\": ";
+            append_json_string(out, result.error);
+        }
+        if (!result.output.empty()) {
+            out << ", \"output\": ";
+            append_json_string(out, result.output.string());
+        }
+        out << ", \"worker\": " << result.worker << ", \"load_ms\": " << result.load_ms
+            << ", \"parse_ms\": " << result.pipeline.parse_ms << ", \"style_ms\": " << result.pipeline.style_ms
+            << ", \"tree_ms\": " << result.pipeline.tree_ms
+            << ", \"layout_ms\": " << result.pipeline.layout_ms << ", \"paint_ms\": " << result.paint_ms
+            << ", \"encode_ms\": " << result.encode_ms << ", \"render_ms\": " << result.render_ms();
+        if (Hummingbird::Core::Allocations::hooks_installed()) {
+            out << ", \"allocations\": ";
+            append_allocations_json(out, result.allocations);
+        }
+        out << "}";
+    }
+    out << "\n  ],\n";
+    out << "  \"summary\": {\"documents\": " << results.size() << ", \"rendered\": " << rendered
+        << ", \"wall_ms\": " << wall_ms << ", \"render_ms\": " << render_ms
+        << ", \"pages_per_second\": " << (wall_ms > 0.0 ? rendered * 1000.0 / wall_ms : 0.0)
+        << ", \"pages_per_second_per_core\": " << (render_ms > 0.0 ? rendered * 1000.0 / render_ms : 0.0) << "}\n";
+    out << "}\n";
+    return static_cast<bool>(out);
+}
+
+std::optional<int> parse_dimension(std::string_view text) {
+    int value = 0;
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc() || end != text.data() + text.size() || value <= 0 || value > kMaxDimension) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+bool append_list_file(const std::filesystem::path& path, std::vector<std::string>& inputs) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) line.pop_back();
+        size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line[start] == '#') continue;
+        inputs.push_back(line.substr(start));
+    }
+    return true;
+}
+
+void print_usage() {
+    std::cerr << "usage: Hummingbird --headless [--width N] [--height N] [--jobs N] [--raster-threads N] [--out DIR] "
+                 "[--timings FILE] [--trace FILE] [--no-png] INPUT... [@LIST]...\n";
+}
+
+// Reads local files, fetches http(s) URLs. Safe to call from every batch worker at once.
+class InputLoader {
+public:
+    explicit InputLoader(const std::vector<std::string>& inputs) {
+        for (const auto& input : inputs) {
+            if (is_url_input(input)) {
+                network_ = create_network(NetworkBackend::Curl);
+                break;
+            }
+        }
+    }
+
+    ~InputLoader() {
+        if (network_) network_->shutdown();
+    }
+
+    std::optional<std::string> load(const std::string& input) {
+        return is_url_input(input) ? fetch(input) : read_file(input);
+    }
+
+private:
+    std::optional<std::string> fetch(const std::string& url) {
+        if (!network_) return std::nullopt;
+
+        // Shared with the callback, which may still run after a timeout.
+        auto body = std::make_shared<std::promise<std::string>>();
+        auto ready = body->get_future();
+        network_->get(url, [body](std::string fetched) { body->set_value(std::move(fetched)); });
+        if (ready.wait_for(kFetchTimeout) != std::future_status::ready) {
+            HB_LOG_WARN("[headless] timed out fetching " << url);
+            return std::nullopt;
+        }
+        auto html = ready.get();
+        if (html.empty()) return std::nullopt;
+        return html;
+    }
+
+    NetworkPtr network_;  // only when some input is a URL
+};
+}  // namespace
+
+std::optional<uint32_t> parse_raster_threads(std::string_view text) {
+    uint32_t value = 0;
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (text.empty() || ec != std::errc() || end != text.data() + text.size() || value > kMaxRasterThreads) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+bool is_headless_invocation(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view(argv[i]) == "--headless") return true;
+    }
+    return false;
+}
+
+std::optional<HeadlessOptions> parse_headless_args(int argc, char* argv[]) {
+    HeadlessOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--headless") {
+            continue;
+        } else if (arg == "--no-png") {
+            options.write_png = false;
+        } else if ((arg == "--width" || arg == "--height") && has_value) {
+            auto value = parse_dimension(argv[++i]);
+            if (!value) {
+                std::cerr << "invalid " << arg << ": " << argv[i] << "\n";
+                print_usage();
+                return std::nullopt;
+            }
+            (arg == "--width" ? options.width : options.height) = *value;
+        } else if (arg == "--jobs" && has_value) {
+            auto value = parse_dimension(argv[++i]);
+            if (!value || *value > kMaxJobs) {
+                std::cerr << "invalid --jobs: " << argv[i] << "\n";
+                print_usage();
+                return std::nullopt;
+            }
+            options.jobs = static_cast<size_t>(*value);
+        } else if (arg == "--raster-threads" && has_value) {
+            auto value = parse_raster_threads(argv[++i]);
+            if (!value) {
+                std::cerr << "invalid --raster-threads: " << argv[i] << "\n";
+                print_usage();
+                return std::nullopt;
+            }
+            options.raster_threads = *value;
+        } else if (arg == "--out" && has_value) {
+            options.output_dir = argv[++i];
+        } else if (arg == "--timings" && has_value) {
+            options.timings_path = argv[++i];
+        } else if (arg == "--trace" && has_value) {
+            options.trace_path = argv[++i];
+        } else if (arg.starts_with("@")) {
+            if (!append_list_file(std::filesystem::path(arg.substr(1)), options.inputs)) {
+                std::cerr << "cannot read input list: " << arg.substr(1) << "\n";
+                return std::nullopt;
+            }
+        } else if (arg.starts_with("--")) {
+            std::cerr << "unknown or incomplete option: " << arg << "\n";
+            print_usage();
+            return std::nullopt;
+        } else {
+            options.inputs.emplace_back(arg);
+        }
+    }
+    if (options.inputs.empty()) {
+        print_usage();
+        return std::nullopt;
+    }
+    return options;
+}
+
+int run_headless_batch(const HeadlessOptions& options) {
+    if (options.write_png) {
+        std::error_code ec;
+        std::filesystem::create_directories(options.output_dir, ec);
+        if (ec) {
+            std::cerr << "cannot create output directory " << options.output_dir << ": " << ec.message() << "\n";
+            return 1;
+        }
+    }
+
+    BatchSettings settings;
+    settings.width = options.width;
+    settings.height = options.height;
+    settings.worker_count = options.jobs > 0 ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+    settings.worker_count = std::min(settings.worker_count, options.inputs.size());
+    settings.raster_threads = options.raster_threads;
+    settings.output_dir = options.output_dir;
+    settings.write_png = options.write_png;
+
+    auto resources = create_resource_provider();
+    InputLoader loader(options.inputs);
+    BatchRenderer renderer(settings, resources.get());
+
+    if (!options.trace_path.empty()) Hummingbird::Core::Trace::start();
+    const auto wall_start = Hummingbird::Core::Clock::now();
+    auto results = renderer.render(options.inputs, [&loader](const std::string& input) { return loader.load(input); });
+    const double wall_ms = Hummingbird::Core::duration_ms(wall_start, Hummingbird::Core::Clock::now());
+    if (!options.trace_path.empty()) {
+        Hummingbird::Core::Trace::stop();
+        if (!Hummingbird::Core::Trace::write_chrome_json(options.trace_path)) {
+            std::cerr << "cannot write trace to " << options.trace_path << "\n";
+        }
+    }
+
+    size_t failed = 0;
+    for (const auto& result : results) {
+        if (result.ok) continue;
+        ++failed;
+        std::cerr << "failed: " << result.input << " (" << result.error << ")\n";
+    }
+
+    const size_t rendered = results.size() - failed;
+    std::cout << "rendered " << rendered << "/" << results.size() << " documents in " << std::fixed
+              << std::setprecision(1) << wall_ms << " ms with " << settings.worker_count << " workers ("
+              << (wall_ms > 0.0 ? rendered * 1000.0 / wall_ms : 0.0) << " pages/s)\n";
+
+    if (!options.timings_path.empty() &&
+        !write_timings_json(options.timings_path, options, settings.worker_count, results, wall_ms)) {
+        std::cerr << "cannot write timings to " << options.timings_path << "\n";
+        return 1;
+    }
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Command line batch mode: renders each input (a local HTML file or an http(s) URL) into a PNG without opening a
+// window, on --jobs workers (default: one per hardware thread), and optionally writes per-stage timings as JSON.
+// --raster-threads gives each worker's rasterizer that many threads of its own, for few documents on many cores.
+//
+//   Hummingbird --headless [--width N] [--height N] [--jobs N] [--raster-threads N] [--out DIR] [--timings FILE]
+//               [--trace FILE] [--no-png] INPUT... [@LIST]...
+//
+// @LIST names a text file with one input per line; blank lines and lines starting with '#' are ignored.
+struct HeadlessOptions {
+    int width = 1024;
+    int height = 768;
+    size_t jobs = 0;              // 0: one worker per hardware thread
+    uint32_t raster_threads = 0;  // 0: each worker rasterizes on its own thread
+    std::filesystem::path output_dir = ".";
+    std::filesystem::path timings_path;  // empty: no JSON
+    std::filesystem::path trace_path;    // Chrome trace-event JSON of the run (see core/utils/Trace.h)
+    bool write_png = true;               // --no-png still encodes, so encode cost stays in the timings
+    std::vector<std::string> inputs;
+};
+
+// Upper bound on Blend2D raster threads, for both --raster-threads and HB_RASTER_THREADS.
+constexpr uint32_t kMaxRasterThreads = 64;
+
+// A raster thread count from 0 to kMaxRasterThreads, or nullopt when |text| is anything else.
+std::optional<uint32_t> parse_raster_threads(std::string_view text);
+
+bool is_headless_invocation(int argc, char* argv[]);
+
+// Returns nullopt (after printing usage to stderr) when the arguments are malformed or name no input.
+std::optional<HeadlessOptions> parse_headless_args(int argc, char* argv[]);
+
+// Returns the process exit code: 0 when every input rendered, 1 otherwise.
+int run_headless_batch(const HeadlessOptions& options);
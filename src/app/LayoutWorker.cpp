@@ -0,0 +1,85 @@
+#include "app/LayoutWorker.h"
+
+#include <new>
+#include <sstream>
+#include <utility>
+
+#include "core/utils/Log.h"
+
+// Include concrete definitions:
+#include "core/utils/Trace.h"
+#include "layout/RenderObject.h"
+
+LayoutWorker::LayoutWorker(IGraphicsContext& graphics, IResourceProvider* resources,
+                           std::shared_ptr<const Hummingbird::Css::Stylesheet> ua_stylesheet,
+                           const std::atomic<uint64_t>& active_nav)
+    : active_nav_(active_nav),
+      pipeline_(graphics, resources, std::move(ua_stylesheet)),
+      thread_([this] { run(); }) {}
+
+LayoutWorker::~LayoutWorker() {
+    stop();
+}
+
+void LayoutWorker::stop() {
+    {
+        std::lock_guard<std::mutex> lg(mutex_);
+        stopping_ = true;
+        pending_job_.reset();
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) thread_.join();
+}
+
+void LayoutWorker::submit(uint64_t nav_id, std::string html, const Hummingbird::Layout::Rect& viewport) {
+    {
+        std::lock_guard<std::mutex> lg(mutex_);
+        if (stopping_) return;
+        // Replaces any job that has not started yet; a running one notices it went stale at its next stage.
+        pending_job_ = Job{nav_id, std::move(html), viewport};
+    }
+    wake_.notify_one();
+}
+
+std::unique_ptr<DocumentSnapshot> LayoutWorker::take_ready() {
+    std::lock_guard<std::mutex> lg(mutex_);
+    return std::move(ready_);
+}
+
+void LayoutWorker::run() {
+    HB_TRACE_THREAD_NAME("layout");
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || pending_job_.has_value(); });
+            if (stopping_) return;
+            job = std::move(*pending_job_);
+            pending_job_.reset();
+        }
+
+        std::unique_ptr<DocumentSnapshot> document;
+        PipelineTimings timings;
+        try {
+            document = pipeline_.build(job.nav_id, job.html, job.viewport, LayoutScope::Viewport,
+                                       [this, &job] { return is_stale(job); }, &timings);
+        } catch (const std::bad_alloc&) {
+            HB_LOG_ERROR("[pipeline] out of memory building document, html size: " << job.html.size());
+        }
+        if (!document) continue;
+        if (Hummingbird::Core::Allocations::hooks_installed()) {
+            std::ostringstream summary;
+            Hummingbird::Core::Allocations::write_summary(summary, timings.allocations);
+            HB_LOG_INFO("[alloc] nav=" << job.nav_id << " " << summary.str());
+        }
+
+        std::lock_guard<std::mutex> lg(mutex_);
+        ready_ = std::move(document);  // an unclaimed older document is dropped here, off the main thread's path
+    }
+}
+
+bool LayoutWorker::is_stale(const Job& job) const {
+    if (job.nav_id == active_nav_.load(std::memory_order_relaxed)) return false;
+    HB_LOG_INFO("[pipeline] dropping stale navigation " << job.nav_id);
+    return true;
+}
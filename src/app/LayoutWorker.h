@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "app/DocumentPipeline.h"
+#include "core/platform_api/IGraphicsContext.h"
+#include "core/platform_api/IResourceProvider.h"
+#include "layout/Geometry.h"
+
+// Runs parse -> style -> render tree build -> layout on a background thread, one document at a time. Only the newest
+// submitted job is kept; a job is dropped between stages as soon as its navigation id is no longer the active one.
+//
+// Layout measures text through |graphics| from the worker thread, so IGraphicsContext::measure_text must not touch
+// renderer state.
+class LayoutWorker {
+public:
+    LayoutWorker(IGraphicsContext& graphics, IResourceProvider* resources,
+                 std::shared_ptr<const Hummingbird::Css::Stylesheet> ua_stylesheet,
+                 const std::atomic<uint64_t>& active_nav);
+    ~LayoutWorker();
+
+    void submit(uint64_t nav_id, std::string html, const Hummingbird::Layout::Rect& viewport);
+    // The newest finished document, if one arrived since the last call.
+    std::unique_ptr<DocumentSnapshot> take_ready();
+    // Stops and joins the thread; safe to call more than once.
+    void stop();
+
+private:
+    struct Job {
+        uint64_t nav_id = 0;
+        std::string html;
+        Hummingbird::Layout::Rect viewport;
+    };
+
+    void run();
+    bool is_stale(const Job& job) const;
+
+    const std::atomic<uint64_t>& active_nav_;
+    DocumentPipeline pipeline_;  // touched only by the worker thread
+
+    // Handoff with the main thread.
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::optional<Job> pending_job_;
+    std::unique_ptr<DocumentSnapshot> ready_;
+    bool stopping_ = false;
+    std::thread thread_;  // started last, after everything it uses
+};
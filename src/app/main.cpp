@@ -1,11 +1,41 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
 #include <memory>
+#include <string_view>
+#include <thread>
 
 #include "app/BrowserApp.h"
+#include "app/HeadlessBatch.h"
 #include "core/platform_api/IWindow.h"
 #include "core/platform_api/WindowFactory.h"
+#include "core/utils/Log.h"
+#include "core/utils/Trace.h"
 
-int main(int /*argc*/, char* /*argv*/[]) {
-    auto window = create_window();
+int main(int argc, char* argv[]) {
+    if (is_headless_invocation(argc, argv)) {
+        auto options = parse_headless_args(argc, argv);
+        return options ? run_headless_batch(*options) : 2;
+    }
+
+    // HB_RASTER=software: paint each frame with Blend2D on HB_RASTER_THREADS worker threads (default: one per hardware
+    // thread, at most kMaxRasterThreads) and upload it once, instead of drawing through SDL_Renderer. For machines
+    // without a GPU.
+    WindowOptions window_options;
+    if (const char* raster = std::getenv("HB_RASTER"); raster && std::string_view(raster) == "software") {
+        window_options.raster = RasterBackend::Software;
+        window_options.raster_threads = std::min(std::thread::hardware_concurrency(), kMaxRasterThreads);
+        if (const char* threads = std::getenv("HB_RASTER_THREADS")) {
+            if (auto value = parse_raster_threads(threads)) {
+                window_options.raster_threads = *value;
+            } else {
+                HB_LOG_WARN("[raster] ignoring HB_RASTER_THREADS='" << threads << "', expected 0 to "
+                                                                    << kMaxRasterThreads);
+            }
+        }
+    }
+
+    auto window = create_window(window_options);
     window->open();
 
     if (!window->is_open()) return 1;
@@ -13,12 +43,31 @@ int main(int /*argc*/, char* /*argv*/[]) {
     auto gfx = window->get_graphics_context();
     if (!gfx) return 1;
 
-    BrowserApp app(std::move(window));
-    app.start();  // initial navigation + initial UI focus
+    // HB_TRACE=<file>: record the whole session and write it as Chrome trace-event JSON on exit.
+    const char* trace_path = std::getenv("HB_TRACE");
+    if (trace_path) {
+        Hummingbird::Core::Trace::set_thread_name("main");
+        Hummingbird::Core::Trace::start();
+    }
+
+    {
+        BrowserApp app(std::move(window));
+        // HB_FRAME_STATS=<file>: write frame timing percentiles and jank counts as JSON on exit.
+        if (const char* frame_stats_path = std::getenv("HB_FRAME_STATS")) {
+            app.set_frame_stats_path(frame_stats_path);
+        }
+        app.start();  // initial navigation + initial UI focus
 
-    while (app.tick()) {  // one “frame”
-        // nothing here
+        while (app.tick()) {  // one “frame”
+            // nothing here
+        }
     }
 
+    if (trace_path) {
+        Hummingbird::Core::Trace::stop();
+        if (!Hummingbird::Core::Trace::write_chrome_json(std::filesystem::path(trace_path))) {
+            std::cerr << "cannot write trace to " << trace_path << "\n";
+        }
+    }
     return 0;
 }
@@ -17,6 +17,9 @@ public:
     // No deallocation of individual objects, only reset the whole arena
     void reset();
 
+    // Total bytes the arena can hand out; unchanged by reset(), so an arena can be recycled across documents.
+    size_t capacity() const { return m_buffer.size(); }
+
 private:
     std::vector<char> m_buffer;
     size_t m_offset;
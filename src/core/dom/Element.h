@@ -1,8 +1,10 @@
 #pragma once
 
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "core/dom/Node.h"
 
@@ -17,10 +19,25 @@ public:
     const std::string& get_tag_name() const { return m_tag_name; }
     const std::unordered_map<std::string, std::string>& get_attributes() const { return m_attributes; }
 
+    // Attribute change on an element that has already been styled, kept until the next incremental restyle
+    // (StyleEngine::restyle) turns it into invalidations. Unstyled elements don't record anything.
+    struct AttributeMutation {
+        std::string name;
+        std::optional<std::string> old_value;  // nullopt if the attribute was newly added
+    };
+
     void set_attribute(std::string_view key, std::string_view value) {
+        auto it = m_attributes.find(std::string(key));
+        if (it != m_attributes.end() && it->second == value) return;
+        if (m_computed_style) {
+            record_mutation(key, it != m_attributes.end() ? std::optional<std::string>(it->second) : std::nullopt);
+        }
         m_attributes[std::string(key)] = std::string(value);
     }
 
+    const std::vector<AttributeMutation>& get_pending_mutations() const { return m_pending_mutations; }
+    void clear_pending_mutations() { m_pending_mutations.clear(); }
+
 private:
     template <typename T, typename... Args>
     // Allow arena_new to invoke the private constructor while keeping creation centralized.
@@ -28,8 +45,14 @@ private:
 
     explicit Element(std::string_view tag_name) : m_tag_name(tag_name) {}
 
+    void record_mutation(std::string_view key, std::optional<std::string> old_value) {
+        m_pending_mutations.push_back({std::string(key), std::move(old_value)});
+        mark_ancestors_for_restyle();
+    }
+
     std::string m_tag_name;
     std::unordered_map<std::string, std::string> m_attributes;
+    std::vector<AttributeMutation> m_pending_mutations;
 };
 
 }  // namespace Hummingbird::DOM
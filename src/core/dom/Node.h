@@ -36,12 +36,33 @@ public:
     void set_computed_style(std::shared_ptr<Css::ComputedStyle> style) { m_computed_style = std::move(style); }
     std::shared_ptr<const Css::ComputedStyle> get_computed_style() const { return m_computed_style; }
 
+    // Incremental restyle bookkeeping: a node needs restyle when its own inputs changed; ancestors are flagged so
+    // the restyle pass only descends into subtrees that contain such nodes.
+    void mark_for_restyle() {
+        m_needs_restyle = true;
+        mark_ancestors_for_restyle();
+    }
+    bool needs_restyle() const { return m_needs_restyle; }
+    bool child_needs_restyle() const { return m_child_needs_restyle; }
+    void clear_restyle_flags() {
+        m_needs_restyle = false;
+        m_child_needs_restyle = false;
+    }
+
 protected:
     Node() = default;
 
+    void mark_ancestors_for_restyle() {
+        for (Node* ancestor = m_parent; ancestor && !ancestor->m_child_needs_restyle; ancestor = ancestor->m_parent) {
+            ancestor->m_child_needs_restyle = true;
+        }
+    }
+
     Node* m_parent = nullptr;
     std::vector<ArenaPtr<Node>> m_children;
     std::shared_ptr<Css::ComputedStyle> m_computed_style;
+    bool m_needs_restyle = false;
+    bool m_child_needs_restyle = false;
 };
 
 }  // namespace Hummingbird::DOM
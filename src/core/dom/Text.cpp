@@ -0,0 +1,63 @@
+#include "core/dom/Text.h"
+
+namespace Hummingbird::DOM {
+
+namespace {
+bool is_collapsible_space(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+void push_segment(PreparedText& prepared, size_t begin, size_t end, bool is_space) {
+    prepared.segments.push_back({static_cast<uint32_t>(begin), static_cast<uint32_t>(end - begin), is_space});
+}
+
+// Collapse runs of whitespace to a single space (newlines/tabs included), splitting into word and space segments.
+void prepare_collapsed(std::string_view source, PreparedText& prepared) {
+    prepared.text.reserve(source.size());
+    size_t word_start = 0;
+    bool in_space = false;
+    for (char c : source) {
+        if (!is_collapsible_space(c)) {
+            prepared.text.push_back(c);
+            in_space = false;
+            continue;
+        }
+        if (in_space) continue;
+        if (prepared.text.size() > word_start) push_segment(prepared, word_start, prepared.text.size(), false);
+        prepared.text.push_back(' ');
+        push_segment(prepared, prepared.text.size() - 1, prepared.text.size(), true);
+        word_start = prepared.text.size();
+        in_space = true;
+    }
+    if (prepared.text.size() > word_start) push_segment(prepared, word_start, prepared.text.size(), false);
+}
+
+// Keep the text verbatim; one segment per line (newlines themselves are not part of any segment).
+void prepare_preserved(std::string_view source, PreparedText& prepared) {
+    prepared.text.assign(source);
+    size_t start = 0;
+    while (start < source.size()) {
+        size_t nl = source.find('\n', start);
+        size_t end = nl == std::string_view::npos ? source.size() : nl;
+        push_segment(prepared, start, end, false);
+        if (nl == std::string_view::npos) break;
+        start = nl + 1;
+    }
+}
+}  // namespace
+
+const PreparedText& Text::prepared_text(WhitespaceMode mode) const {
+    if (m_prepared && m_prepared->mode == mode) {
+        return *m_prepared;
+    }
+    m_prepared.emplace();
+    m_prepared->mode = mode;
+    if (mode == WhitespaceMode::Preserve) {
+        prepare_preserved(m_text, *m_prepared);
+    } else {
+        prepare_collapsed(m_text, *m_prepared);
+    }
+    return *m_prepared;
+}
+
+}  // namespace Hummingbird::DOM
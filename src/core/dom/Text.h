@@ -1,12 +1,37 @@
 #pragma once
 
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "core/dom/Node.h"
 
 namespace Hummingbird::DOM {
 
+// How a text node's whitespace is treated when preparing it for layout (derived from the computed white-space).
+enum class WhitespaceMode : uint8_t { Collapse, Preserve };
+
+// A slice of PreparedText::text: a word, a single collapsed space, or (when preserving) a whole line.
+struct TextSegment {
+    uint32_t offset = 0;
+    uint32_t length = 0;
+    bool is_space = false;
+};
+
+// Layout-ready form of a text node: whitespace-collapsed (or preserved) text plus its segment boundaries, so layout
+// can slice string_views instead of re-tokenizing on every pass.
+struct PreparedText {
+    WhitespaceMode mode = WhitespaceMode::Collapse;
+    std::string text;
+    std::vector<TextSegment> segments;
+
+    std::string_view slice(const TextSegment& segment) const {
+        return std::string_view(text).substr(segment.offset, segment.length);
+    }
+};
+
 class Text : public Node {
 public:
     static ArenaPtr<Text> create(ArenaAllocator& arena, std::string_view text) {
@@ -14,7 +39,14 @@ public:
     }
 
     const std::string& get_text() const { return m_text; }
-    void append(std::string_view extra) { m_text.append(extra); }
+    void append(std::string_view extra) {
+        m_text.append(extra);
+        m_prepared.reset();
+    }
+
+    // Returns the text prepared for |mode|, computing it on first use. The result stays valid (and is reused by every
+    // later layout pass) until the text changes or a different mode is requested.
+    const PreparedText& prepared_text(WhitespaceMode mode) const;
 
 private:
     template <typename T, typename... Args>
@@ -24,6 +56,7 @@ private:
     explicit Text(std::string_view text) : m_text(text) {}
 
     std::string m_text;
+    mutable std::optional<PreparedText> m_prepared;
 };
 
 }  // namespace Hummingbird::DOM
@@ -1,12 +1,11 @@
 #pragma once
 
+#include <span>
 #include <string>
+#include <string_view>
 #include <utility>
 
-// Forward declare Rect to break dependency cycle
-namespace Hummingbird::Layout {
-struct Rect;
-}
+#include "layout/Geometry.h"
 
 struct Color {
     unsigned char r, g, b, a;
@@ -26,6 +25,13 @@ struct TextStyle {
     Color color{0, 0, 0, 255};
 };
 
+// One run of a draw_text_runs() batch, positioned like draw_text().
+struct TextRun {
+    std::string_view text;
+    float x = 0;
+    float y = 0;
+};
+
 class IGraphicsContext {
 public:
     virtual ~IGraphicsContext() = default;
@@ -34,6 +40,20 @@ public:
     virtual void clear(const Color& color) = 0;
     virtual void present() = 0;
     virtual void fill_rect(const Hummingbird::Layout::Rect& rect, const Color& color) = 0;
-    virtual TextMetrics measure_text(const std::string& text, const TextStyle& style) = 0;
-    virtual void draw_text(const std::string& text, float x, float y, const TextStyle& style) = 0;
+    // May be called from the layout thread while the main thread draws; must not depend on drawing state.
+    virtual TextMetrics measure_text(std::string_view text, const TextStyle& style) = 0;
+    virtual void draw_text(std::string_view text, float x, float y, const TextStyle& style) = 0;
+
+    // Batched fill_rect() and draw_text() for draws sharing one color or style: the sides of a border, the fragments
+    // of a text box. Equivalent to the single calls in order; backends override them to submit a batch at once.
+    virtual void fill_rects(std::span<const Hummingbird::Layout::Rect> rects, const Color& color) {
+        for (const auto& rect : rects) {
+            fill_rect(rect, color);
+        }
+    }
+    virtual void draw_text_runs(std::span<const TextRun> runs, const TextStyle& style) {
+        for (const auto& run : runs) {
+            draw_text(run.text, run.x, run.y, style);
+        }
+    }
 };
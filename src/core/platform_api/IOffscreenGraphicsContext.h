@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "core/platform_api/IGraphicsContext.h"
+
+// A graphics context that rasterizes into memory instead of a window, for headless rendering.
+class IOffscreenGraphicsContext : public IGraphicsContext {
+public:
+    ~IOffscreenGraphicsContext() override = default;
+
+    virtual std::pair<int, int> get_size() const = 0;
+    // Reallocates the surface; its contents are undefined until the next clear().
+    virtual void resize(int width, int height) = 0;
+    // Encodes what has been drawn so far. Returns an empty buffer on failure.
+    virtual std::vector<uint8_t> encode_png() = 0;
+};
@@ -5,12 +5,22 @@
 #include <string>
 #include <string_view>
 
+// Read-only view of a resource's bytes. |owner| keeps the backing storage (e.g. a file mapping) alive,
+// so |bytes| stays valid for as long as the view (or a copy of it) is held.
+struct ResourceView {
+    std::shared_ptr<const void> owner;
+    std::string_view bytes;
+};
+
 class IResourceProvider {
 public:
     virtual ~IResourceProvider() = default;
 
     // Load a text resource by id/path. Returns nullopt if unavailable.
     virtual std::optional<std::string> load_text(std::string_view resource_id) = 0;
+
+    // Map a resource read-only without copying it. Returns nullopt if unavailable.
+    virtual std::optional<ResourceView> map_resource(std::string_view resource_id) = 0;
 };
 
 using ResourceProviderPtr = std::unique_ptr<IResourceProvider>;
@@ -49,6 +49,7 @@ enum class Key : uint8_t {
     Enter,
     Escape,
     F1,
+    F2,
 };
 
 enum class MouseButton : uint8_t {
@@ -1,6 +1,25 @@
 #pragma once
+#include <cstdint>
 #include <memory>
 
+#include "core/platform_api/IOffscreenGraphicsContext.h"
 #include "core/platform_api/IWindow.h"
 
-std::unique_ptr<IWindow> create_window();
+// How a window's graphics context draws.
+enum class RasterBackend {
+    Renderer,  // SDL_Renderer draw calls, text rasterized into a texture per run
+    Software,  // the whole frame rasterized by Blend2D in memory and uploaded once per frame
+};
+
+struct WindowOptions {
+    RasterBackend raster = RasterBackend::Renderer;
+    uint32_t raster_threads = 0;  // Software: Blend2D worker threads; 0 rasterizes on the drawing thread
+};
+
+std::unique_ptr<IWindow> create_window(const WindowOptions& options = {});
+
+// A window without a display: a fixed-size surface in memory that never produces input events on its own.
+std::unique_ptr<IWindow> create_headless_window(int width, int height);
+// |raster_threads| as in WindowOptions.
+std::unique_ptr<IOffscreenGraphicsContext> create_offscreen_graphics_context(int width, int height,
+                                                                             uint32_t raster_threads = 0);
@@ -0,0 +1,110 @@
+// Replaces the global allocation functions so every operator new is charged to the allocating thread's pipeline stage
+// (see AllocationStats.h). Compiled directly into the executables that opt in (the benchmarks, the allocation tests,
+// and the app and HummingbirdTests with HB_ALLOCATION_STATS=ON), never into a library: linking it changes allocation
+// behavior for the whole process.
+
+#include <cstdlib>
+#include <new>
+
+#include "core/utils/AllocationStats.h"
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+namespace Allocations = Hummingbird::Core::Allocations;
+
+const bool kHooksInstalled = [] {
+    Allocations::detail::mark_hooks_installed();
+    return true;
+}();
+
+// As the standard requires of a replacement operator new: on failure, call the new-handler and retry until it
+// frees memory or gives up (throws, or there is none).
+void call_new_handler() {
+    std::new_handler handler = std::get_new_handler();
+    if (!handler) throw std::bad_alloc();
+    handler();
+}
+
+void* counted_alloc(std::size_t size) {
+    Allocations::detail::note_allocation(size);
+    for (;;) {
+        if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+        call_new_handler();
+    }
+}
+
+void* counted_aligned_alloc(std::size_t size, std::align_val_t align) {
+    Allocations::detail::note_allocation(size);
+    const auto alignment = static_cast<std::size_t>(align);
+    for (;;) {
+#ifdef _WIN32
+        void* ptr = _aligned_malloc(size == 0 ? 1 : size, alignment);
+#else
+        // aligned_alloc wants a size that is a nonzero multiple of the alignment.
+        const std::size_t rounded = ((size == 0 ? 1 : size) + alignment - 1) / alignment * alignment;
+        void* ptr = std::aligned_alloc(alignment, rounded);
+#endif
+        if (ptr) return ptr;
+        call_new_handler();
+    }
+}
+
+void aligned_free(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+}  // namespace
+
+void* operator new(std::size_t size) {
+    return counted_alloc(size);
+}
+
+void* operator new[](std::size_t size) {
+    return counted_alloc(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    return counted_aligned_alloc(size, align);
+}
+
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return counted_aligned_alloc(size, align);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    aligned_free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    aligned_free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    aligned_free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    aligned_free(ptr);
+}
@@ -0,0 +1,107 @@
+#include "core/utils/AllocationStats.h"
+
+#include <atomic>
+#include <iomanip>
+#include <ostream>
+
+namespace Hummingbird::Core::Allocations {
+
+namespace {
+std::atomic<bool> g_hooks_installed{false};
+
+// Plain thread-locals without constructors: operator new may run on a thread before anything else has touched them,
+// and bumping them must never allocate or lock.
+thread_local Stage t_stage = Stage::Other;
+thread_local std::array<Counts, kStageCount> t_counts{};
+}  // namespace
+
+const char* stage_name(Stage stage) {
+    switch (stage) {
+        case Stage::Other:
+            return "other";
+        case Stage::Parse:
+            return "parse";
+        case Stage::Style:
+            return "style";
+        case Stage::TreeBuild:
+            return "tree";
+        case Stage::Layout:
+            return "layout";
+        case Stage::Paint:
+            return "paint";
+    }
+    return "unknown";
+}
+
+Counts Snapshot::total() const {
+    Counts sum;
+    for (const Counts& counts : stages) {
+        sum.count += counts.count;
+        sum.bytes += counts.bytes;
+    }
+    return sum;
+}
+
+Snapshot operator-(const Snapshot& after, const Snapshot& before) {
+    Snapshot delta;
+    for (size_t i = 0; i < kStageCount; ++i) {
+        delta.stages[i].count = after.stages[i].count - before.stages[i].count;
+        delta.stages[i].bytes = after.stages[i].bytes - before.stages[i].bytes;
+    }
+    return delta;
+}
+
+Snapshot& operator+=(Snapshot& into, const Snapshot& other) {
+    for (size_t i = 0; i < kStageCount; ++i) {
+        into.stages[i].count += other.stages[i].count;
+        into.stages[i].bytes += other.stages[i].bytes;
+    }
+    return into;
+}
+
+void write_summary(std::ostream& out, const Snapshot& snapshot) {
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(1);
+    bool first = true;
+    for (size_t i = 0; i < kStageCount; ++i) {
+        const Counts& counts = snapshot.stages[i];
+        if (counts.count == 0) continue;
+        out << (first ? "" : ", ") << stage_name(static_cast<Stage>(i)) << ' ' << counts.count << " ("
+            << static_cast<double>(counts.bytes) / 1024.0 << " KB)";
+        first = false;
+    }
+    if (first) out << "none";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+bool hooks_installed() {
+    return g_hooks_installed.load(std::memory_order_relaxed);
+}
+
+Snapshot thread_snapshot() {
+    return Snapshot{t_counts};
+}
+
+StageScope::StageScope(Stage stage) : m_enclosing(t_stage) {
+    t_stage = stage;
+}
+
+StageScope::~StageScope() {
+    t_stage = m_enclosing;
+}
+
+namespace detail {
+void note_allocation(size_t bytes) {
+    Counts& counts = t_counts[static_cast<size_t>(t_stage)];
+    ++counts.count;
+    counts.bytes += bytes;
+}
+
+void mark_hooks_installed() {
+    g_hooks_installed.store(true, std::memory_order_relaxed);
+}
+}  // namespace detail
+
+}  // namespace Hummingbird::Core::Allocations
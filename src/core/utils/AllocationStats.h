@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// Heap allocation accounting per pipeline stage. The counting itself lives in AllocationHooks.cpp, which replaces the
+// global operator new/delete and is linked only into binaries that opt in (the benchmarks, HummingbirdAllocationTests,
+// and the app and HummingbirdTests when configured with HB_ALLOCATION_STATS=ON). Without it every count stays zero
+// and the stage scopes cost one thread-local store each.
+//
+// Counts are per thread: an allocation is charged to the stage the allocating thread is in, so a navigation's cost
+// is the difference between two thread_snapshot() calls on the thread that built it.
+namespace Hummingbird::Core::Allocations {
+
+enum class Stage : uint8_t {
+    Other,  // outside any stage scope
+    Parse,
+    Style,  // author stylesheet parsing + cascade
+    TreeBuild,
+    Layout,
+    Paint,
+};
+inline constexpr size_t kStageCount = 6;
+
+const char* stage_name(Stage stage);
+
+struct Counts {
+    uint64_t count = 0;
+    uint64_t bytes = 0;  // as requested from operator new
+};
+
+struct Snapshot {
+    std::array<Counts, kStageCount> stages{};
+
+    const Counts& operator[](Stage stage) const { return stages[static_cast<size_t>(stage)]; }
+    Counts total() const;
+};
+
+Snapshot operator-(const Snapshot& after, const Snapshot& before);
+Snapshot& operator+=(Snapshot& into, const Snapshot& other);
+
+// "parse 812 (96.0 KB), style 2301 (180.4 KB), ..." for the stages that allocated.
+void write_summary(std::ostream& out, const Snapshot& snapshot);
+
+// True when the allocation hooks are linked into this binary.
+bool hooks_installed();
+
+// Everything the calling thread has allocated so far, by stage.
+Snapshot thread_snapshot();
+
+// Charges the calling thread's allocations to |stage| until destroyed; nests, restoring the enclosing stage.
+class StageScope {
+public:
+    explicit StageScope(Stage stage);
+    ~StageScope();
+    StageScope(const StageScope&) = delete;
+    StageScope& operator=(const StageScope&) = delete;
+
+private:
+    Stage m_enclosing;
+};
+
+namespace detail {
+// Called by the replaced operator new.
+void note_allocation(size_t bytes);
+void mark_hooks_installed();
+}  // namespace detail
+
+}  // namespace Hummingbird::Core::Allocations
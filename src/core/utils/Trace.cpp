@@ -0,0 +1,226 @@
+#include "core/utils/Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Hummingbird::Core::Trace {
+
+namespace detail {
+std::atomic<bool> g_recording{false};
+}
+
+namespace {
+// 32 bytes per zone: 2MB per ring, and one ring per thread recording at a time.
+constexpr uint64_t kRingCapacity = 1u << 16;
+static_assert((kRingCapacity & (kRingCapacity - 1)) == 0, "ring index masking needs a power of two");
+
+struct Event {
+    const char* category;
+    const char* name;
+    uint64_t start_ns;
+    uint64_t end_ns;
+};
+
+// A thread that used a ring, from the first event it recorded. Rings are reused once their thread exits, so one ring
+// can hold the events of several threads in turn.
+struct RingOwner {
+    uint64_t first_event;
+    uint32_t tid;
+    std::string name;
+};
+
+// Single producer (the owning thread), read by the exporter. The producer publishes each event by advancing |head|
+// with release semantics; the exporter reads the last kRingCapacity events below an acquired |head|.
+struct ThreadRing {
+    ThreadRing() : events(kRingCapacity) {}
+
+    std::vector<Event> events;
+    std::atomic<uint64_t> head{0};
+    // Events below this index were cleared; only touched by clear() and the exporter, under the registry mutex.
+    uint64_t first_live = 0;
+    std::vector<RingOwner> owners;  // in event order; guarded by the registry mutex
+};
+
+// Rings are never freed, so a thread's zones survive the thread and exporting never races a thread exiting. A ring
+// goes back on the free list when its thread exits, so short-lived threads (one per fetch, per batch call) share a
+// few rings instead of adding one each.
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+    std::vector<ThreadRing*> free_rings;
+    uint32_t next_tid = 1;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+const std::chrono::steady_clock::time_point kEpoch = std::chrono::steady_clock::now();
+
+// Hands the thread's ring back when the thread exits. Thread-local destructors run before static ones, so the
+// registry is still alive.
+struct RingLease {
+    ThreadRing* ring = nullptr;
+
+    ~RingLease() {
+        if (!ring) return;
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        reg.free_rings.push_back(ring);
+    }
+};
+
+thread_local RingLease t_lease;
+thread_local std::string t_thread_name;  // kept here until the thread first records
+
+// Drops owners whose events are all cleared or overwritten, keeping the newest.
+void prune_owners(ThreadRing& ring) {
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+    const uint64_t oldest = std::max(ring.first_live, head > kRingCapacity ? head - kRingCapacity : 0);
+    size_t dead = 0;
+    while (dead + 1 < ring.owners.size() && ring.owners[dead + 1].first_event <= oldest) ++dead;
+    ring.owners.erase(ring.owners.begin(), ring.owners.begin() + static_cast<std::ptrdiff_t>(dead));
+}
+
+ThreadRing& thread_ring() {
+    if (!t_lease.ring) {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        ThreadRing* ring = nullptr;
+        if (!reg.free_rings.empty()) {
+            ring = reg.free_rings.back();
+            reg.free_rings.pop_back();
+            prune_owners(*ring);
+        } else {
+            reg.rings.push_back(std::make_unique<ThreadRing>());
+            ring = reg.rings.back().get();
+        }
+        ring->owners.push_back({ring->head.load(std::memory_order_relaxed), reg.next_tid++, t_thread_name});
+        t_lease.ring = ring;
+    }
+    return *t_lease.ring;
+}
+
+void write_json_string(std::ostream& out, std::string_view text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << ' ';
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+// Trace-event timestamps are microseconds; keep nanosecond precision.
+void write_microseconds(std::ostream& out, uint64_t ns) {
+    const char fill = out.fill('0');
+    out << ns / 1000 << '.' << std::setw(3) << ns % 1000;
+    out.fill(fill);
+}
+}  // namespace
+
+size_t detail::ring_count() {
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    return reg.rings.size();
+}
+
+void start() {
+    detail::g_recording.store(true, std::memory_order_relaxed);
+}
+
+void stop() {
+    detail::g_recording.store(false, std::memory_order_relaxed);
+}
+
+void clear() {
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    for (auto& ring : reg.rings) {
+        ring->first_live = ring->head.load(std::memory_order_acquire);
+        prune_owners(*ring);
+    }
+}
+
+uint64_t now_ns() {
+    // +1 keeps a zone opened at the epoch distinguishable from "not recording" (0) in Zone.
+    return static_cast<uint64_t>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - kEpoch)
+                   .count()) +
+           1;
+}
+
+void record(const char* category, const char* name, uint64_t start_ns, uint64_t end_ns) {
+    ThreadRing& ring = thread_ring();
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+    ring.events[head & (kRingCapacity - 1)] = Event{category, name, start_ns, end_ns};
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+void set_thread_name(std::string_view name) {
+    t_thread_name = name;
+    if (ThreadRing* ring = t_lease.ring) {
+        std::lock_guard lock(registry().mutex);
+        ring->owners.back().name = name;
+    }
+}
+
+void write_chrome_json(std::ostream& out) {
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&] {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+    for (const auto& ring : reg.rings) {
+        for (const auto& owner : ring->owners) {
+            if (owner.name.empty()) continue;
+            separator();
+            out << R"({"ph":"M","name":"thread_name","pid":1,"tid":)" << owner.tid << R"(,"args":{"name":)";
+            write_json_string(out, owner.name);
+            out << "}}";
+        }
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        const uint64_t begin = std::max(ring->first_live, head > kRingCapacity ? head - kRingCapacity : 0);
+        size_t owner = 0;
+        for (uint64_t i = begin; i < head; ++i) {
+            while (owner + 1 < ring->owners.size() && ring->owners[owner + 1].first_event <= i) ++owner;
+            const Event& event = ring->events[i & (kRingCapacity - 1)];
+            separator();
+            out << R"({"ph":"X","pid":1,"tid":)" << ring->owners[owner].tid << R"(,"cat":)";
+            write_json_string(out, event.category);
+            out << R"(,"name":)";
+            write_json_string(out, event.name);
+            out << R"(,"ts":)";
+            write_microseconds(out, event.start_ns);
+            out << R"(,"dur":)";
+            write_microseconds(out, event.end_ns - event.start_ns);
+            out << '}';
+        }
+    }
+    out << "\n]}\n";
+}
+
+bool write_chrome_json(const std::filesystem::path& path) {
+    std::ofstream out(path);
+    if (!out) return false;
+    write_chrome_json(out);
+    return static_cast<bool>(out);
+}
+
+}  // namespace Hummingbird::Core::Trace
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string_view>
+
+#ifndef HB_TRACE_LEVEL
+#define HB_TRACE_LEVEL 1  // ZONES
+#endif
+
+// HB_TRACE_LEVEL: 0=OFF, 1=ZONES, 2=FINE
+//   ZONES: pipeline stages, per-box layout, paint, font loading, network callbacks.
+//   FINE:  also per-token zones, which dominate the timeline of any real page.
+// Compiled-in zones cost one relaxed atomic load each until recording is started.
+namespace Hummingbird::Core::Trace {
+
+namespace detail {
+extern std::atomic<bool> g_recording;
+// Ring buffers allocated so far, in use or free; for tests.
+size_t ring_count();
+}
+
+inline bool is_recording() {
+    return detail::g_recording.load(std::memory_order_relaxed);
+}
+
+// Starts/stops recording on every thread. Zones already open when recording stops are still recorded.
+void start();
+void stop();
+// Forgets everything recorded so far.
+void clear();
+
+// Nanoseconds on the trace clock (steady, starting near process start).
+uint64_t now_ns();
+
+// Appends a completed zone to the calling thread's ring buffer; once a ring is full its oldest zones are overwritten.
+// |name| and |category| must outlive the trace (string literals). Never blocks, except for a one-time registration
+// the first time a thread records. A thread's ring is reused by later threads once it exits.
+void record(const char* category, const char* name, uint64_t start_ns, uint64_t end_ns);
+
+// Labels the calling thread in exported traces (the copy is taken immediately). Cheap: a thread that never records
+// gets no ring buffer.
+void set_thread_name(std::string_view name);
+
+// Writes everything recorded as Chrome trace_event JSON, loadable in chrome://tracing or ui.perfetto.dev. Meant to
+// be called once recording has stopped: zones recorded meanwhile may be torn or missing.
+void write_chrome_json(std::ostream& out);
+bool write_chrome_json(const std::filesystem::path& path);
+
+class Zone {
+public:
+    Zone(const char* category, const char* name)
+        : m_category(category), m_name(name), m_start_ns(is_recording() ? now_ns() : 0) {}
+    ~Zone() {
+        if (m_start_ns != 0) record(m_category, m_name, m_start_ns, now_ns());
+    }
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+private:
+    const char* m_category;
+    const char* m_name;
+    uint64_t m_start_ns;
+};
+
+}  // namespace Hummingbird::Core::Trace
+
+#define HB_TRACE_CONCAT_INNER(a, b) a##b
+#define HB_TRACE_CONCAT(a, b) HB_TRACE_CONCAT_INNER(a, b)
+
+#if HB_TRACE_LEVEL >= 1
+#define HB_TRACE_ZONE(category, name) \
+    ::Hummingbird::Core::Trace::Zone HB_TRACE_CONCAT(hb_trace_zone_, __LINE__)(category, name)
+#define HB_TRACE_THREAD_NAME(name) ::Hummingbird::Core::Trace::set_thread_name(name)
+#else
+#define HB_TRACE_ZONE(category, name) ((void)0)
+#define HB_TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+#if HB_TRACE_LEVEL >= 2
+#define HB_TRACE_ZONE_FINE(category, name) HB_TRACE_ZONE(category, name)
+#else
+#define HB_TRACE_ZONE_FINE(category, name) ((void)0)
+#endif
@@ -14,6 +14,7 @@ static constexpr std::string_view Href = "href";
 static constexpr std::string_view Id = "id";
 static constexpr std::string_view NoWrap = "nowrap";
 static constexpr std::string_view Rel = "rel";
+static constexpr std::string_view RowSpan = "rowspan";
 static constexpr std::string_view Size = "size";
 static constexpr std::string_view Src = "src";
 static constexpr std::string_view Width = "width";
@@ -5,6 +5,7 @@
 
 #include "core/dom/DomFactory.h"
 #include "core/utils/Log.h"
+#include "core/utils/Trace.h"
 #include "html/HtmlAttributeNames.h"
 #include "html/HtmlTagNames.h"
 
@@ -80,6 +81,7 @@ bool is_known_element(std::string_view name) {
 }  // namespace
 
 Parser::Result Parser::parse() {
+    HB_TRACE_ZONE("html", "Html::Parser::parse");
     m_style_blocks.clear();
     m_stylesheet_links.clear();
     m_unsupported_tags.clear();
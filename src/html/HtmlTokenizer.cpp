@@ -2,6 +2,8 @@
 
 #include <cctype>
 
+#include "core/utils/Trace.h"
+
 namespace Hummingbird::Html {
 
 Tokenizer::Tokenizer(std::string_view input) : m_input(input) {}
@@ -180,6 +182,7 @@ void Tokenizer::skip_until(char terminal) {
 }
 
 Token Tokenizer::next_token() {
+    HB_TRACE_ZONE_FINE("html", "Html::Tokenizer::next_token");
     while (!eof()) {
         switch (m_state) {
             case State::Data: {
@@ -2,7 +2,9 @@
 
 #include <algorithm>
 
+#include "core/utils/Trace.h"
 #include "layout/InlineLineBuilder.h"
+#include "layout/inline/InlineLayoutCache.h"
 
 namespace Hummingbird::Layout {
 
@@ -33,8 +35,6 @@ struct InlineLayoutMetrics {
     float last_line_width = 0.0f;
 };
 
-constexpr float kInlineAtomicLayoutWidth = 100000.0f;
-
 LayoutMetrics compute_metrics(const Css::ComputedStyle* style, const Rect& bounds, Rect& rect) {
     float padding_left = style ? style->padding.left : 0.0f;
     float padding_right = style ? style->padding.right : 0.0f;
@@ -67,6 +67,11 @@ LayoutMetrics compute_metrics(const Css::ComputedStyle* style, const Rect& bound
     return {inset_left, inset_right, inset_top, inset_bottom, content_width};
 }
 
+float horizontal_insets(const Css::ComputedStyle* style) {
+    if (!style) return 0.0f;
+    return style->padding.left + style->padding.right + style->border_width.left + style->border_width.right;
+}
+
 ChildMargins compute_child_margins(const Css::ComputedStyle* style) {
     return {style ? style->margin.left : 0.0f, style ? style->margin.right : 0.0f, style ? style->margin.top : 0.0f,
             style ? style->margin.bottom : 0.0f};
@@ -78,8 +83,24 @@ void flush_line(LineCursor& cursor, float inset_left) {
     cursor.line_height = 0.0f;
 }
 
+// Running average of the block children laid out for real, used as the height of the ones that are estimated.
+struct BlockHeightEstimate {
+    float fallback;
+    float total = 0.0f;
+    size_t count = 0;
+
+    float value() const { return count > 0 ? total / static_cast<float>(count) : fallback; }
+    void add(float height) {
+        total += height;
+        ++count;
+    }
+};
+
+// A child outside the layout window that would need real work gets an estimated height instead; everything else is
+// laid out with the window shifted into its own coordinates.
 void layout_block_child(IGraphicsContext& context, RenderObject& child, const ChildMargins& margins,
-                        const LayoutMetrics& metrics, LineCursor& cursor) {
+                        const LayoutMetrics& metrics, const LayoutWindow& window, BlockHeightEstimate& estimate,
+                        LineCursor& cursor) {
     if (margins.top > 0.0f) {
         cursor.y += margins.top;
     }
@@ -87,68 +108,15 @@ void layout_block_child(IGraphicsContext& context, RenderObject& child, const Ch
     float child_x = metrics.inset_left + margins.left;
     float child_y = cursor.y;
     float available_width = metrics.content_width - margins.left - margins.right;
-    Rect child_bounds = {child_x, child_y, available_width, 0.0f};
-    child.layout(context, child_bounds);
-    cursor.y = child_y + child.get_rect().height + margins.bottom;
-}
-
-void measure_inline_participants(IGraphicsContext& context, std::vector<std::unique_ptr<RenderObject>>& children,
-                                 size_t& i) {
-    while (i < children.size()) {
-        auto inl = children[i]->Inline();
-        if (!inl) break;
-
-        inl.get().reset_inline_layout();
-        inl.get().measure_inline(context);
-        ++i;
-    }
-}
-
-void collect_inline_runs(IGraphicsContext& context, std::vector<std::unique_ptr<RenderObject>>& children, size_t& i,
-                         std::vector<InlineRun>& runs) {
-    while (i < children.size()) {
-        auto inl = children[i]->Inline();
-        if (!inl) break;
-
-        inl.get().collect_inline_runs(context, runs);
-        ++i;
-    }
-}
-
-void align_inline_lines(std::vector<InlineLine>& lines, float available_width, Css::ComputedStyle::TextAlign align) {
-    if (align == Css::ComputedStyle::TextAlign::Left || available_width <= 0.0f) {
-        return;
-    }
-
-    for (auto& line : lines) {
-        if (line.fragments.empty()) {
-            continue;
-        }
-        float min_x = line.fragments.front().rect.x;
-        float max_x = line.fragments.front().rect.x + line.fragments.front().rect.width;
-        for (const auto& fragment : line.fragments) {
-            min_x = std::min(min_x, fragment.rect.x);
-            max_x = std::max(max_x, fragment.rect.x + fragment.rect.width);
-        }
-        float line_width = max_x - min_x;
-        if (line_width <= 0.0f || line_width >= available_width) {
-            continue;
-        }
-
-        float desired_start = 0.0f;
-        if (align == Css::ComputedStyle::TextAlign::Center) {
-            desired_start = (available_width - line_width) * 0.5f;
-        } else if (align == Css::ComputedStyle::TextAlign::Right) {
-            desired_start = available_width - line_width;
-        }
-        float shift = desired_start - min_x;
-        if (shift == 0.0f) {
-            continue;
-        }
-        for (auto& fragment : line.fragments) {
-            fragment.rect.x += shift;
-        }
+    float estimated_height = estimate.value();
+    if (!window.overlaps(child_y, child_y + estimated_height) && !child.has_layout_at_width(context, available_width)) {
+        child.set_estimated_layout({child_x, child_y, available_width, estimated_height});
+    } else {
+        Rect child_bounds = {child_x, child_y, available_width, 0.0f};
+        child.layout_in_window(context, child_bounds, window.relative_to(child_y));
+        estimate.add(child.get_rect().height);
     }
+    cursor.y = child_y + child.get_rect().height + margins.bottom;
 }
 
 InlineLayoutMetrics apply_inline_fragments(const std::vector<InlineLine>& lines, const std::vector<InlineRun>& runs,
@@ -199,36 +167,24 @@ void update_cursor_for_inline(LineCursor& cursor, const LayoutMetrics& metrics,
     cursor.line_height = std::max(cursor.line_height, last_height);
 }
 
-void layout_inline_group(IGraphicsContext& context, std::vector<std::unique_ptr<RenderObject>>& children, size_t& i,
-                         const LayoutMetrics& metrics, LineCursor& cursor, Css::ComputedStyle::TextAlign text_align,
-                         float wrap_width) {
-    InlineLineBuilder builder;
-    builder.reset();
-    std::vector<InlineRun> runs;
-    size_t group_start = i;
-    size_t group_end = i;
-
-    measure_inline_participants(context, children, group_end);
-    i = group_start;
-    collect_inline_runs(context, children, i, runs);
-
+void layout_inline_group(IGraphicsContext& context, InlineLayoutCache& cache,
+                         std::vector<std::unique_ptr<RenderObject>>& children, size_t& i, const LayoutMetrics& metrics,
+                         LineCursor& cursor, Css::ComputedStyle::TextAlign text_align, float wrap_width,
+                         LineBreakMode break_mode) {
+    InlineGroupCache& group = cache.measure_group(context, children, i);
+    const auto& runs = group.runs();
     if (runs.empty()) {
         return;
     }
 
-    for (const auto& run : runs) {
-        builder.add_run(run);
-    }
-
     float start_x = cursor.x - metrics.inset_left;
-    auto lines = builder.layout(wrap_width, start_x);
-    align_inline_lines(lines, metrics.content_width, text_align);
+    const auto& lines = group.lines_for({wrap_width, start_x, metrics.content_width, text_align, break_mode});
     float base_x = metrics.inset_left;
     float base_y = cursor.y;
 
     InlineLayoutMetrics layout = apply_inline_fragments(lines, runs, base_x, base_y);
 
-    for (size_t j = group_start; j < group_end; ++j) {
+    for (size_t j = group.group_start(); j < group.group_end(); ++j) {
         if (auto inl = children[j]->Inline()) {
             inl.get().finalize_inline_layout();
         }
@@ -238,10 +194,25 @@ void layout_inline_group(IGraphicsContext& context, std::vector<std::unique_ptr<
 }
 }  // namespace
 
+bool BlockBox::has_layout_at_width(const IGraphicsContext& context, float width) const {
+    return !m_needs_layout && !is_layout_estimated() && m_last_layout_context == &context &&
+           m_last_layout_width == width;
+}
+
 void BlockBox::layout(IGraphicsContext& context, const Rect& bounds) {
+    HB_TRACE_ZONE("layout", "BlockBox::layout");
+    if (!m_needs_layout && !m_has_pending_layout && m_last_layout_context == &context &&
+        m_last_layout_width == bounds.width) {
+        // Nothing below us changed and the width is the same, so the subtree's layout still holds; only the
+        // position moves.
+        m_rect = {bounds.x, bounds.y, m_last_layout_rect.width, m_last_layout_rect.height};
+        return;
+    }
     const auto* style = get_computed_style();
     LayoutMetrics metrics = compute_metrics(style, bounds, m_rect);
     LineCursor cursor{metrics.inset_left, metrics.inset_top, 0.0f};
+    BlockHeightEstimate estimate{m_estimated_block_height};
+    bool pending = false;
 
     size_t i = 0;
     while (i < m_children.size()) {
@@ -251,23 +222,71 @@ void BlockBox::layout(IGraphicsContext& context, const Rect& bounds) {
 
         if (!child->Inline()) {
             // Control objects like <br> need to break the line before stacking blocks.
-            layout_block_child(context, *child, margins, metrics, cursor);
+            layout_block_child(context, *child, margins, metrics, m_layout_window, estimate, cursor);
+            pending = pending || child->has_pending_layout();
             ++i;
             continue;
         }
         auto align = style ? style->text_align : Css::ComputedStyle::TextAlign::Left;
-        // Avoid using text-align during intrinsic measurement with oversized widths.
-        if (align != Css::ComputedStyle::TextAlign::Left && bounds.width >= kInlineAtomicLayoutWidth &&
-            !(style && style->width.has_value())) {
-            align = Css::ComputedStyle::TextAlign::Left;
-        }
         float wrap_width =
             (style && style->whitespace == Css::ComputedStyle::WhiteSpace::NoWrap) ? 0.0f : metrics.content_width;
-        layout_inline_group(context, m_children, i, metrics, cursor, align, wrap_width);
+        LineBreakMode break_mode = line_break_mode(style);
+        layout_inline_group(context, m_inline_cache, m_children, i, metrics, cursor, align, wrap_width, break_mode);
     }
 
     flush_line(cursor, metrics.inset_left);
     m_rect.height = cursor.y + metrics.inset_bottom;
+
+    if (estimate.count > 0) {
+        m_estimated_block_height = estimate.value();
+    }
+    m_has_pending_layout = pending;
+    m_needs_layout = false;
+    m_last_layout_context = &context;
+    m_last_layout_width = bounds.width;
+    m_last_layout_rect = m_rect;
+}
+
+IntrinsicSizes BlockBox::content_intrinsic_sizes(IGraphicsContext& context) {
+    const auto* style = get_computed_style();
+    bool nowrap = style && style->whitespace == Css::ComputedStyle::WhiteSpace::NoWrap;
+
+    IntrinsicSizes sizes;
+    size_t i = 0;
+    while (i < m_children.size()) {
+        auto& child = m_children[i];
+        if (!child->Inline()) {
+            ChildMargins margins = compute_child_margins(child->get_computed_style());
+            IntrinsicSizes child_sizes = child->compute_intrinsic_sizes(context);
+            sizes.min_content = std::max(sizes.min_content, child_sizes.min_content + margins.left + margins.right);
+            sizes.max_content = std::max(sizes.max_content, child_sizes.max_content + margins.left + margins.right);
+            ++i;
+            continue;
+        }
+
+        // An inline group is one line that may break inside or between its children. Only the children's own
+        // intrinsic sizes are read, so atomic inlines aren't laid out (and keep their geometry) here.
+        float line_width = 0.0f;
+        float widest_child = 0.0f;
+        for (; i < m_children.size() && m_children[i]->Inline(); ++i) {
+            IntrinsicSizes child_sizes = m_children[i]->compute_intrinsic_sizes(context);
+            line_width += child_sizes.max_content;
+            widest_child = std::max(widest_child, child_sizes.min_content);
+        }
+        sizes.min_content = std::max(sizes.min_content, nowrap ? line_width : widest_child);
+        sizes.max_content = std::max(sizes.max_content, line_width);
+    }
+    return sizes;
+}
+
+IntrinsicSizes BlockBox::calculate_intrinsic_sizes(IGraphicsContext& context) {
+    const auto* style = get_computed_style();
+    float insets = horizontal_insets(style);
+    if (style && style->width.has_value()) {
+        return {*style->width + insets, *style->width + insets};
+    }
+    IntrinsicSizes content = content_intrinsic_sizes(context);
+    return {content.min_content + insets, content.max_content + insets};
 }
 
 void InlineBlockBox::reset_inline_layout() {
@@ -278,7 +297,9 @@ void InlineBlockBox::reset_inline_layout() {
 
 void InlineBlockBox::measure_inline(IGraphicsContext& context) {
     m_inline_atomic = true;
-    layout(context, {0.0f, 0.0f, kInlineAtomicLayoutWidth, 0.0f});
+    // Shrink-to-fit without a containing width is max-content; lay out once at that width.
+    float width = compute_intrinsic_sizes(context).max_content;
+    layout(context, {0.0f, 0.0f, width + kIntrinsicLayoutSlack, 0.0f});
     m_inline_measured_width = m_rect.width;
     m_inline_measured_height = m_rect.height;
 }
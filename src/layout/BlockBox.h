@@ -2,6 +2,7 @@
 
 #include "layout/RenderObject.h"
 #include "layout/inline/IInlineParticipant.h"
+#include "layout/inline/InlineLayoutCache.h"
 
 namespace Hummingbird::Layout {
 
@@ -11,10 +12,29 @@ public:
         return std::unique_ptr<BlockBox>(new BlockBox(dom_node));
     }
 
+    // Lays out children top to bottom. Under a bounded layout window (lazy block flow), block children outside the
+    // window that have no reusable layout are given the average height of their laid-out siblings instead; a later
+    // layout with a wider window replaces those estimates.
     void layout(IGraphicsContext& context, const Rect& bounds) override;
+    bool has_layout_at_width(const IGraphicsContext& context, float width) const override;
 
 protected:
     explicit BlockBox(const DOM::Node* dom_node) : RenderObject(dom_node) {}
+
+    IntrinsicSizes calculate_intrinsic_sizes(IGraphicsContext& context) override;
+    void clear_layout_caches() override { m_inline_cache.clear(); }
+    // Widest child contributions: block children with their margins, and each inline group's longest run
+    // (min-content) and unwrapped line (max-content).
+    IntrinsicSizes content_intrinsic_sizes(IGraphicsContext& context);
+
+    InlineLayoutCache m_inline_cache;
+
+private:
+    // Key and result of the last BlockBox::layout, reused while the subtree doesn't need layout.
+    const IGraphicsContext* m_last_layout_context = nullptr;
+    float m_last_layout_width = 0.0f;
+    Rect m_last_layout_rect;
+    float m_estimated_block_height = 16.0f;  // one text line until a block child has been laid out for real
 };
 
 class InlineBlockBox : public BlockBox, public IInlineParticipant {
@@ -10,4 +10,16 @@ struct Rect {
     float x = 0, y = 0, width = 0, height = 0;
 };
 
-}  // namespace Hummingbird::Layout
\ No newline at end of file
+// True when |box| lies entirely outside |viewport|, so drawing it cannot reach the screen. A viewport without area
+// means "not clipped": nothing is outside it.
+inline bool is_outside_viewport(const Rect& viewport, const Rect& box) {
+    if (viewport.width <= 0 || viewport.height <= 0) {
+        return false;
+    }
+    if (box.y + box.height < viewport.y || box.y > viewport.y + viewport.height) {
+        return true;
+    }
+    return box.x + box.width < viewport.x || box.x > viewport.x + viewport.width;
+}
+
+}  // namespace Hummingbird::Layout
@@ -3,13 +3,12 @@
 #include <algorithm>
 
 #include "core/platform_api/IGraphicsContext.h"
+#include "core/utils/Trace.h"
 #include "layout/InlineLineBuilder.h"
 
 namespace Hummingbird::Layout {
 
 namespace {
-constexpr float kInlineAtomicLayoutWidth = 100000.0f;
-
 struct LayoutMetrics {
     float inset_left;
     float inset_right;
@@ -62,6 +61,28 @@ ChildMargins compute_child_margins(const Css::ComputedStyle* style) {
 }
 }  // namespace
 
+IntrinsicSizes InlineBox::calculate_intrinsic_sizes(IGraphicsContext& context) {
+    const auto* style = get_computed_style();
+    // With insets the box is atomic and layout() places children side by side without wrapping between them;
+    // otherwise its children join the surrounding lines and can wrap between each other.
+    const bool atomic = has_insets(style);
+    float insets =
+        style ? style->padding.left + style->padding.right + style->border_width.left + style->border_width.right
+              : 0.0f;
+    IntrinsicSizes sizes{insets, insets};
+    for (auto& child : m_children) {
+        ChildMargins margins = compute_child_margins(child->get_computed_style());
+        IntrinsicSizes child_sizes = child->compute_intrinsic_sizes(context);
+        if (atomic) {
+            sizes.min_content += child_sizes.min_content + margins.left + margins.right;
+        } else {
+            sizes.min_content = std::max(sizes.min_content, child_sizes.min_content + margins.left + margins.right);
+        }
+        sizes.max_content += child_sizes.max_content + margins.left + margins.right;
+    }
+    return sizes;
+}
+
 void InlineBox::reset_inline_layout() {
     m_inline_atomic = false;
     m_inline_measured_width = 0.0f;
@@ -73,7 +94,8 @@ void InlineBox::measure_inline(IGraphicsContext& context) {
 
     if (has_insets(style)) {
         m_inline_atomic = true;
-        layout(context, {0.0f, 0.0f, kInlineAtomicLayoutWidth, 0.0f});
+        float width = compute_intrinsic_sizes(context).max_content;
+        layout(context, {0.0f, 0.0f, width + kIntrinsicLayoutSlack, 0.0f});
         m_inline_measured_width = m_rect.width;
         m_inline_measured_height = m_rect.height;
         return;
@@ -169,6 +191,7 @@ void InlineBox::finalize_inline_layout() {
 }
 
 void InlineBox::layout(IGraphicsContext& context, const Rect& bounds) {
+    HB_TRACE_ZONE("layout", "InlineBox::layout");
     const auto* style = get_computed_style();
     LayoutMetrics metrics = compute_metrics(style, bounds, m_rect);
     float cursor_x = metrics.inset_left;
@@ -1,11 +1,17 @@
 #include "layout/InlineLineBuilder.h"
 
 #include <algorithm>
+#include <limits>
 
 namespace Hummingbird::Layout {
 
 void InlineLineBuilder::reset() {
     m_runs.clear();
+    m_line_fragments.clear();
+}
+
+void InlineLineBuilder::reserve(size_t run_count) {
+    m_runs.reserve(run_count);
 }
 
 void InlineLineBuilder::add_run(const InlineRun& run) {
@@ -32,39 +38,99 @@ InlineFragment InlineLineBuilder::build_fragment(size_t run_index, const LayoutC
     return fragment;
 }
 
-std::vector<InlineLine> InlineLineBuilder::layout(float max_width, float start_x) {
+// Dynamic program over break opportunities between runs. A line may only start at runs whose line to the
+// current run still fits, so the active window is bounded by the number of runs per line and the whole pass is
+// O(n * runs_per_line). A run wider than the line is allowed alone on its line, as in the greedy breaker.
+// Collapsible spaces at the end of a line hang past it, so they neither overflow the line nor fill its slack.
+void InlineLineBuilder::compute_optimal_breaks(float max_width, float start_x) {
+    const size_t count = m_runs.size();
+    m_prefix_widths.resize(count + 1);
+    m_trailing_space.resize(count + 1);
+    m_prefix_widths[0] = 0.0f;
+    m_trailing_space[0] = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        m_prefix_widths[i + 1] = m_prefix_widths[i] + m_runs[i].width;
+        m_trailing_space[i + 1] = m_runs[i].collapsible_space ? m_trailing_space[i] + m_runs[i].width : 0.0f;
+    }
+    auto line_width = [&](size_t from, size_t to) {
+        float width = m_prefix_widths[to] - m_prefix_widths[from];
+        return width - std::min(m_trailing_space[to], width) + (from == 0 ? start_x : 0.0f);
+    };
+
+    m_break_costs.assign(count + 1, std::numeric_limits<double>::infinity());
+    m_break_from.assign(count + 1, 0);
+    m_break_costs[0] = 0.0;
+
+    size_t window_start = 0;
+    for (size_t to = 1; to <= count; ++to) {
+        while (window_start + 1 < to && line_width(window_start, to) > max_width) {
+            ++window_start;
+        }
+        // Slack grows as |from| moves right, and costs are non-negative, so once a line's own demerits exceed the
+        // best total found the remaining (shorter) candidates can't win. Ties go to the later break, so a line ends
+        // after a hanging space rather than pushing it to the start of the next line.
+        for (size_t from = window_start; from < to; ++from) {
+            double slack = std::max(0.0, static_cast<double>(max_width) - line_width(from, to));
+            double demerits = to == count ? 0.0 : slack * slack;  // the last line may be ragged
+            if (demerits > m_break_costs[to]) break;
+            double cost = m_break_costs[from] + demerits;
+            if (cost <= m_break_costs[to]) {
+                m_break_costs[to] = cost;
+                m_break_from[to] = from;
+            }
+        }
+    }
+
+    m_breaks.clear();
+    for (size_t at = m_break_from[count]; at > 0; at = m_break_from[at]) {
+        m_breaks.push_back(at);
+    }
+    std::reverse(m_breaks.begin(), m_breaks.end());
+}
+
+std::vector<InlineLine> InlineLineBuilder::layout(float max_width, float start_x, LineBreakMode mode) {
     std::vector<InlineLine> lines;
     lines.reserve(m_runs.size());
 
+    bool optimal = mode == LineBreakMode::Optimal && max_width > 0.0f && m_runs.size() > 1;
+    if (optimal) {
+        compute_optimal_breaks(max_width, start_x);
+    }
+    size_t next_break = 0;
+
     LayoutCursor cursor{start_x, 0.0f, 0.0f, 0};
     bool has_line = false;
-    InlineLine current_line;
+    // Fragments are staged in a reused buffer and copied once per line, so each line allocates exactly once.
+    m_line_fragments.clear();
+    auto close_line = [&]() {
+        InlineLine& line = lines.emplace_back();
+        line.height = cursor.line_height;
+        line.fragments.assign(m_line_fragments.begin(), m_line_fragments.end());
+        m_line_fragments.clear();
+    };
 
     for (size_t i = 0; i < m_runs.size(); ++i) {
         const auto& run = m_runs[i];
-        if (should_wrap(max_width, cursor, run.width)) {
+        bool wrap = optimal ? (next_break < m_breaks.size() && m_breaks[next_break] == i)
+                            : should_wrap(max_width, cursor, run.width);
+        if (wrap) {
+            ++next_break;
             if (has_line) {
-                current_line.height = cursor.line_height;
-                lines.push_back(std::move(current_line));
-                current_line = InlineLine{};
+                close_line();
                 advance_line(cursor);
                 has_line = false;
             }
         }
 
-        if (!has_line) {
-            current_line = InlineLine{};
-            has_line = true;
-        }
-        current_line.fragments.push_back(build_fragment(i, cursor, run));
+        has_line = true;
+        m_line_fragments.push_back(build_fragment(i, cursor, run));
 
         cursor.line_height = std::max(cursor.line_height, run.height);
         cursor.x += run.width;
     }
 
     if (has_line || !m_runs.empty()) {
-        current_line.height = cursor.line_height;
-        lines.push_back(std::move(current_line));
+        close_line();
     }
 
     return lines;
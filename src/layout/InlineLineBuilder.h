@@ -1,18 +1,24 @@
 #pragma once
 
 #include <cstddef>
-#include <string>
 #include <vector>
 
 #include "layout/inline/InlineTypes.h"
 
 namespace Hummingbird::Layout {
 
+enum class LineBreakMode {
+    Greedy,   // wrap as soon as the next run would overflow
+    Optimal,  // total-fit: minimize the summed squared slack of all lines but the last
+};
+
 class InlineLineBuilder {
 public:
     void reset();
+    void reserve(size_t run_count);
     void add_run(const InlineRun& run);
-    std::vector<InlineLine> layout(float max_width, float start_x = 0.0f);
+    std::vector<InlineLine> layout(float max_width, float start_x = 0.0f,
+                                   LineBreakMode mode = LineBreakMode::Greedy);
 
 private:
     struct LayoutCursor {
@@ -25,7 +31,16 @@ private:
     bool should_wrap(float max_width, const LayoutCursor& cursor, float next_width) const;
     void advance_line(LayoutCursor& cursor);
     InlineFragment build_fragment(size_t run_index, const LayoutCursor& cursor, const InlineRun& run) const;
+    void compute_optimal_breaks(float max_width, float start_x);
+
     std::vector<InlineRun> m_runs;
+    std::vector<InlineFragment> m_line_fragments;
+    // Scratch for the optimal breaker, kept across calls to avoid reallocating per paragraph.
+    std::vector<float> m_prefix_widths;
+    std::vector<float> m_trailing_space;  // width of the collapsible runs that end each prefix
+    std::vector<double> m_break_costs;
+    std::vector<size_t> m_break_from;
+    std::vector<size_t> m_breaks;  // run index that starts each line after the first, ascending
 };
 
 }  // namespace Hummingbird::Layout
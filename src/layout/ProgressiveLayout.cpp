@@ -0,0 +1,83 @@
+#include "layout/ProgressiveLayout.h"
+
+#include <cmath>
+
+#include "core/utils/Trace.h"
+
+namespace Hummingbird::Layout {
+
+namespace {
+// Correcting the scroll position can move the viewport into content that was just estimated, so the viewport is laid
+// out again from the corrected position; the shift shrinks quickly because each pass replaces the estimates it used.
+constexpr int kMaxAnchorPasses = 4;
+
+float offset_in_root(const RenderObject& root, const RenderObject& object) {
+    float y = 0.0f;
+    for (const RenderObject* current = &object; current && current != &root; current = current->get_parent()) {
+        y += current->get_rect().y;
+    }
+    return y;
+}
+
+// Deepest box whose border box spans |y| (in root coordinates), descending through the first matching child.
+const RenderObject* find_scroll_anchor(const RenderObject& root, float y) {
+    const RenderObject* node = &root;
+    float node_top = 0.0f;
+    while (true) {
+        const RenderObject* next = nullptr;
+        for (const auto& child : node->get_children()) {
+            const Rect& rect = child->get_rect();
+            float top = node_top + rect.y;
+            if (rect.height > 0.0f && top <= y && y < top + rect.height) {
+                next = child.get();
+                node_top = top;
+                break;
+            }
+        }
+        if (!next) {
+            break;
+        }
+        node = next;
+        if (node->is_layout_estimated()) {
+            break;  // its children still hold an older layout
+        }
+    }
+    return node == &root ? nullptr : node;
+}
+}  // namespace
+
+float ProgressiveLayout::layout_viewport(RenderObject& root, IGraphicsContext& context, const Rect& viewport,
+                                         float scroll_y) {
+    m_margin = viewport.height * kViewportMargin;
+    return layout_window(root, context, viewport, scroll_y);
+}
+
+float ProgressiveLayout::advance(RenderObject& root, IGraphicsContext& context, const Rect& viewport,
+                                 float scroll_y) {
+    if (is_complete(root)) {
+        return scroll_y;
+    }
+    m_margin += viewport.height * kIdleStepViewports;
+    return layout_window(root, context, viewport, scroll_y);
+}
+
+float ProgressiveLayout::layout_window(RenderObject& root, IGraphicsContext& context, const Rect& viewport,
+                                       float scroll_y) {
+    HB_TRACE_ZONE("layout", "ProgressiveLayout::layout_window");
+    for (int pass = 0; pass < kMaxAnchorPasses; ++pass) {
+        const RenderObject* anchor = find_scroll_anchor(root, scroll_y);
+        float anchor_before = anchor ? offset_in_root(root, *anchor) : 0.0f;
+
+        LayoutWindow window{scroll_y - m_margin, scroll_y + viewport.height + m_margin};
+        root.layout_in_window(context, viewport, window);
+
+        float shift = anchor ? offset_in_root(root, *anchor) - anchor_before : 0.0f;
+        scroll_y += shift;
+        if (std::abs(shift) < 0.5f) {
+            break;
+        }
+    }
+    return scroll_y;
+}
+
+}  // namespace Hummingbird::Layout
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "layout/Geometry.h"
+#include "layout/RenderObject.h"
+
+class IGraphicsContext;
+
+namespace Hummingbird::Layout {
+
+// Drives lazy block flow for a whole document. The first layout only covers what the viewport shows, with the rest
+// of the document estimated; idle steps then widen the laid-out window until no estimates remain.
+//
+// Scroll positions are in the root's own coordinates (0 is the root's top). Replacing estimates above the viewport
+// moves content, so every call returns a scroll position corrected to keep the box at the top of the viewport (the
+// scroll anchor) where it was on screen.
+class ProgressiveLayout {
+public:
+    // Lays out what the viewport at |scroll_y| needs and restarts idle widening from there.
+    float layout_viewport(RenderObject& root, IGraphicsContext& context, const Rect& viewport, float scroll_y);
+    // One idle step: widens the window by kIdleStepViewports viewport heights above and below the viewport.
+    float advance(RenderObject& root, IGraphicsContext& context, const Rect& viewport, float scroll_y);
+    static bool is_complete(const RenderObject& root) { return !root.has_pending_layout(); }
+
+    static constexpr float kViewportMargin = 0.5f;  // in viewport heights, laid out on each side of the viewport
+    static constexpr float kIdleStepViewports = 8.0f;
+
+private:
+    float layout_window(RenderObject& root, IGraphicsContext& context, const Rect& viewport, float scroll_y);
+
+    float m_margin = 0.0f;
+};
+
+}  // namespace Hummingbird::Layout
@@ -1,6 +1,7 @@
 #include "layout/RenderImage.h"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <cstdlib>
 #include <optional>
@@ -8,6 +9,7 @@
 #include <string_view>
 
 #include "core/utils/AssetPath.h"
+#include "core/utils/Trace.h"
 #include "html/HtmlAttributeNames.h"
 #include "layout/inline/InlineTypes.h"
 
@@ -121,14 +123,13 @@ std::string find_attribute_value(const DOM::Element& element, std::string_view n
 
 void draw_outline(IGraphicsContext& context, const Rect& rect, const Color& color) {
     constexpr float kThickness = 1.0f;
-    Rect top{rect.x, rect.y, rect.width, kThickness};
-    Rect bottom{rect.x, rect.y + rect.height - kThickness, rect.width, kThickness};
-    Rect left{rect.x, rect.y, kThickness, rect.height};
-    Rect right{rect.x + rect.width - kThickness, rect.y, kThickness, rect.height};
-    context.fill_rect(top, color);
-    context.fill_rect(bottom, color);
-    context.fill_rect(left, color);
-    context.fill_rect(right, color);
+    const std::array<Rect, 4> sides{{
+        {rect.x, rect.y, rect.width, kThickness},                             // top
+        {rect.x, rect.y + rect.height - kThickness, rect.width, kThickness},  // bottom
+        {rect.x, rect.y, kThickness, rect.height},                            // left
+        {rect.x + rect.width - kThickness, rect.y, kThickness, rect.height},  // right
+    }};
+    context.fill_rects(sides, color);
 }
 
 std::string resolve_default_font_path() {
@@ -137,6 +138,7 @@ std::string resolve_default_font_path() {
 }  // namespace
 
 void RenderImage::layout(IGraphicsContext& /*context*/, const Rect& bounds) {
+    HB_TRACE_ZONE("layout", "RenderImage::layout");
     auto* element = static_cast<const DOM::Element*>(get_dom_node());
     const auto* style = get_computed_style();
     LayoutSize size = compute_layout_size(*element, style);
@@ -195,6 +197,12 @@ void RenderImage::reset_inline_layout() {
     m_inline_measured_height = 0.0f;
 }
 
+IntrinsicSizes RenderImage::calculate_intrinsic_sizes(IGraphicsContext& /*context*/) {
+    auto* element = static_cast<const DOM::Element*>(get_dom_node());
+    LayoutSize size = compute_layout_size(*element, get_computed_style());
+    return {size.width, size.width};
+}
+
 void RenderImage::measure_inline(IGraphicsContext& /*context*/) {
     auto* element = static_cast<const DOM::Element*>(get_dom_node());
     const auto* style = get_computed_style();
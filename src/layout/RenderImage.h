@@ -21,6 +21,7 @@ public:
     const IInlineParticipant* as_inline_participant() const override;
 
 protected:
+    IntrinsicSizes calculate_intrinsic_sizes(IGraphicsContext& context) override;
     void reset_inline_layout() override;
     void measure_inline(IGraphicsContext& context) override;
     void collect_inline_runs(IGraphicsContext& context, std::vector<InlineRun>& runs) override;
@@ -3,7 +3,9 @@
 #include <algorithm>
 
 #include "core/platform_api/IGraphicsContext.h"
+#include "core/utils/Trace.h"
 #include "layout/InlineLineBuilder.h"
+#include "layout/inline/InlineLayoutCache.h"
 
 namespace Hummingbird::Layout {
 
@@ -96,65 +98,6 @@ struct InlineLayoutResult {
     float last_line_width = 0.0f;
 };
 
-void measure_inline_participants(IGraphicsContext& context, std::vector<std::unique_ptr<RenderObject>>& children,
-                                 size_t& i) {
-    while (i < children.size()) {
-        auto p = children[i]->Inline();
-        if (!p) break;
-
-        p.get().reset_inline_layout();
-        p.get().measure_inline(context);
-        ++i;
-    }
-}
-
-void collect_inline_runs(IGraphicsContext& context, std::vector<std::unique_ptr<RenderObject>>& children, size_t& i,
-                         std::vector<InlineRun>& runs) {
-    while (i < children.size()) {
-        auto p = children[i]->Inline();
-        if (!p) break;
-
-        p.get().collect_inline_runs(context, runs);
-        ++i;
-    }
-}
-
-void align_inline_lines(std::vector<InlineLine>& lines, float available_width, Css::ComputedStyle::TextAlign align) {
-    if (align == Css::ComputedStyle::TextAlign::Left || available_width <= 0.0f) {
-        return;
-    }
-
-    for (auto& line : lines) {
-        if (line.fragments.empty()) {
-            continue;
-        }
-        float min_x = line.fragments.front().rect.x;
-        float max_x = line.fragments.front().rect.x + line.fragments.front().rect.width;
-        for (const auto& fragment : line.fragments) {
-            min_x = std::min(min_x, fragment.rect.x);
-            max_x = std::max(max_x, fragment.rect.x + fragment.rect.width);
-        }
-        float line_width = max_x - min_x;
-        if (line_width <= 0.0f || line_width >= available_width) {
-            continue;
-        }
-
-        float desired_start = 0.0f;
-        if (align == Css::ComputedStyle::TextAlign::Center) {
-            desired_start = (available_width - line_width) * 0.5f;
-        } else if (align == Css::ComputedStyle::TextAlign::Right) {
-            desired_start = available_width - line_width;
-        }
-        float shift = desired_start - min_x;
-        if (shift == 0.0f) {
-            continue;
-        }
-        for (auto& fragment : line.fragments) {
-            fragment.rect.x += shift;
-        }
-    }
-}
-
 InlineLayoutResult apply_inline_fragments(const std::vector<InlineLine>& lines, const std::vector<InlineRun>& runs,
                                           float base_x, float base_y) {
     InlineLayoutResult result;
@@ -205,40 +148,29 @@ void update_cursor_for_inline(LineCursor& cursor, const LayoutMetrics& metrics,
     cursor.line_height = std::max(cursor.line_height, last_height);
 }
 
-InlineLayoutResult layout_inline_group(IGraphicsContext& context, std::vector<std::unique_ptr<RenderObject>>& children,
-                                       size_t& i, const LayoutMetrics& metrics, LineCursor& cursor,
-                                       Css::ComputedStyle::TextAlign text_align, float wrap_width) {
+InlineLayoutResult layout_inline_group(IGraphicsContext& context, InlineLayoutCache& cache,
+                                       std::vector<std::unique_ptr<RenderObject>>& children, size_t& i,
+                                       const LayoutMetrics& metrics, LineCursor& cursor,
+                                       Css::ComputedStyle::TextAlign text_align, float wrap_width,
+                                       LineBreakMode break_mode) {
     InlineLayoutResult result;
-    InlineLineBuilder builder;
-    builder.reset();
-    std::vector<InlineRun> runs;
-    size_t group_start = i;
-    size_t group_end = i;
-
-    measure_inline_participants(context, children, group_end);
-    i = group_start;
-    collect_inline_runs(context, children, i, runs);
-
+    InlineGroupCache& group = cache.measure_group(context, children, i);
+    const auto& runs = group.runs();
     if (runs.empty()) {
         return result;
     }
 
-    for (const auto& run : runs) {
-        builder.add_run(run);
-    }
-
     float start_x = cursor.x - (metrics.inset_left + metrics.marker_offset);
-    auto lines = builder.layout(wrap_width, start_x);
+    const auto& lines = group.lines_for({wrap_width, start_x, metrics.content_width, text_align, break_mode});
     if (lines.empty()) {
         return result;
     }
-    align_inline_lines(lines, metrics.content_width, text_align);
 
     float base_x = metrics.inset_left + metrics.marker_offset;
     float base_y = cursor.y;
     result = apply_inline_fragments(lines, runs, base_x, base_y);
 
-    for (size_t j = group_start; j < group_end; ++j) {
+    for (size_t j = group.group_start(); j < group.group_end(); ++j) {
         if (auto p = children[j]->Inline()) {
             p.get().finalize_inline_layout();
         }
@@ -274,7 +206,19 @@ const Rect& RenderListItem::marker_rect() const {
     return m_marker ? m_marker->get_rect() : m_rect;
 }
 
+IntrinsicSizes RenderListItem::calculate_intrinsic_sizes(IGraphicsContext& context) {
+    IntrinsicSizes sizes = BlockBox::calculate_intrinsic_sizes(context);
+    const auto* style = get_computed_style();
+    if (style && style->width.has_value()) {
+        return sizes;
+    }
+    // Content sits to the right of the marker.
+    constexpr float kMarkerOffset = kListMarkerSizePx + kListMarkerGapPx;
+    return {sizes.min_content + kMarkerOffset, sizes.max_content + kMarkerOffset};
+}
+
 void RenderListItem::layout(IGraphicsContext& context, const Rect& bounds) {
+    HB_TRACE_ZONE("layout", "RenderListItem::layout");
     const auto* style = get_computed_style();
     LayoutMetrics metrics = compute_metrics(style, bounds, m_rect);
     LineCursor cursor{metrics.inset_left + metrics.marker_offset, metrics.inset_top, 0.0f};
@@ -297,8 +241,9 @@ void RenderListItem::layout(IGraphicsContext& context, const Rect& bounds) {
         auto align = style ? style->text_align : Css::ComputedStyle::TextAlign::Left;
         float wrap_width =
             (style && style->whitespace == Css::ComputedStyle::WhiteSpace::NoWrap) ? 0.0f : metrics.content_width;
+        LineBreakMode break_mode = line_break_mode(style);
         InlineLayoutResult inline_layout =
-            layout_inline_group(context, m_children, i, metrics, cursor, align, wrap_width);
+            layout_inline_group(context, m_inline_cache, m_children, i, metrics, cursor, align, wrap_width, break_mode);
         update_marker_for_inline(inline_layout, marker_y_set, marker_y, metrics.inset_top);
     }
 
@@ -309,6 +254,7 @@ void RenderListItem::layout(IGraphicsContext& context, const Rect& bounds) {
         Rect marker_bounds{metrics.inset_left, marker_y, kListMarkerSizePx, kListMarkerSizePx};
         m_marker->layout(context, marker_bounds);
     }
+    m_needs_layout = false;
 }
 
 void RenderListItem::paint_self(IGraphicsContext& context, const Point& offset) const {
@@ -29,6 +29,8 @@ private:
 
     explicit RenderListItem(const DOM::Node* dom_node);
 
+    IntrinsicSizes calculate_intrinsic_sizes(IGraphicsContext& context) override;
+
     const Rect& marker_rect() const;
 
     std::unique_ptr<RenderMarker> m_marker;
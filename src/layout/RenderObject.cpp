@@ -1,14 +1,52 @@
 #include "layout/RenderObject.h"
 
+#include <array>
+#include <span>
+
 #include "core/platform_api/IGraphicsContext.h"
 
 namespace Hummingbird::Layout {
 
+void RenderObject::mark_needs_layout() {
+    for (RenderObject* object = this; object; object = object->m_parent) {
+        object->m_needs_layout = true;
+        object->m_intrinsic_context = nullptr;
+        object->clear_layout_caches();
+    }
+}
+
+IntrinsicSizes RenderObject::compute_intrinsic_sizes(IGraphicsContext& context) {
+    if (m_intrinsic_context != &context) {
+        m_intrinsic_sizes = calculate_intrinsic_sizes(context);
+        m_intrinsic_context = &context;
+    }
+    return m_intrinsic_sizes;
+}
+
+IntrinsicSizes RenderObject::calculate_intrinsic_sizes(IGraphicsContext& /*context*/) {
+    return {};
+}
+
 void RenderObject::layout(IGraphicsContext& context, const Rect& bounds) {
     m_rect = bounds;
 }
 
+void RenderObject::layout_in_window(IGraphicsContext& context, const Rect& bounds, const LayoutWindow& window) {
+    m_layout_window = window;
+    m_layout_estimated = false;
+    layout(context, bounds);
+    m_layout_window = {};
+}
+
+void RenderObject::set_estimated_layout(const Rect& rect) {
+    m_rect = rect;
+    m_layout_estimated = true;
+}
+
 void RenderObject::paint(IGraphicsContext& context, const Point& offset) const {
+    if (m_layout_estimated) {
+        return;
+    }
     paint_self(context, offset);
     Point child_offset = {offset.x + m_rect.x, offset.y + m_rect.y};
     for (auto& child : m_children) {
@@ -27,21 +65,23 @@ void RenderObject::paint_self(IGraphicsContext& context, const Point& offset) co
         const auto& bw = style->border_width;
         const auto& color = style->border_color;
 
+        // One batch per box: the sides share the border color.
+        std::array<Rect, 4> sides;
+        size_t count = 0;
         if (bw.top > 0.0f) {
-            Layout::Rect top{absolute.x, absolute.y, absolute.width, bw.top};
-            context.fill_rect(top, color);
+            sides[count++] = {absolute.x, absolute.y, absolute.width, bw.top};
         }
         if (bw.bottom > 0.0f) {
-            Layout::Rect bottom{absolute.x, absolute.y + absolute.height - bw.bottom, absolute.width, bw.bottom};
-            context.fill_rect(bottom, color);
+            sides[count++] = {absolute.x, absolute.y + absolute.height - bw.bottom, absolute.width, bw.bottom};
         }
         if (bw.left > 0.0f) {
-            Layout::Rect left{absolute.x, absolute.y, bw.left, absolute.height};
-            context.fill_rect(left, color);
+            sides[count++] = {absolute.x, absolute.y, bw.left, absolute.height};
         }
         if (bw.right > 0.0f) {
-            Layout::Rect right{absolute.x + absolute.width - bw.right, absolute.y, bw.right, absolute.height};
-            context.fill_rect(right, color);
+            sides[count++] = {absolute.x + absolute.width - bw.right, absolute.y, bw.right, absolute.height};
+        }
+        if (count > 0) {
+            context.fill_rects(std::span(sides.data(), count), color);
         }
     }
 }
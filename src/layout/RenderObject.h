@@ -1,5 +1,6 @@
 #pragma once
 
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -17,6 +18,26 @@ namespace Hummingbird::Layout {
 struct InlineRun;
 struct InlineFragment;
 
+// Border-box widths of a box when laid out as narrow as it can go without overflowing (min-content) and with no
+// soft wraps at all (max-content).
+struct IntrinsicSizes {
+    float min_content = 0.0f;
+    float max_content = 0.0f;
+};
+
+// Added to a max-content width before laying out at it, so float rounding of the insets can't wrap the last run.
+constexpr float kIntrinsicLayoutSlack = 1.0f / 64.0f;
+
+// Vertical span, in a box's own coordinates, that lazy block flow has to lay out for real. Block children that
+// fall outside it and have no reusable layout get an estimated height instead (see BlockBox::layout).
+struct LayoutWindow {
+    float top = -std::numeric_limits<float>::infinity();
+    float bottom = std::numeric_limits<float>::infinity();
+
+    bool overlaps(float from, float to) const { return to > top && from < bottom; }
+    LayoutWindow relative_to(float y) const { return {top - y, bottom - y}; }
+};
+
 class RenderObject {
 public:
     virtual ~RenderObject() = default;
@@ -31,6 +52,7 @@ public:
     void append_child(std::unique_ptr<RenderObject> child) {
         child->m_parent = this;
         m_children.push_back(std::move(child));
+        mark_needs_layout();
     }
 
     const std::vector<std::unique_ptr<RenderObject>>& get_children() const { return m_children; }
@@ -39,18 +61,50 @@ public:
 
     InlineRef Inline() { return InlineRef(as_inline_participant()); }
 
+    // Containers cache measured inline runs and line layouts until something below them changes. Call this after
+    // changing anything layout depends on (content, style); it flags this object and all of its ancestors.
+    void mark_needs_layout();
+    bool needs_layout() const { return m_needs_layout; }
+
+    // Min/max-content widths, computed without laying anything out. Memoized until mark_needs_layout() or until a
+    // different context (with its own text metrics) asks.
+    IntrinsicSizes compute_intrinsic_sizes(IGraphicsContext& context);
+
     virtual void layout(IGraphicsContext& context, const Rect& bounds);
+    // Lays out with lazy block flow limited to |window|; a plain layout() call lays out everything.
+    void layout_in_window(IGraphicsContext& context, const Rect& bounds, const LayoutWindow& window);
+    // Gives the box a placeholder geometry instead of a layout. Its subtree keeps whatever geometry it had and isn't
+    // painted until the box is laid out again.
+    void set_estimated_layout(const Rect& rect);
+    bool is_layout_estimated() const { return m_layout_estimated; }
+    // True while this box or anything below it still holds an estimated height.
+    bool has_pending_layout() const { return m_layout_estimated || m_has_pending_layout; }
+    // Whether layout(context, {.., width, ..}) would only reposition the box, so it's as cheap as an estimate.
+    virtual bool has_layout_at_width(const IGraphicsContext& /*context*/, float /*width*/) const { return false; }
     virtual void paint(IGraphicsContext& context, const Point& offset) const final;
     virtual void paint_self(IGraphicsContext& context, const Point& offset) const;
 
 protected:
     explicit RenderObject(const DOM::Node* dom_node) : m_dom_node(dom_node) {}
 
+    virtual IntrinsicSizes calculate_intrinsic_sizes(IGraphicsContext& context);
+    // Drops width-independent layout caches; called on this object and each ancestor by mark_needs_layout().
+    virtual void clear_layout_caches() {}
+
     virtual IInlineParticipant* as_inline_participant() { return nullptr; }
     virtual const IInlineParticipant* as_inline_participant() const { return nullptr; }
     const DOM::Node* m_dom_node;  // Non-owning pointer
     RenderObject* m_parent = nullptr;
     std::vector<std::unique_ptr<RenderObject>> m_children;
     Rect m_rect;
+    bool m_needs_layout = true;
+    // Lazy block flow state: the window of the layout in progress, and whether a descendant was estimated.
+    LayoutWindow m_layout_window;
+    bool m_has_pending_layout = false;
+
+private:
+    bool m_layout_estimated = false;
+    IntrinsicSizes m_intrinsic_sizes;
+    const IGraphicsContext* m_intrinsic_context = nullptr;  // measured m_intrinsic_sizes; null until measured
 };
 }  // namespace Hummingbird::Layout
@@ -2,19 +2,21 @@
 
 #include <algorithm>
 #include <cctype>
-#include <cstdlib>
-#include <numeric>
+#include <charconv>
 #include <optional>
-#include <string>
 #include <string_view>
 
 #include "core/dom/Element.h"
+#include "core/utils/Trace.h"
 #include "html/HtmlAttributeNames.h"
 
 namespace Hummingbird::Layout {
 
 namespace {
-constexpr float kTableMeasureWidth = 100000.0f;
+
+// HTML clamps spans to these limits so a hostile attribute can't allocate an enormous grid.
+constexpr size_t kMaxColspan = 1000;
+constexpr size_t kMaxRowspan = 65534;
 
 struct Insets {
     float left;
@@ -23,11 +25,6 @@ struct Insets {
     float bottom;
 };
 
-struct ParsedWidth {
-    float value;
-    bool is_percent;
-};
-
 Insets compute_insets(const Css::ComputedStyle* style) {
     float padding_left = style ? style->padding.left : 0.0f;
     float padding_right = style ? style->padding.right : 0.0f;
@@ -72,301 +69,374 @@ std::optional<std::string_view> find_attribute_value(const DOM::Element& element
     return std::nullopt;
 }
 
-std::optional<size_t> parse_span_value(std::string_view value) {
-    std::string_view trimmed = trim(value);
-    if (trimmed.empty()) {
-        return std::nullopt;
-    }
-    std::string temp(trimmed);
-    char* end = nullptr;
-    long parsed = std::strtol(temp.c_str(), &end, 10);
-    if (end == temp.c_str()) {
-        return std::nullopt;
-    }
-    if (parsed < 1) {
-        parsed = 1;
-    }
-    return static_cast<size_t>(parsed);
-}
-
-size_t cell_colspan(const RenderTableCell& cell) {
-    auto* element = dynamic_cast<const DOM::Element*>(cell.get_dom_node());
+size_t parse_span_attribute(const DOM::Element* element, std::string_view name, size_t max_span) {
     if (!element) {
         return 1;
     }
-    auto attr = find_attribute_value(*element, Hummingbird::Html::AttributeNames::ColSpan);
+    auto attr = find_attribute_value(*element, name);
     if (!attr) {
         return 1;
     }
-    auto parsed = parse_span_value(*attr);
-    return parsed.value_or(1);
+    std::string_view trimmed = trim(*attr);
+    if (!trimmed.empty() && trimmed.front() == '+') {
+        trimmed.remove_prefix(1);
+    }
+    long parsed = 0;
+    auto [end, error] = std::from_chars(trimmed.data(), trimmed.data() + trimmed.size(), parsed);
+    if (error != std::errc() || parsed < 1) {
+        return 1;
+    }
+    return std::min(static_cast<size_t>(parsed), max_span);
 }
 
-std::optional<ParsedWidth> parse_width_value(std::string_view value) {
-    std::string_view trimmed = trim(value);
-    if (trimmed.empty()) {
+std::optional<TableWidthAttribute> parse_width_attribute(const DOM::Element& element) {
+    auto attr = find_attribute_value(element, Hummingbird::Html::AttributeNames::Width);
+    if (!attr) {
         return std::nullopt;
     }
-
+    std::string_view trimmed = trim(*attr);
     bool is_percent = false;
-    if (trimmed.back() == '%') {
+    if (!trimmed.empty() && trimmed.back() == '%') {
         is_percent = true;
-        trimmed.remove_suffix(1);
-        trimmed = trim(trimmed);
-        if (trimmed.empty()) {
-            return std::nullopt;
-        }
+        trimmed = trim(trimmed.substr(0, trimmed.size() - 1));
     }
-
-    std::string temp(trimmed);
-    char* end = nullptr;
-    float parsed = std::strtof(temp.c_str(), &end);
-    if (end == temp.c_str()) {
+    float parsed = 0.0f;
+    auto [end, error] = std::from_chars(trimmed.data(), trimmed.data() + trimmed.size(), parsed);
+    if (error != std::errc()) {
         return std::nullopt;
     }
-    if (parsed < 0.0f) {
-        parsed = 0.0f;
-    }
-    return ParsedWidth{parsed, is_percent};
+    return TableWidthAttribute{std::max(0.0f, parsed), is_percent};
 }
 
-float resolve_table_target_width(const DOM::Element& element, const Css::ComputedStyle* style, float available_width) {
-    if (style && style->width.has_value()) {
-        return std::max(0.0f, *style->width);
-    }
-    auto attr = find_attribute_value(element, Hummingbird::Html::AttributeNames::Width);
-    if (!attr) {
-        return 0.0f;
-    }
-    auto parsed = parse_width_value(*attr);
-    if (!parsed) {
-        return 0.0f;
-    }
-    if (parsed->is_percent) {
-        return std::max(0.0f, available_width * (parsed->value / 100.0f));
-    }
-    return parsed->value;
+float compute_available_width(const Rect& bounds, const Insets& insets) {
+    float available_width = bounds.width - insets.left - insets.right;
+    return std::max(0.0f, available_width);
 }
 
-size_t count_cells(const RenderTableRow& row) {
-    size_t count = 0;
-    for (const auto& child : row.get_children()) {
-        if (auto* cell = dynamic_cast<const RenderTableCell*>(child.get())) {
-            count += cell_colspan(*cell);
-        }
-    }
-    return count;
-}
+// Places one row's cells into the first free column slots, skipping slots still covered by rowspans from earlier
+// rows of the same section. |covered_rows[c]| counts the rows below the current one that column c is still taken in.
+void append_grid_row(TableGrid& grid, RenderTableRow& row, std::vector<size_t>& covered_rows) {
+    TableGridRow& grid_row = grid.rows.emplace_back();
+    grid_row.row = &row;
+    grid_row.first_cell = grid.cells.size();
 
-void collect_rows(const RenderObject& node, std::vector<RenderTableRow*>& rows) {
-    for (const auto& child : node.get_children()) {
-        if (auto* row = dynamic_cast<RenderTableRow*>(child.get())) {
-            rows.push_back(row);
+    size_t column = 0;
+    for (const auto& child : row.get_children()) {
+        auto* cell = dynamic_cast<RenderTableCell*>(child.get());
+        if (!cell) {
             continue;
         }
-        if (auto* section = dynamic_cast<RenderTableSection*>(child.get())) {
-            collect_rows(*section, rows);
+        while (column < covered_rows.size() && covered_rows[column] > 0) {
+            ++column;
+        }
+        auto* element = dynamic_cast<const DOM::Element*>(cell->get_dom_node());
+        TableGridCell& grid_cell = grid.cells.emplace_back();
+        grid_cell.cell = cell;
+        grid_cell.column = column;
+        grid_cell.colspan = parse_span_attribute(element, Hummingbird::Html::AttributeNames::ColSpan, kMaxColspan);
+        grid_cell.rowspan = parse_span_attribute(element, Hummingbird::Html::AttributeNames::RowSpan, kMaxRowspan);
+        column += grid_cell.colspan;
+    }
+    grid_row.cell_count = grid.cells.size() - grid_row.first_cell;
+
+    for (auto& rows : covered_rows) {
+        if (rows > 0) {
+            --rows;
         }
     }
-}
-
-float sum_widths(const std::vector<float>& widths) {
-    return std::accumulate(widths.begin(), widths.end(), 0.0f);
-}
-
-float compute_available_width(const Rect& bounds, const Insets& insets) {
-    float available_width = bounds.width - insets.left - insets.right;
-    return std::max(0.0f, available_width);
-}
-
-std::vector<RenderTableRow*> collect_table_rows(RenderTable& table) {
-    std::vector<RenderTableRow*> rows;
-    collect_rows(table, rows);
-    return rows;
-}
-
-size_t compute_column_count(const std::vector<RenderTableRow*>& rows) {
-    size_t column_count = 0;
-    for (const auto* row : rows) {
-        column_count = std::max(column_count, count_cells(*row));
+    for (size_t i = grid_row.first_cell; i < grid.cells.size(); ++i) {
+        const TableGridCell& grid_cell = grid.cells[i];
+        size_t end = grid_cell.column + grid_cell.colspan;
+        if (covered_rows.size() < end) {
+            covered_rows.resize(end, 0);
+        }
+        for (size_t c = grid_cell.column; c < end; ++c) {
+            covered_rows[c] = std::max(covered_rows[c], grid_cell.rowspan - 1);
+        }
+        grid.column_count = std::max(grid.column_count, end);
     }
-    return column_count;
 }
 
-void distribute_cell_width(std::vector<float>& column_widths, size_t col, size_t span, float width) {
-    if (column_widths.empty() || col >= column_widths.size() || span == 0) {
+// Raises the columns under a spanning cell so they add up to at least |width|, spreading the excess evenly.
+void distribute_span_width(std::vector<float>& column_widths, const TableGridCell& cell, float width) {
+    size_t end = std::min(column_widths.size(), cell.column + cell.colspan);
+    if (cell.column >= end) {
         return;
     }
-    size_t limit = std::min(column_widths.size(), col + span);
     float current_width = 0.0f;
-    for (size_t i = col; i < limit; ++i) {
+    for (size_t i = cell.column; i < end; ++i) {
         current_width += column_widths[i];
     }
     if (width <= current_width) {
         return;
     }
-    float extra = width - current_width;
-    float per_column = extra / static_cast<float>(limit - col);
-    for (size_t i = col; i < limit; ++i) {
+    float per_column = (width - current_width) / static_cast<float>(end - cell.column);
+    for (size_t i = cell.column; i < end; ++i) {
         column_widths[i] += per_column;
     }
 }
 
-std::vector<float> compute_column_widths(IGraphicsContext& context, const std::vector<RenderTableRow*>& rows,
-                                         size_t column_count) {
-    std::vector<float> column_widths(column_count, 0.0f);
-    for (auto* row : rows) {
-        size_t col = 0;
-        for (const auto& child : row->get_children()) {
-            auto* cell = dynamic_cast<RenderTableCell*>(child.get());
-            if (!cell) {
-                continue;
-            }
-            size_t span = cell_colspan(*cell);
-            if (span == 0) {
-                span = 1;
-            }
-            float width = cell->measure_intrinsic_width(context);
-            distribute_cell_width(column_widths, col, span, width);
-            col += span;
-        }
+void spread_evenly(std::vector<float>& column_widths, float extra) {
+    if (column_widths.empty() || extra <= 0.0f) {
+        return;
+    }
+    float per_column = extra / static_cast<float>(column_widths.size());
+    for (auto& width : column_widths) {
+        width += per_column;
     }
-    return column_widths;
 }
 
-float apply_target_width(std::vector<float>& column_widths, float content_width, float target_width) {
-    if (target_width <= 0.0f || target_width <= content_width) {
-        return content_width;
-    }
-    if (!column_widths.empty()) {
-        float extra = target_width - content_width;
-        float per_column = extra / static_cast<float>(column_widths.size());
-        for (auto& width : column_widths) {
-            width += per_column;
+float layout_table_children(const TableGrid& grid, IGraphicsContext& context, const Insets& insets,
+                            float content_width, std::span<const float> column_edges) {
+    float cursor_y = insets.top;
+    for (const auto& band : grid.bands) {
+        Rect band_bounds{insets.left, cursor_y, content_width, 0.0f};
+        if (band.section) {
+            band.section->layout_rows(context, band_bounds, grid, band, column_edges);
+            cursor_y += band.section->get_rect().height;
+            continue;
         }
+        const TableGridRow& grid_row = grid.rows[band.first_row];
+        grid_row.row->layout_row(context, band_bounds, grid.cells_of(grid_row), column_edges);
+        cursor_y += grid_row.row->get_rect().height;
     }
-    return target_width;
+    return cursor_y + insets.bottom;
 }
+}  // namespace
 
-float layout_table_children(RenderTable& table, IGraphicsContext& context, const Insets& insets, float content_width,
-                            const std::vector<float>& column_widths) {
-    float cursor_y = insets.top;
-    for (const auto& child : table.get_children()) {
+// The render tree below the table is classified here, once, so layout passes never type-test children or re-read
+// attributes.
+const TableGrid& RenderTable::grid() {
+    if (m_grid) {
+        return *m_grid;
+    }
+    TableGrid& grid = m_grid.emplace();
+    std::vector<size_t> covered_rows;
+    for (const auto& child : m_children) {
         if (auto* section = dynamic_cast<RenderTableSection*>(child.get())) {
-            Rect section_bounds{insets.left, cursor_y, content_width, 0.0f};
-            section->layout_rows(context, section_bounds, column_widths);
-            cursor_y += section->get_rect().height;
+            // Rowspans don't cross section boundaries.
+            covered_rows.clear();
+            TableGridBand& band = grid.bands.emplace_back();
+            band.section = section;
+            band.first_row = grid.rows.size();
+            for (const auto& section_child : section->get_children()) {
+                if (auto* row = dynamic_cast<RenderTableRow*>(section_child.get())) {
+                    append_grid_row(grid, *row, covered_rows);
+                }
+            }
+            band.row_count = grid.rows.size() - band.first_row;
+            covered_rows.clear();
             continue;
         }
         if (auto* row = dynamic_cast<RenderTableRow*>(child.get())) {
-            Rect row_bounds{insets.left, cursor_y, content_width, 0.0f};
-            row->layout_row(context, row_bounds, column_widths);
-            cursor_y += row->get_rect().height;
+            grid.bands.push_back({nullptr, grid.rows.size(), 1});
+            append_grid_row(grid, *row, covered_rows);
         }
     }
-    return cursor_y + insets.bottom;
+    if (auto* element = dynamic_cast<const DOM::Element*>(get_dom_node())) {
+        grid.width_attribute = parse_width_attribute(*element);
+    }
+    return grid;
+}
+
+// Every cell contributes its memoized min/max-content width once: single-column cells set their column's floor
+// first, then spanning cells spread whatever their span still lacks.
+const RenderTable::ColumnSizes& RenderTable::column_sizes(IGraphicsContext& context) {
+    if (m_column_sizes) {
+        return *m_column_sizes;
+    }
+    const TableGrid& table_grid = grid();
+    ColumnSizes& sizes = m_column_sizes.emplace();
+    sizes.min_content.assign(table_grid.column_count, 0.0f);
+    sizes.max_content.assign(table_grid.column_count, 0.0f);
+    for (const auto& grid_cell : table_grid.cells) {
+        if (grid_cell.colspan != 1) {
+            continue;
+        }
+        IntrinsicSizes cell_sizes = grid_cell.cell->compute_intrinsic_sizes(context);
+        sizes.min_content[grid_cell.column] = std::max(sizes.min_content[grid_cell.column], cell_sizes.min_content);
+        sizes.max_content[grid_cell.column] = std::max(sizes.max_content[grid_cell.column], cell_sizes.max_content);
+    }
+    for (const auto& grid_cell : table_grid.cells) {
+        if (grid_cell.colspan == 1) {
+            continue;
+        }
+        IntrinsicSizes cell_sizes = grid_cell.cell->compute_intrinsic_sizes(context);
+        distribute_span_width(sizes.min_content, grid_cell, cell_sizes.min_content);
+        distribute_span_width(sizes.max_content, grid_cell, cell_sizes.max_content);
+    }
+    for (size_t i = 0; i < table_grid.column_count; ++i) {
+        sizes.max_content[i] = std::max(sizes.max_content[i], sizes.min_content[i]);
+        sizes.min_total += sizes.min_content[i];
+        sizes.max_total += sizes.max_content[i];
+    }
+    return sizes;
+}
+
+float RenderTable::resolve_target_width(float available_width) {
+    const auto* style = get_computed_style();
+    if (style && style->width.has_value()) {
+        return std::max(0.0f, *style->width);
+    }
+    const auto& width_attribute = grid().width_attribute;
+    if (!width_attribute) {
+        return 0.0f;
+    }
+    if (width_attribute->is_percent) {
+        return std::max(0.0f, available_width * (width_attribute->value / 100.0f));
+    }
+    return width_attribute->value;
+}
+
+// Auto layout in a single pass over the columns. Columns get their max-content width when it fits (plus an even
+// share of any extra the table's own width asks for); otherwise each column is interpolated between its min- and
+// max-content width by the same fraction, and the table overflows only below the sum of the minimums.
+float RenderTable::compute_auto_column_widths(IGraphicsContext& context, float available_width, float target_width) {
+    const ColumnSizes& sizes = column_sizes(context);
+    float used_width = target_width > 0.0f ? target_width : std::min(available_width, sizes.max_total);
+    used_width = std::max(used_width, sizes.min_total);
+
+    if (used_width >= sizes.max_total) {
+        m_column_widths = sizes.max_content;
+        spread_evenly(m_column_widths, used_width - sizes.max_total);
+        return used_width;
+    }
+    float flexible = sizes.max_total - sizes.min_total;
+    float fraction = flexible > 0.0f ? (used_width - sizes.min_total) / flexible : 0.0f;
+    m_column_widths.resize(sizes.min_content.size());
+    for (size_t i = 0; i < m_column_widths.size(); ++i) {
+        m_column_widths[i] = sizes.min_content[i] + (sizes.max_content[i] - sizes.min_content[i]) * fraction;
+    }
+    return used_width;
+}
+
+// table-layout: fixed. Only the first row is consulted: its cells' specified widths fix their columns, and the
+// remaining columns split what is left of the table width evenly. No cell content is measured, so layout is a
+// single O(rows) pass.
+float RenderTable::compute_fixed_column_widths(float available_width, float target_width) {
+    const TableGrid& table_grid = grid();
+    m_column_widths.assign(table_grid.column_count, 0.0f);
+    std::vector<bool> specified(table_grid.column_count, false);
+    float specified_total = 0.0f;
+    if (!table_grid.rows.empty()) {
+        for (const auto& grid_cell : table_grid.cells_of(table_grid.rows.front())) {
+            const auto* style = grid_cell.cell->get_computed_style();
+            if (!style || !style->width.has_value()) {
+                continue;
+            }
+            Insets cell_insets = compute_insets(style);
+            float width = std::max(0.0f, *style->width) + cell_insets.left + cell_insets.right;
+            float per_column = width / static_cast<float>(grid_cell.colspan);
+            size_t end = std::min(table_grid.column_count, grid_cell.column + grid_cell.colspan);
+            for (size_t i = grid_cell.column; i < end; ++i) {
+                m_column_widths[i] = per_column;
+                specified[i] = true;
+                specified_total += per_column;
+            }
+        }
+    }
+
+    float used_width = std::max(target_width > 0.0f ? target_width : available_width, specified_total);
+    float remaining = used_width - specified_total;
+    size_t auto_columns = static_cast<size_t>(std::count(specified.begin(), specified.end(), false));
+    if (auto_columns == 0) {
+        spread_evenly(m_column_widths, remaining);
+    } else {
+        float per_column = remaining / static_cast<float>(auto_columns);
+        for (size_t i = 0; i < m_column_widths.size(); ++i) {
+            if (!specified[i]) {
+                m_column_widths[i] = per_column;
+            }
+        }
+    }
+    return used_width;
 }
-}  // namespace
 
 void RenderTable::layout(IGraphicsContext& context, const Rect& bounds) {
+    HB_TRACE_ZONE("layout", "RenderTable::layout");
     const auto* style = get_computed_style();
     Insets insets = compute_insets(style);
     float available_width = compute_available_width(bounds, insets);
-    auto rows = collect_table_rows(*this);
-    size_t column_count = compute_column_count(rows);
-    auto column_widths = compute_column_widths(context, rows, column_count);
-    float content_width = sum_widths(column_widths);
-    auto* element = static_cast<const DOM::Element*>(get_dom_node());
-    float target_width = resolve_table_target_width(*element, style, available_width);
-    content_width = apply_target_width(column_widths, content_width, target_width);
+    float target_width = resolve_target_width(available_width);
+    // As in browsers, fixed layout needs a definite table width; an auto-width table falls back to auto layout.
+    bool fixed = style && style->table_layout == Css::ComputedStyle::TableLayout::Fixed && target_width > 0.0f;
+    float content_width = fixed ? compute_fixed_column_widths(available_width, target_width)
+                                : compute_auto_column_widths(context, available_width, target_width);
+
+    m_column_edges.resize(m_column_widths.size() + 1);
+    m_column_edges[0] = 0.0f;
+    for (size_t i = 0; i < m_column_widths.size(); ++i) {
+        m_column_edges[i + 1] = m_column_edges[i] + m_column_widths[i];
+    }
 
     m_rect.x = bounds.x;
     m_rect.y = bounds.y;
     m_rect.width = insets.left + content_width + insets.right;
-    m_rect.height = layout_table_children(*this, context, insets, content_width, column_widths);
+    m_rect.height = layout_table_children(grid(), context, insets, content_width, m_column_edges);
+    m_needs_layout = false;
+}
+
+IntrinsicSizes RenderTable::calculate_intrinsic_sizes(IGraphicsContext& context) {
+    const auto* style = get_computed_style();
+    Insets insets = compute_insets(style);
+    float horizontal = insets.left + insets.right;
+    // Percentage widths depend on the containing block, so only fixed target widths count here.
+    float target_width = resolve_target_width(0.0f);
+    if (target_width > 0.0f && style && style->table_layout == Css::ComputedStyle::TableLayout::Fixed) {
+        return {target_width + horizontal, target_width + horizontal};
+    }
+    const ColumnSizes& sizes = column_sizes(context);
+    float min_content = std::max(sizes.min_total, target_width);
+    float max_content = std::max(sizes.max_total, target_width);
+    return {min_content + horizontal, max_content + horizontal};
 }
 
-void RenderTableSection::layout_rows(IGraphicsContext& context, const Rect& bounds,
-                                     const std::vector<float>& column_widths) {
+void RenderTable::clear_layout_caches() {
+    BlockBox::clear_layout_caches();
+    m_grid.reset();
+    m_column_sizes.reset();
+}
+
+void RenderTableSection::layout_rows(IGraphicsContext& context, const Rect& bounds, const TableGrid& grid,
+                                     const TableGridBand& band, std::span<const float> column_edges) {
     m_rect.x = bounds.x;
     m_rect.y = bounds.y;
     m_rect.width = bounds.width;
 
     float cursor_y = 0.0f;
-    for (const auto& child : m_children) {
-        auto* row = dynamic_cast<RenderTableRow*>(child.get());
-        if (!row) {
-            continue;
-        }
+    for (size_t i = band.first_row; i < band.first_row + band.row_count; ++i) {
+        const TableGridRow& grid_row = grid.rows[i];
         Rect row_bounds{0.0f, cursor_y, bounds.width, 0.0f};
-        row->layout_row(context, row_bounds, column_widths);
-        cursor_y += row->get_rect().height;
+        grid_row.row->layout_row(context, row_bounds, grid.cells_of(grid_row), column_edges);
+        cursor_y += grid_row.row->get_rect().height;
     }
 
     m_rect.height = cursor_y;
 }
 
-void RenderTableRow::layout_row(IGraphicsContext& context, const Rect& bounds,
-                                const std::vector<float>& column_widths) {
+// Cells take their x and width straight from the column edges. A rowspanning cell is laid out in its first row and
+// only reserves its columns in the rows below.
+void RenderTableRow::layout_row(IGraphicsContext& context, const Rect& bounds, std::span<const TableGridCell> cells,
+                                std::span<const float> column_edges) {
     m_rect.x = bounds.x;
     m_rect.y = bounds.y;
 
-    float cursor_x = 0.0f;
+    size_t column_count = column_edges.empty() ? 0 : column_edges.size() - 1;
+    float row_width = 0.0f;
     float row_height = 0.0f;
-    size_t col = 0;
-
-    for (const auto& child : m_children) {
-        auto* cell = dynamic_cast<RenderTableCell*>(child.get());
-        if (!cell) {
-            continue;
-        }
-        size_t span = cell_colspan(*cell);
-        if (span == 0) {
-            span = 1;
-        }
-        float cell_width = 0.0f;
-        size_t limit = std::min(column_widths.size(), col + span);
-        for (size_t i = col; i < limit; ++i) {
-            cell_width += column_widths[i];
-        }
-        Rect cell_bounds{cursor_x, 0.0f, cell_width, 0.0f};
-        cell->layout(context, cell_bounds);
-        row_height = std::max(row_height, cell->get_rect().height);
-        cursor_x += cell_width;
-        col += span;
-    }
-
-    m_rect.width = cursor_x;
+    for (const auto& grid_cell : cells) {
+        size_t start = std::min(grid_cell.column, column_count);
+        size_t end = std::min(grid_cell.column + grid_cell.colspan, column_count);
+        float cell_x = column_count > 0 ? column_edges[start] : 0.0f;
+        float cell_width = column_count > 0 ? column_edges[end] - cell_x : 0.0f;
+        Rect cell_bounds{cell_x, 0.0f, cell_width, 0.0f};
+        grid_cell.cell->layout(context, cell_bounds);
+        row_height = std::max(row_height, grid_cell.cell->get_rect().height);
+        row_width = std::max(row_width, cell_x + cell_width);
+    }
+
+    m_rect.width = row_width;
     m_rect.height = row_height;
 }
 
-float RenderTableCell::measure_intrinsic_width(IGraphicsContext& context) {
-    BlockBox::layout(context, {0.0f, 0.0f, kTableMeasureWidth, 0.0f});
-
-    const auto* style = get_computed_style();
-    float padding_left = style ? style->padding.left : 0.0f;
-    float padding_right = style ? style->padding.right : 0.0f;
-    float border_left = style ? style->border_width.left : 0.0f;
-    float border_right = style ? style->border_width.right : 0.0f;
-    float inset_left = padding_left + border_left;
-    float inset_right = padding_right + border_right;
-
-    float content_right = inset_left;
-    for (const auto& child : m_children) {
-        const auto* child_style = child->get_computed_style();
-        float margin_right = child_style ? child_style->margin.right : 0.0f;
-        float right = child->get_rect().x + child->get_rect().width + margin_right;
-        content_right = std::max(content_right, right);
-    }
-
-    float required_width = content_right + inset_right;
-    float minimum_width = inset_left + inset_right;
-    if (required_width < minimum_width) {
-        required_width = minimum_width;
-    }
-
-    m_rect.width = required_width;
-    return required_width;
-}
-
 }  // namespace Hummingbird::Layout
@@ -1,9 +1,60 @@
 #pragma once
 
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
 #include "layout/BlockBox.h"
 
 namespace Hummingbird::Layout {
 
+class RenderTableSection;
+class RenderTableRow;
+class RenderTableCell;
+
+// A cell placed in the table's column grid.
+struct TableGridCell {
+    RenderTableCell* cell = nullptr;
+    size_t column = 0;
+    size_t colspan = 1;
+    size_t rowspan = 1;
+};
+
+// A row and the range of TableGrid::cells it owns.
+struct TableGridRow {
+    RenderTableRow* row = nullptr;
+    size_t first_cell = 0;
+    size_t cell_count = 0;
+};
+
+// A direct child of the table: either a section holding |row_count| rows, or a lone row (section == nullptr).
+struct TableGridBand {
+    RenderTableSection* section = nullptr;
+    size_t first_row = 0;
+    size_t row_count = 0;
+};
+
+// The table's width="" attribute: pixels, or a percentage of the available width.
+struct TableWidthAttribute {
+    float value = 0.0f;
+    bool is_percent = false;
+};
+
+// The table's render tree classified once into rows and cells, with span and width attributes parsed and column
+// slots assigned (including slots taken by rowspans from earlier rows). Kept until the table needs layout again.
+struct TableGrid {
+    std::vector<TableGridBand> bands;
+    std::vector<TableGridRow> rows;
+    std::vector<TableGridCell> cells;
+    size_t column_count = 0;
+    std::optional<TableWidthAttribute> width_attribute;
+
+    std::span<const TableGridCell> cells_of(const TableGridRow& row) const {
+        return std::span<const TableGridCell>(cells).subspan(row.first_cell, row.cell_count);
+    }
+};
+
 class RenderTable : public BlockBox {
 public:
     static std::unique_ptr<RenderTable> create(const DOM::Node* dom_node) {
@@ -12,8 +63,31 @@ public:
 
     void layout(IGraphicsContext& context, const Rect& bounds) override;
 
+protected:
+    IntrinsicSizes calculate_intrinsic_sizes(IGraphicsContext& context) override;
+    void clear_layout_caches() override;
+
 private:
     explicit RenderTable(const DOM::Node* dom_node) : BlockBox(dom_node) {}
+
+    // Per-column min/max-content widths for auto layout; multi-column cells spread their excess over their span.
+    struct ColumnSizes {
+        std::vector<float> min_content;
+        std::vector<float> max_content;
+        float min_total = 0.0f;
+        float max_total = 0.0f;
+    };
+
+    const TableGrid& grid();
+    const ColumnSizes& column_sizes(IGraphicsContext& context);
+    float resolve_target_width(float available_width);
+    float compute_auto_column_widths(IGraphicsContext& context, float available_width, float target_width);
+    float compute_fixed_column_widths(float available_width, float target_width);
+
+    std::optional<TableGrid> m_grid;
+    std::optional<ColumnSizes> m_column_sizes;
+    std::vector<float> m_column_widths;
+    std::vector<float> m_column_edges;  // m_column_edges[i] is the x offset of column i; one extra entry at the end
 };
 
 class RenderTableSection : public BlockBox {
@@ -22,7 +96,8 @@ public:
         return std::unique_ptr<RenderTableSection>(new RenderTableSection(dom_node));
     }
 
-    void layout_rows(IGraphicsContext& context, const Rect& bounds, const std::vector<float>& column_widths);
+    void layout_rows(IGraphicsContext& context, const Rect& bounds, const TableGrid& grid, const TableGridBand& band,
+                     std::span<const float> column_edges);
 
 private:
     explicit RenderTableSection(const DOM::Node* dom_node) : BlockBox(dom_node) {}
@@ -34,7 +109,8 @@ public:
         return std::unique_ptr<RenderTableRow>(new RenderTableRow(dom_node));
     }
 
-    void layout_row(IGraphicsContext& context, const Rect& bounds, const std::vector<float>& column_widths);
+    void layout_row(IGraphicsContext& context, const Rect& bounds, std::span<const TableGridCell> cells,
+                    std::span<const float> column_edges);
 
 private:
     explicit RenderTableRow(const DOM::Node* dom_node) : BlockBox(dom_node) {}
@@ -46,8 +122,6 @@ public:
         return std::unique_ptr<RenderTableCell>(new RenderTableCell(dom_node));
     }
 
-    float measure_intrinsic_width(IGraphicsContext& context);
-
 private:
     explicit RenderTableCell(const DOM::Node* dom_node) : BlockBox(dom_node) {}
 };
@@ -1,12 +1,15 @@
 #include "layout/TextBox.h"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cctype>
+#include <span>
 
 #include "core/platform_api/IGraphicsContext.h"
 #include "core/utils/AssetPath.h"
 #include "core/utils/Log.h"
+#include "core/utils/Trace.h"
 #include "layout/InlineLineBuilder.h"
 
 namespace Hummingbird::Layout {
@@ -14,10 +17,11 @@ namespace Hummingbird::Layout {
 TextBox::TextBox(const DOM::Text* dom_node) : RenderObject(dom_node) {}
 
 namespace {
-constexpr float kInlineMeasurementWidth = 100000.0f;
 constexpr float kDefaultFontSizePx = 16.0f;
 constexpr float kUnderlineOffsetPx = 2.0f;
 constexpr float kUnderlineThicknessPx = 1.0f;
+// Fragments are handed to the context in batches of this many, from a fixed buffer so painting does not allocate.
+constexpr size_t kTextRunBatch = 64;
 
 struct Insets {
     float left;
@@ -39,86 +43,53 @@ Insets compute_insets(const Css::ComputedStyle* style) {
             padding_bottom + border_bottom};
 }
 
-// Collapse runs of whitespace to a single space; convert newlines/tabs to spaces.
-std::string collapse_whitespace(const std::string& text) {
-    std::string out;
-    out.reserve(text.size());
-    bool in_space = false;
-    for (char c : text) {
-        bool is_space = c == ' ' || c == '\n' || c == '\r' || c == '\t';
-        if (is_space) {
-            if (!in_space) {
-                out.push_back(' ');
-            }
-            in_space = true;
-        } else {
-            out.push_back(c);
-            in_space = false;
-        }
-    }
-    return out;
+bool equals_ignore_case(std::string_view a, std::string_view b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](unsigned char x, unsigned char y) {
+        return std::tolower(x) == std::tolower(y);
+    });
 }
 
-std::string resolve_text_font_path(const Css::ComputedStyle* style) {
+// Resolving an asset path touches the filesystem, so each face variant is resolved once per process.
+const std::string& resolve_text_font_path(const Css::ComputedStyle* style) {
+    static const std::array<std::string, 4> kResolvedFontPaths = {
+        Hummingbird::resolve_asset_path("assets/fonts/Roboto-Regular.ttf").string(),
+        Hummingbird::resolve_asset_path("assets/fonts/Roboto-Bold.ttf").string(),
+        Hummingbird::resolve_asset_path("assets/fonts/Roboto-Italic.ttf").string(),
+        Hummingbird::resolve_asset_path("assets/fonts/Roboto-BoldItalic.ttf").string(),
+    };
+
     bool bold = style && style->weight == Css::ComputedStyle::FontWeight::Bold;
     bool italic = style && style->style == Css::ComputedStyle::FontStyle::Italic;
-    std::string face = style ? style->font_face : std::string{};
-    std::transform(face.begin(), face.end(), face.begin(),
-                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-    bool face_supported = face.empty() || face == "roboto" || face == "sans-serif" || face == "sans serif";
+    std::string_view face = style ? std::string_view(style->font_face) : std::string_view{};
+    bool face_supported = face.empty() || equals_ignore_case(face, "roboto") ||
+                          equals_ignore_case(face, "sans-serif") || equals_ignore_case(face, "sans serif");
     if (!face_supported) {
         HB_LOG_WARN("[style] Unsupported font face '" << face << "', falling back to Roboto");
     }
-    const char* font_path = "assets/fonts/Roboto-Regular.ttf";
-    if (bold && italic) {
-        font_path = "assets/fonts/Roboto-BoldItalic.ttf";
-    } else if (bold) {
-        font_path = "assets/fonts/Roboto-Bold.ttf";
-    } else if (italic) {
-        font_path = "assets/fonts/Roboto-Italic.ttf";
-    }
-    return Hummingbird::resolve_asset_path(font_path).string();
+    return kResolvedFontPaths[(bold ? 1 : 0) + (italic ? 2 : 0)];
 }
 
-TextStyle build_text_style(const Css::ComputedStyle* style) {
-    TextStyle text_style;
+// Fills |text_style| in place so a reused TextStyle keeps its font_path capacity across layouts.
+void assign_text_style(const Css::ComputedStyle* style, TextStyle& text_style) {
     text_style.font_path = resolve_text_font_path(style);
     text_style.font_size = style ? style->font_size : kDefaultFontSizePx;
     text_style.bold = false;
     text_style.italic = false;
     text_style.monospace = style && style->font_monospace;
     text_style.color = style ? style->color : Color{0, 0, 0, 255};
-    return text_style;
 }
 
-std::vector<std::string> tokenize_text(const std::string& text) {
-    std::vector<std::string> tokens;
-    std::string current;
-    for (char c : text) {
-        if (c == ' ') {
-            if (!current.empty()) {
-                tokens.push_back(current);
-                current.clear();
-            }
-            tokens.emplace_back(" ");
-        } else {
-            current.push_back(c);
-        }
-    }
-    if (!current.empty()) {
-        tokens.push_back(current);
-    }
-    if (tokens.empty()) {
-        tokens.emplace_back(" ");
-    }
-    return tokens;
+TextStyle build_text_style(const Css::ComputedStyle* style) {
+    TextStyle text_style;
+    assign_text_style(style, text_style);
+    return text_style;
 }
 
-std::string build_rendered_text(const std::string& text, const Css::ComputedStyle* style) {
+DOM::WhitespaceMode whitespace_mode(const Css::ComputedStyle* style) {
     if (style && style->whitespace == Css::ComputedStyle::WhiteSpace::Preserve) {
-        return text;
+        return DOM::WhitespaceMode::Preserve;
     }
-    return collapse_whitespace(text);
+    return DOM::WhitespaceMode::Collapse;
 }
 
 float compute_available_width(const Css::ComputedStyle* style, const Rect& bounds, const Insets& insets) {
@@ -137,63 +108,58 @@ float compute_available_width(const Css::ComputedStyle* style, const Rect& bound
     return available_width;
 }
 
-void append_line(std::vector<std::string>& lines, float& content_width, std::string line_text, float measured_width) {
-    lines.push_back(std::move(line_text));
+void append_line(std::vector<std::string_view>& lines, float& content_width, std::string_view line_text,
+                 float measured_width) {
+    lines.push_back(line_text);
     content_width = std::max(content_width, measured_width);
 }
 
-void build_preserved_lines(IGraphicsContext& context, const std::string& text, const TextStyle& text_style,
-                           std::vector<std::string>& lines, float& content_width) {
-    // Preserve newlines; no wrapping.
-    size_t start = 0;
-    while (start < text.size()) {
-        size_t nl = text.find('\n', start);
-        std::string line = nl == std::string::npos ? text.substr(start) : text.substr(start, nl - start);
-        float w = context.measure_text(line, text_style).width;
-        append_line(lines, content_width, std::move(line), w);
-        if (nl == std::string::npos) {
-            break;
-        }
-        start = nl + 1;
+void build_preserved_lines(IGraphicsContext& context, const DOM::PreparedText& prepared, const TextStyle& text_style,
+                           std::vector<std::string_view>& lines, float& content_width) {
+    // Preserve newlines (one segment per line); no wrapping.
+    for (const auto& segment : prepared.segments) {
+        std::string_view line = prepared.slice(segment);
+        append_line(lines, content_width, line, context.measure_text(line, text_style).width);
     }
 }
 
-void build_wrapped_lines(IGraphicsContext& context, const std::string& text, const TextStyle& text_style,
-                         float available_width, std::vector<std::string>& lines, float& content_width) {
-    // Greedy wrap by tokens (words and explicit spaces) to preserve spacing around inline elements.
-    auto tokens = tokenize_text(text);
-
-    auto measure_word = [&](const std::string& w) { return context.measure_text(w, text_style).width; };
+void build_wrapped_lines(IGraphicsContext& context, const DOM::PreparedText& prepared, const TextStyle& text_style,
+                         float available_width, std::vector<std::string_view>& lines, float& content_width) {
+    // Greedy wrap by segments (words and explicit spaces) to preserve spacing around inline elements. Segments are
+    // contiguous in the prepared text, so each line is a single slice of it.
+    const std::string_view text = prepared.text;
     float space_width = context.measure_text(" ", text_style).width;
 
-    std::string line_text;
+    size_t line_start = 0;
+    size_t line_end = 0;
     float line_width = 0.0f;
-    for (const auto& tok : tokens) {
-        bool is_space = tok == " ";
-        float tok_width = is_space ? space_width : measure_word(tok);
+    for (const auto& segment : prepared.segments) {
+        float segment_width =
+            segment.is_space ? space_width : context.measure_text(prepared.slice(segment), text_style).width;
         bool would_overflow =
-            (available_width > 0.0f && line_width > 0.0f && (line_width + tok_width) > available_width);
+            (available_width > 0.0f && line_width > 0.0f && (line_width + segment_width) > available_width);
         if (would_overflow) {
-            append_line(lines, content_width, line_text, line_width);
-            line_text.clear();
+            append_line(lines, content_width, text.substr(line_start, line_end - line_start), line_width);
             line_width = 0.0f;
-            if (is_space) {
-                continue;  // drop leading space on new line
+            if (segment.is_space) {
+                line_start = line_end = segment.offset + segment.length;  // drop leading space on new line
+                continue;
             }
+            line_start = segment.offset;
         }
-        line_text += tok;
-        line_width += tok_width;
+        line_end = segment.offset + segment.length;
+        line_width += segment_width;
     }
-    append_line(lines, content_width, line_text, line_width);
+    append_line(lines, content_width, text.substr(line_start, line_end - line_start), line_width);
 }
 
-bool apply_empty_text_layout(const std::string& rendered_text, std::vector<std::string>& lines,
+bool apply_empty_text_layout(std::string_view rendered_text, std::vector<std::string_view>& lines,
                              TextMetrics& last_metrics, float& line_height, Rect& rect, const Insets& insets) {
     if (!rendered_text.empty()) {
         return false;
     }
 
-    lines.push_back("");
+    lines.emplace_back();
     last_metrics = {};
     line_height = 0.0f;
     rect.width = insets.left + insets.right;
@@ -201,7 +167,7 @@ bool apply_empty_text_layout(const std::string& rendered_text, std::vector<std::
     return true;
 }
 
-float measure_text_block(IGraphicsContext& context, const std::string& rendered_text, const TextStyle& text_style,
+float measure_text_block(IGraphicsContext& context, std::string_view rendered_text, const TextStyle& text_style,
                          TextMetrics& last_metrics) {
     last_metrics = context.measure_text(rendered_text, text_style);
     return last_metrics.height;
@@ -209,25 +175,30 @@ float measure_text_block(IGraphicsContext& context, const std::string& rendered_
 }  // namespace
 
 void TextBox::layout(IGraphicsContext& context, const Rect& bounds) {
+    HB_TRACE_ZONE("layout", "TextBox::layout");
     m_rect.x = bounds.x;
     m_rect.y = bounds.y;
+    const auto* style = get_computed_style();
+    build_lines(context, compute_available_width(style, bounds, compute_insets(style)), m_rect);
+}
 
+void TextBox::build_lines(IGraphicsContext& context, float available_width, Rect& box) {
     const auto* style = get_computed_style();
     Insets insets = compute_insets(style);
 
-    m_rendered_text = build_rendered_text(get_dom_node()->get_text(), style);
+    m_prepared = &get_dom_node()->prepared_text(whitespace_mode(style));
+    m_rendered_text = m_prepared->text;
 
     m_lines.clear();
     m_line_height = 0.0f;
 
-    if (apply_empty_text_layout(m_rendered_text, m_lines, m_last_metrics, m_line_height, m_rect, insets)) {
+    if (apply_empty_text_layout(m_rendered_text, m_lines, m_last_metrics, m_line_height, box, insets)) {
         return;
     }
 
     // Assumptions for now: monospace font selection is still hardcoded.
-    float font_size = style ? style->font_size : kDefaultFontSizePx;
-    TextStyle text_style = build_text_style(style);
-    text_style.font_size = font_size;
+    assign_text_style(style, m_text_style);
+    const TextStyle& text_style = m_text_style;
 
     if (text_style.monospace) {
         // TODO: choose real monospace fonts when available.
@@ -240,23 +211,21 @@ void TextBox::layout(IGraphicsContext& context, const Rect& bounds) {
     m_line_height = line_height;
 
     float content_width = 0.0f;
-    float available_width = compute_available_width(style, bounds, insets);
-
     if (style && style->whitespace == Css::ComputedStyle::WhiteSpace::Preserve) {
-        build_preserved_lines(context, m_rendered_text, text_style, m_lines, content_width);
+        build_preserved_lines(context, *m_prepared, text_style, m_lines, content_width);
     } else {
-        build_wrapped_lines(context, m_rendered_text, text_style, available_width, m_lines, content_width);
+        build_wrapped_lines(context, *m_prepared, text_style, available_width, m_lines, content_width);
     }
 
-    m_rect.height = static_cast<float>(m_lines.size()) * line_height + insets.top + insets.bottom;
+    box.height = static_cast<float>(m_lines.size()) * line_height + insets.top + insets.bottom;
 
     if (content_width == 0.0f) {
         content_width = m_last_metrics.width;
     }
 
-    m_rect.width = content_width + insets.left + insets.right;
-    if (m_rect.height == 0.0f) {
-        m_rect.height = line_height + insets.top + insets.bottom;
+    box.width = content_width + insets.left + insets.right;
+    if (box.height == 0.0f) {
+        box.height = line_height + insets.top + insets.bottom;
     }
 
     if (m_last_metrics.width == 0 || m_last_metrics.height == 0) {
@@ -264,47 +233,98 @@ void TextBox::layout(IGraphicsContext& context, const Rect& bounds) {
     }
 }
 
+IntrinsicSizes TextBox::calculate_intrinsic_sizes(IGraphicsContext& context) {
+    const auto* style = get_computed_style();
+    Insets insets = compute_insets(style);
+    DOM::WhitespaceMode mode = whitespace_mode(style);
+    const DOM::PreparedText& prepared = get_dom_node()->prepared_text(mode);
+    assign_text_style(style, m_text_style);
+
+    IntrinsicSizes sizes;
+    if (mode == DOM::WhitespaceMode::Preserve) {
+        // One segment per line and no wrapping: both sizes are the widest line.
+        for (const auto& segment : prepared.segments) {
+            sizes.max_content =
+                std::max(sizes.max_content, context.measure_text(prepared.slice(segment), m_text_style).width);
+        }
+        sizes.min_content = sizes.max_content;
+    } else {
+        // The runs inline layout places; a line can break at any segment boundary.
+        const std::vector<InlineRun>& runs = measure_collapsed_runs(context);
+        for (size_t i = 0; i < prepared.segments.size(); ++i) {
+            sizes.max_content += runs[i].width;
+            if (!prepared.segments[i].is_space) {
+                sizes.min_content = std::max(sizes.min_content, runs[i].width);
+            }
+        }
+        if (style && style->whitespace == Css::ComputedStyle::WhiteSpace::NoWrap) {
+            sizes.min_content = sizes.max_content;
+        }
+    }
+
+    float horizontal = insets.left + insets.right;
+    return {sizes.min_content + horizontal, sizes.max_content + horizontal};
+}
+
+const std::vector<InlineRun>& TextBox::measure_collapsed_runs(IGraphicsContext& context) {
+    if (m_inline_runs_context == &context) {
+        return m_inline_runs;
+    }
+    const DOM::PreparedText& prepared = get_dom_node()->prepared_text(DOM::WhitespaceMode::Collapse);
+    assign_text_style(get_computed_style(), m_text_style);
+    const float line_height = context.measure_text("A", m_text_style).height;
+
+    m_inline_runs.clear();
+    const auto& segments = prepared.segments;
+    if (segments.empty()) {
+        // Text that collapses to nothing still contributes a single (empty) space-width run.
+        m_inline_runs.push_back({this, 0, 0, 0, context.measure_text(" ", m_text_style).width, line_height, true});
+    }
+    m_inline_runs.reserve(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i) {
+        InlineRun run;
+        run.owner = this;
+        run.local_index = i;
+        run.text_offset = segments[i].offset;
+        run.text_length = segments[i].length;
+        run.width = context.measure_text(prepared.slice(segments[i]), m_text_style).width;
+        run.height = line_height;
+        run.collapsible_space = segments[i].is_space;
+        m_inline_runs.push_back(run);
+    }
+    m_inline_runs_context = &context;
+    return m_inline_runs;
+}
+
 void TextBox::reset_inline_layout() {
     m_fragments.clear();
     m_lines.clear();
     m_line_height = 0.0f;
-    m_inline_runs.clear();
 }
 
 void TextBox::measure_inline(IGraphicsContext& context) {
-    m_inline_runs.clear();
     const auto* style = get_computed_style();
-    const std::string& text = get_dom_node()->get_text();
     if (style && style->whitespace == Css::ComputedStyle::WhiteSpace::Preserve) {
-        layout(context, {0.0f, 0.0f, kInlineMeasurementWidth, 0.0f});
+        // Preserved text never wraps, so the whole box is one run; measure its lines without placing the box.
+        Rect measured;
+        build_lines(context, 0.0f, measured);
         InlineRun run;
         run.owner = this;
         run.local_index = 0;
-        run.text = m_rendered_text;
-        run.width = m_rect.width;
-        run.height = m_rect.height;
-        m_inline_runs.push_back(std::move(run));
+        run.text_length = static_cast<uint32_t>(m_rendered_text.size());
+        run.width = measured.width;
+        run.height = measured.height;
+        m_inline_runs.assign(1, run);
+        m_inline_runs_context = nullptr;
         return;
     }
 
-    m_rendered_text = collapse_whitespace(text);
-    auto tokens = tokenize_text(m_rendered_text);
-    TextStyle text_style = build_text_style(style);
-    float line_height = context.measure_text("A", text_style).height;
-    m_line_height = line_height;
+    m_prepared = &get_dom_node()->prepared_text(DOM::WhitespaceMode::Collapse);
+    m_rendered_text = m_prepared->text;
+    const std::vector<InlineRun>& runs = measure_collapsed_runs(context);
+    m_line_height = runs.front().height;
     m_fragments.clear();
-    m_fragments.resize(tokens.size());
-
-    m_inline_runs.reserve(tokens.size());
-    for (size_t i = 0; i < tokens.size(); ++i) {
-        InlineRun run;
-        run.owner = this;
-        run.local_index = i;
-        run.text = tokens[i];
-        run.width = context.measure_text(tokens[i], text_style).width;
-        run.height = line_height;
-        m_inline_runs.push_back(std::move(run));
-    }
+    m_fragments.resize(runs.size());
 }
 
 void TextBox::collect_inline_runs(IGraphicsContext& /*context*/, std::vector<InlineRun>& runs) {
@@ -315,7 +335,8 @@ void TextBox::apply_inline_fragment(size_t index, const InlineFragment& fragment
     if (index >= m_fragments.size()) {
         m_fragments.resize(index + 1);
     }
-    m_fragments[index].text = run.text;
+    m_fragments[index].text_offset = run.text_offset;
+    m_fragments[index].text_length = run.text_length;
     m_fragments[index].rect = fragment.rect;
     m_fragments[index].line_index = fragment.line_index;
 }
@@ -377,29 +398,44 @@ void TextBox::paint_self(IGraphicsContext& context, const Point& offset) const {
 
 void TextBox::paint_fragments(IGraphicsContext& context, const TextStyle& text_style, float absolute_x,
                               float absolute_y, float line_height, bool underline) const {
-    std::vector<float> line_widths;
+    std::array<TextRun, kTextRunBatch> runs;
+    size_t run_count = 0;
     for (const auto& frag : m_fragments) {
-        size_t line_index = frag.line_index;
-        if (line_index >= line_widths.size()) {
-            line_widths.resize(line_index + 1, 0.0f);
+        runs[run_count++] = {m_rendered_text.substr(frag.text_offset, frag.text_length), absolute_x + frag.rect.x,
+                             absolute_y + frag.rect.y};
+        if (run_count == runs.size()) {
+            context.draw_text_runs(runs, text_style);
+            run_count = 0;
         }
-        float line_right = frag.rect.x + frag.rect.width;
-        line_widths[line_index] = std::max(line_widths[line_index], line_right);
-        context.draw_text(frag.text, absolute_x + frag.rect.x, absolute_y + frag.rect.y, text_style);
+    }
+    if (run_count > 0) {
+        context.draw_text_runs(std::span(runs.data(), run_count), text_style);
     }
 
     if (!underline) {
         return;
     }
 
-    for (size_t i = 0; i < line_widths.size(); ++i) {
-        if (line_widths[i] <= 0.0f) {
-            continue;
+    // Fragments come in line order, so each line's width is known once the next line starts.
+    auto underline_line = [&](size_t line_index, float line_width) {
+        if (line_width <= 0.0f) {
+            return;
         }
-        float underline_y = absolute_y + static_cast<float>(i + 1) * line_height - kUnderlineOffsetPx;
-        Hummingbird::Layout::Rect line_rect{absolute_x, underline_y, line_widths[i], kUnderlineThicknessPx};
+        float underline_y = absolute_y + static_cast<float>(line_index + 1) * line_height - kUnderlineOffsetPx;
+        Hummingbird::Layout::Rect line_rect{absolute_x, underline_y, line_width, kUnderlineThicknessPx};
         context.fill_rect(line_rect, text_style.color);
+    };
+    size_t line_index = m_fragments.front().line_index;
+    float line_width = 0.0f;
+    for (const auto& frag : m_fragments) {
+        if (frag.line_index != line_index) {
+            underline_line(line_index, line_width);
+            line_index = frag.line_index;
+            line_width = 0.0f;
+        }
+        line_width = std::max(line_width, frag.rect.x + frag.rect.width);
     }
+    underline_line(line_index, line_width);
 }
 
 void TextBox::paint_lines(IGraphicsContext& context, const TextStyle& text_style, float absolute_x, float absolute_y,
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "core/dom/Text.h"
 #include "core/platform_api/IGraphicsContext.h"
@@ -18,7 +20,8 @@ public:
 
     void layout(IGraphicsContext& context, const Rect& bounds) override;
     void paint_self(IGraphicsContext& context, const Point& offset) const override;
-    const std::string& rendered_text() const { return m_rendered_text; }
+    // Text as laid out (whitespace collapsed unless preserved); a view into the DOM node's prepared text.
+    std::string_view rendered_text() const { return m_rendered_text; }
 
     const DOM::Text* get_dom_node() const { return static_cast<const DOM::Text*>(m_dom_node); }
 
@@ -26,6 +29,7 @@ public:
     const IInlineParticipant* as_inline_participant() const override { return this; }
 
 protected:
+    IntrinsicSizes calculate_intrinsic_sizes(IGraphicsContext& context) override;
     void reset_inline_layout() override;
     void measure_inline(IGraphicsContext& context) override;
     void collect_inline_runs(IGraphicsContext& context, std::vector<InlineRun>& runs) override;
@@ -35,25 +39,38 @@ protected:
         m_rect.x += dx;
         m_rect.y += dy;
     }
+    void clear_layout_caches() override { m_inline_runs_context = nullptr; }
 
 private:
     explicit TextBox(const DOM::Text* dom_node);
 
+    // One run per segment of the collapsed text, measured once per context for both the intrinsic pass and inline
+    // layout.
+    const std::vector<InlineRun>& measure_collapsed_runs(IGraphicsContext& context);
+
+    // Breaks the text into m_lines for |available_width| (0: no wrapping) and sets |box|'s width and height.
+    void build_lines(IGraphicsContext& context, float available_width, Rect& box);
+
     void paint_fragments(IGraphicsContext& context, const TextStyle& text_style, float absolute_x, float absolute_y,
                          float line_height, bool underline) const;
     void paint_lines(IGraphicsContext& context, const TextStyle& text_style, float absolute_x, float absolute_y,
                      bool underline) const;
 
+    // A positioned inline run; its text is m_rendered_text.substr(text_offset, text_length).
     struct TextFragment {
-        std::string text;
+        size_t text_offset = 0;
+        size_t text_length = 0;
         Rect rect;
         size_t line_index = 0;
     };
 
-    std::string m_rendered_text;
-    std::vector<std::string> m_lines;
+    const DOM::PreparedText* m_prepared = nullptr;
+    std::string_view m_rendered_text;
+    std::vector<std::string_view> m_lines;
     std::vector<TextFragment> m_fragments;
     std::vector<InlineRun> m_inline_runs;
+    TextStyle m_text_style;  // reused by layout passes to avoid rebuilding font_path
+    const IGraphicsContext* m_inline_runs_context = nullptr;  // set while m_inline_runs are collapsed-text runs
     float m_line_height = 0.0f;
     TextMetrics m_last_metrics{};
 };
@@ -2,6 +2,7 @@
 
 #include "core/dom/Element.h"
 #include "core/dom/Text.h"
+#include "core/utils/Trace.h"
 #include "html/HtmlTagNames.h"
 #include "layout/RenderFactory.h"
 #include "style/ComputedStyle.h"
@@ -128,6 +129,7 @@ std::unique_ptr<RenderObject> build_recursive(const DOM::Node* node) {
 }
 
 std::unique_ptr<RenderObject> TreeBuilder::build_impl(const DOM::Node* dom_root) {
+    HB_TRACE_ZONE("layout", "TreeBuilder::build");
     if (!dom_root) return nullptr;
 
     // Always return a render root to host visible children, even if the root DOM node itself is non-visual.
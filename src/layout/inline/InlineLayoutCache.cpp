@@ -0,0 +1,123 @@
+#include "layout/inline/InlineLayoutCache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "layout/RenderObject.h"
+
+namespace Hummingbird::Layout {
+
+namespace {
+void measure_inline_participants(IGraphicsContext& context, std::vector<std::unique_ptr<RenderObject>>& children,
+                                 size_t& i) {
+    while (i < children.size()) {
+        auto inl = children[i]->Inline();
+        if (!inl) break;
+
+        inl.get().reset_inline_layout();
+        inl.get().measure_inline(context);
+        ++i;
+    }
+}
+
+void collect_inline_runs(IGraphicsContext& context, std::vector<std::unique_ptr<RenderObject>>& children, size_t& i,
+                         std::vector<InlineRun>& runs) {
+    while (i < children.size()) {
+        auto inl = children[i]->Inline();
+        if (!inl) break;
+
+        inl.get().collect_inline_runs(context, runs);
+        ++i;
+    }
+}
+
+// Trailing collapsible spaces hang past the line, so only the fragments before them are aligned by.
+void align_inline_lines(std::vector<InlineLine>& lines, const std::vector<InlineRun>& runs, float available_width,
+                        Css::ComputedStyle::TextAlign align) {
+    if (align == Css::ComputedStyle::TextAlign::Left || available_width <= 0.0f) {
+        return;
+    }
+
+    for (auto& line : lines) {
+        size_t content_end = line.fragments.size();
+        while (content_end > 0 && runs[line.fragments[content_end - 1].run_index].collapsible_space) {
+            --content_end;
+        }
+        if (content_end == 0) {
+            continue;
+        }
+        float min_x = line.fragments.front().rect.x;
+        float max_x = line.fragments.front().rect.x + line.fragments.front().rect.width;
+        for (size_t f = 0; f < content_end; ++f) {
+            const Rect& rect = line.fragments[f].rect;
+            min_x = std::min(min_x, rect.x);
+            max_x = std::max(max_x, rect.x + rect.width);
+        }
+        float line_width = max_x - min_x;
+        if (line_width <= 0.0f || line_width >= available_width) {
+            continue;
+        }
+
+        float desired_start = 0.0f;
+        if (align == Css::ComputedStyle::TextAlign::Center) {
+            desired_start = (available_width - line_width) * 0.5f;
+        } else if (align == Css::ComputedStyle::TextAlign::Right) {
+            desired_start = available_width - line_width;
+        }
+        float shift = desired_start - min_x;
+        if (shift == 0.0f) {
+            continue;
+        }
+        for (auto& fragment : line.fragments) {
+            fragment.rect.x += shift;
+        }
+    }
+}
+}  // namespace
+
+LineBreakMode line_break_mode(const Css::ComputedStyle* style) {
+    return style && style->text_wrap == Css::ComputedStyle::TextWrap::Pretty ? LineBreakMode::Optimal
+                                                                               : LineBreakMode::Greedy;
+}
+
+const std::vector<InlineLine>& InlineGroupCache::lines_for(const LineLayoutKey& key) {
+    auto it = std::find_if(m_line_layouts.begin(), m_line_layouts.end(),
+                           [&](const LineLayout& layout) { return layout.key == key; });
+    if (it != m_line_layouts.end()) {
+        return it->lines;
+    }
+
+    InlineLineBuilder builder;
+    builder.reserve(m_runs.size());
+    for (const auto& run : m_runs) {
+        builder.add_run(run);
+    }
+    auto lines = builder.layout(key.wrap_width, key.start_x, key.mode);
+    align_inline_lines(lines, m_runs, key.align_width, key.align);
+
+    if (m_line_layouts.size() >= kMaxLineLayouts) {
+        m_line_layouts.erase(m_line_layouts.begin());
+    }
+    m_line_layouts.push_back({key, std::move(lines)});
+    return m_line_layouts.back().lines;
+}
+
+InlineGroupCache& InlineLayoutCache::measure_group(IGraphicsContext& context,
+                                                   std::vector<std::unique_ptr<RenderObject>>& children, size_t& i) {
+    auto it = std::find_if(m_groups.begin(), m_groups.end(),
+                           [&](const InlineGroupCache& group) { return group.m_group_start == i; });
+    if (it != m_groups.end()) {
+        i = it->m_group_end;
+        return *it;
+    }
+
+    InlineGroupCache& group = m_groups.emplace_back();
+    group.m_group_start = i;
+    size_t group_end = i;
+    measure_inline_participants(context, children, group_end);
+    collect_inline_runs(context, children, i, group.m_runs);
+    group.m_group_end = i;
+    return group;
+}
+
+}  // namespace Hummingbird::Layout
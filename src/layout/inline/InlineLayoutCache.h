@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "layout/InlineLineBuilder.h"
+#include "layout/inline/InlineTypes.h"
+#include "style/ComputedStyle.h"
+
+class IGraphicsContext;
+
+namespace Hummingbird::Layout {
+
+class RenderObject;
+
+// Inputs that determine the broken and aligned lines of an inline group, given its measured runs.
+struct LineLayoutKey {
+    float wrap_width = 0.0f;
+    float start_x = 0.0f;
+    float align_width = 0.0f;
+    Css::ComputedStyle::TextAlign align = Css::ComputedStyle::TextAlign::Left;
+    LineBreakMode mode = LineBreakMode::Greedy;
+
+    bool operator==(const LineLayoutKey&) const = default;
+};
+
+// The line breaker a block's text-wrap selects: total-fit for `pretty`, greedy otherwise.
+LineBreakMode line_break_mode(const Css::ComputedStyle* style);
+
+// Measured runs of one inline group (a maximal sequence of inline children) plus its line layouts for the last few
+// keys. Measurement doesn't depend on the available width, so every layout width shares it.
+class InlineGroupCache {
+public:
+    size_t group_start() const { return m_group_start; }
+    size_t group_end() const { return m_group_end; }
+    const std::vector<InlineRun>& runs() const { return m_runs; }
+
+    // Returns the lines for |key|, breaking and aligning them on a miss.
+    const std::vector<InlineLine>& lines_for(const LineLayoutKey& key);
+
+private:
+    friend class InlineLayoutCache;
+
+    static constexpr size_t kMaxLineLayouts = 4;
+
+    struct LineLayout {
+        LineLayoutKey key;
+        std::vector<InlineLine> lines;
+    };
+
+    size_t m_group_start = 0;
+    size_t m_group_end = 0;
+    std::vector<InlineRun> m_runs;
+    std::vector<LineLayout> m_line_layouts;  // most recently stored last
+};
+
+// Inline formatting state of one container, valid until the container needs layout again.
+class InlineLayoutCache {
+public:
+    void clear() { m_groups.clear(); }
+
+    // Returns the group of inline children starting at |i| and advances |i| past it. The children are measured
+    // only the first time the group is seen.
+    InlineGroupCache& measure_group(IGraphicsContext& context, std::vector<std::unique_ptr<RenderObject>>& children,
+                                    size_t& i);
+
+private:
+    std::vector<InlineGroupCache> m_groups;
+};
+
+}  // namespace Hummingbird::Layout
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <cstddef>
-#include <string>
+#include <cstdint>
 #include <vector>
 
 #include "layout/Geometry.h"
@@ -13,9 +13,13 @@ class RenderObject;  // fwd
 struct InlineRun {
     RenderObject* owner = nullptr;
     size_t local_index = 0;
-    std::string text;
+    // Text runs reference a slice of their owner's rendered text instead of copying it; zero for atomic inlines.
+    uint32_t text_offset = 0;
+    uint32_t text_length = 0;
     float width = 0.0f;
     float height = 0.0f;
+    // Collapsed white space: at the end of a line it hangs, so it takes no part in balancing or alignment.
+    bool collapsible_space = false;
 };
 
 struct InlineFragment {
@@ -0,0 +1,153 @@
+#include "platform/BlendGraphicsContext.h"
+
+#include <blend2d.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/utils/Log.h"
+#include "platform/BlendText.h"
+
+namespace {
+using Hummingbird::Layout::is_outside_viewport;
+
+BLRgba32 to_bl_color(const Color& color) {
+    return BLRgba32(color.r, color.g, color.b, color.a);
+}
+}  // namespace
+
+BlendGraphicsContext::BlendGraphicsContext(int width, int height, uint32_t raster_threads)
+    : m_context(std::make_unique<BLContext>()), m_raster_threads(raster_threads) {
+    resize(width, height);
+}
+
+BlendGraphicsContext::~BlendGraphicsContext() {
+    m_context->end();
+}
+
+void BlendGraphicsContext::resize(int width, int height) {
+    m_context->end();
+    m_width = std::max(1, width);
+    m_height = std::max(1, height);
+    m_image = std::make_unique<BLImage>(m_width, m_height, BL_FORMAT_PRGB32);
+    begin();
+    m_viewport = {0, 0, 0, 0};
+}
+
+void BlendGraphicsContext::begin() {
+    BLContextCreateInfo create_info{};
+    create_info.threadCount = m_raster_threads;
+    // Render synchronously rather than fail when the worker threads cannot be started.
+    create_info.flags = BL_CONTEXT_CREATE_FLAG_FALLBACK_TO_SYNC;
+    if (BLResult err = m_context->begin(*m_image, create_info); err != BL_SUCCESS) {
+        HB_LOG_ERROR("[platform] BLContext::begin failed (err=" << err << ")");
+    }
+}
+
+std::pair<int, int> BlendGraphicsContext::get_size() const {
+    return {m_width, m_height};
+}
+
+void BlendGraphicsContext::set_viewport(const Hummingbird::Layout::Rect& viewport) {
+    m_viewport = viewport;
+    apply_clip();
+}
+
+void BlendGraphicsContext::apply_clip() {
+    m_context->restoreClipping();
+    if (m_viewport.width > 0 && m_viewport.height > 0) {
+        // Integer clip, matching SDL_RenderSetClipRect.
+        m_context->clipToRect(BLRectI(static_cast<int>(m_viewport.x), static_cast<int>(m_viewport.y),
+                                      static_cast<int>(m_viewport.width), static_cast<int>(m_viewport.height)));
+    }
+}
+
+void BlendGraphicsContext::clear(const Color& color) {
+    // Like SDL_RenderClear: the whole surface, regardless of the clip.
+    m_context->save();
+    m_context->restoreClipping();
+    m_context->setCompOp(BL_COMP_OP_SRC_COPY);
+    m_context->setFillStyle(to_bl_color(color));
+    m_context->fillAll();
+    m_context->restore();
+}
+
+void BlendGraphicsContext::present() {
+    m_context->flush(BL_CONTEXT_FLUSH_SYNC);
+}
+
+void BlendGraphicsContext::fill_rect(const Hummingbird::Layout::Rect& rect, const Color& color) {
+    if (is_outside_viewport(m_viewport, rect)) return;
+    // Truncated to whole pixels like the SDL backend, so both produce the same edges.
+    m_context->setFillStyle(to_bl_color(color));
+    m_context->fillRect(BLRectI(static_cast<int>(rect.x), static_cast<int>(rect.y), static_cast<int>(rect.width),
+                                static_cast<int>(rect.height)));
+}
+
+void BlendGraphicsContext::fill_rects(std::span<const Hummingbird::Layout::Rect> rects, const Color& color) {
+    m_context->setFillStyle(to_bl_color(color));
+    for (const auto& rect : rects) {
+        if (is_outside_viewport(m_viewport, rect)) continue;
+        m_context->fillRect(BLRectI(static_cast<int>(rect.x), static_cast<int>(rect.y), static_cast<int>(rect.width),
+                                    static_cast<int>(rect.height)));
+    }
+}
+
+TextMetrics BlendGraphicsContext::measure_text(std::string_view text, const TextStyle& style) {
+    return measure_blend_text(text, style);
+}
+
+void BlendGraphicsContext::draw_text(std::string_view text, float x, float y, const TextStyle& style) {
+    TextMetrics metrics = measure_text(text, style);
+    if (metrics.width <= 0 || metrics.height <= 0) return;
+    if (is_outside_viewport(m_viewport, {x, y, std::ceil(metrics.width), std::ceil(metrics.height)})) return;
+
+    const BlendFontSetup* font = acquire_blend_font(style);
+    if (!font) {
+        return;
+    }
+    fill_blend_text(*m_context, BLPoint(static_cast<int>(x), static_cast<int>(y)), text, style, *font);
+}
+
+void BlendGraphicsContext::draw_text_runs(std::span<const TextRun> runs, const TextStyle& style) {
+    const BlendFontSetup* font = nullptr;
+    for (const TextRun& run : runs) {
+        TextMetrics metrics = measure_text(run.text, style);
+        if (metrics.width <= 0 || metrics.height <= 0) continue;
+        if (is_outside_viewport(m_viewport, {run.x, run.y, std::ceil(metrics.width), std::ceil(metrics.height)})) {
+            continue;
+        }
+        if (!font) {
+            font = acquire_blend_font(style);
+            if (!font) return;
+        }
+        fill_blend_text(*m_context, BLPoint(static_cast<int>(run.x), static_cast<int>(run.y)), run.text, style, *font);
+    }
+}
+
+std::vector<uint8_t> BlendGraphicsContext::encode_png() {
+    // The image can only be read once the context has let go of it.
+    m_context->end();
+
+    std::vector<uint8_t> bytes;
+    BLImageCodec codec;
+    BLArray<uint8_t> encoded;
+    if (codec.findByName("PNG") != BL_SUCCESS) {
+        HB_LOG_ERROR("[platform] Blend2D has no PNG codec");
+    } else if (BLResult err = m_image->writeToData(encoded, codec); err != BL_SUCCESS) {
+        HB_LOG_ERROR("[platform] PNG encode failed (err=" << err << ")");
+    } else {
+        bytes.assign(encoded.data(), encoded.data() + encoded.size());
+    }
+
+    begin();
+    apply_clip();
+    return bytes;
+}
+
+BlendGraphicsContext::Pixels BlendGraphicsContext::pixels() {
+    m_context->flush(BL_CONTEXT_FLUSH_SYNC);
+    BLImageData data;
+    m_image->getData(&data);
+    return {static_cast<const uint8_t*>(data.pixelData), data.stride, data.size.w, data.size.h};
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "core/platform_api/IOffscreenGraphicsContext.h"
+#include "layout/Geometry.h"
+
+// Forward declarations
+class BLImage;
+class BLContext;
+
+// Software rasterizer drawing straight into a Blend2D image in memory. Text is measured with the same Blend2D
+// helpers as SDLGraphicsContext, so a page lays out identically in a window and headless.
+//
+// With |raster_threads| > 0, Blend2D rasterizes on that many worker threads: draw calls only queue commands, and the
+// image is complete after present(). With 0, every call rasterizes on the calling thread.
+class BlendGraphicsContext : public IOffscreenGraphicsContext {
+public:
+    // The image drawn so far, as premultiplied 32-bit pixels (BGRA in memory on little-endian). Valid until the next
+    // draw call or resize().
+    struct Pixels {
+        const uint8_t* data = nullptr;
+        intptr_t stride = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    BlendGraphicsContext(int width, int height, uint32_t raster_threads = 0);
+    ~BlendGraphicsContext() override;
+
+    void set_viewport(const Hummingbird::Layout::Rect& viewport) override;
+    void clear(const Color& color) override;
+    void present() override;
+    void fill_rect(const Hummingbird::Layout::Rect& rect, const Color& color) override;
+    TextMetrics measure_text(std::string_view text, const TextStyle& style) override;
+    void draw_text(std::string_view text, float x, float y, const TextStyle& style) override;
+    // Set the fill style and look up the font once per batch.
+    void fill_rects(std::span<const Hummingbird::Layout::Rect> rects, const Color& color) override;
+    void draw_text_runs(std::span<const TextRun> runs, const TextStyle& style) override;
+
+    std::pair<int, int> get_size() const override;
+    void resize(int width, int height) override;
+    std::vector<uint8_t> encode_png() override;
+
+    // Waits for queued rendering, like present().
+    Pixels pixels();
+
+private:
+    void begin();
+    void apply_clip();
+
+    std::unique_ptr<BLImage> m_image;
+    std::unique_ptr<BLContext> m_context;
+    int m_width = 0;
+    int m_height = 0;
+    uint32_t m_raster_threads = 0;
+    Hummingbird::Layout::Rect m_viewport{0, 0, 0, 0};
+};
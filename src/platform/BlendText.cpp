@@ -0,0 +1,163 @@
+#include "platform/BlendText.h"
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "core/utils/AssetPath.h"
+#include "core/utils/Log.h"
+#include "core/utils/Trace.h"
+#include "platform/MappedFile.h"
+
+namespace {
+// Font faces are created once per process from a shared read-only mapping of the font file.
+// |file| must outlive |data|/|face|, which reference the mapped bytes without copying.
+struct CachedFontFace {
+    std::shared_ptr<const MappedFile> file;
+    BLFontData data;
+    BLFontFace face;
+};
+
+BLResult acquire_font_face(const std::string& font_path, BLFontFace& out) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, CachedFontFace> faces;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (auto it = faces.find(font_path); it != faces.end()) {
+        out = it->second.face;
+        return BL_SUCCESS;
+    }
+
+    CachedFontFace entry;
+    entry.file = MappedFileCache::instance().acquire(font_path);
+    if (!entry.file) {
+        return BL_ERROR_NOT_FOUND;
+    }
+    auto bytes = entry.file->bytes();
+    BLResult err = entry.data.createFromData(bytes.data(), bytes.size());
+    if (err == BL_SUCCESS) {
+        err = entry.face.createFromData(entry.data, 0);
+    }
+    if (err != BL_SUCCESS) {
+        return err;
+    }
+    out = entry.face;
+    faces.emplace(font_path, std::move(entry));
+    return BL_SUCCESS;
+}
+
+// Sized fonts keyed by the style's (unresolved) font path and size.
+struct FontKeyView {
+    std::string_view path;
+    float size = 0.0f;
+};
+
+struct FontKey {
+    std::string path;
+    float size = 0.0f;
+};
+
+struct FontKeyHash {
+    using is_transparent = void;
+    size_t operator()(const FontKeyView& key) const {
+        uint32_t size_bits = 0;
+        std::memcpy(&size_bits, &key.size, sizeof(size_bits));
+        return std::hash<std::string_view>{}(key.path) ^ (size_t{size_bits} * 0x9e3779b97f4a7c15ull);
+    }
+    size_t operator()(const FontKey& key) const { return (*this)(FontKeyView{key.path, key.size}); }
+};
+
+struct FontKeyEqual {
+    using is_transparent = void;
+    static FontKeyView view(const FontKeyView& key) { return key; }
+    static FontKeyView view(const FontKey& key) { return {key.path, key.size}; }
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const {
+        return view(a).path == view(b).path && view(a).size == view(b).size;
+    }
+};
+
+std::optional<BlendFontSetup> load_font(const std::string& font_path, float font_size) {
+    HB_TRACE_ZONE("font", "load_font");
+    BlendFontSetup setup;
+    BLResult err = acquire_font_face(font_path, setup.face);
+    if (err != BL_SUCCESS) {
+        HB_LOG_ERROR("[platform] Failed to load font: " << font_path << " (err=" << err << ")");
+        return std::nullopt;
+    }
+    setup.font.createFromFace(setup.face, font_size);
+    setup.metrics = setup.font.metrics();
+    return setup;
+}
+
+float compute_text_width(const BLTextMetrics& tm) {
+    float width = static_cast<float>(tm.advance.x);
+    float bbox_width = static_cast<float>(tm.boundingBox.x1 - tm.boundingBox.x0);
+    if (width <= 0 && bbox_width > 0) {
+        width = bbox_width;
+    } else if (bbox_width > width) {
+        width = bbox_width;
+    }
+    return width;
+}
+
+float compute_text_height(const BLFontMetrics& fm) {
+    return fm.ascent + fm.descent + 1.0f;  // small pad to prevent clipping
+}
+}  // namespace
+
+const BlendFontSetup* acquire_blend_font(const TextStyle& style) {
+    // A failed load is cached too, so a missing font is reported once per thread instead of once per text run.
+    thread_local std::unordered_map<FontKey, std::optional<BlendFontSetup>, FontKeyHash, FontKeyEqual> fonts;
+
+    auto it = fonts.find(FontKeyView{style.font_path, style.font_size});
+    if (it == fonts.end()) {
+        auto resolved_font = Hummingbird::resolve_asset_path(style.font_path).string();
+        it = fonts.emplace(FontKey{style.font_path, style.font_size}, load_font(resolved_font, style.font_size))
+                 .first;
+    }
+    return it->second ? &*it->second : nullptr;
+}
+
+TextMetrics measure_blend_text(std::string_view text, const TextStyle& style) {
+    if (text.empty()) {
+        return {0, 0};
+    }
+
+    const BlendFontSetup* font = acquire_blend_font(style);
+    if (!font) {
+        return {0, 0};
+    }
+
+    BLGlyphBuffer glyphBuffer;
+    glyphBuffer.setUtf8Text(text.data(), text.size());
+    font->font.shape(glyphBuffer);
+
+    BLTextMetrics tm;
+    font->font.getTextMetrics(glyphBuffer, tm);
+
+    // Prefer advance width but guard with bounding box to avoid clipping.
+    float width = compute_text_width(tm);
+
+    // Simple approximations for bold/italic when only a regular font is available.
+    if (style.bold) width += 1.0f;
+    if (style.italic) width += 1.0f;
+
+    // Use font metrics for a consistent line height with a small fudge for descenders.
+    float height = compute_text_height(font->metrics);
+    return {width, height};
+}
+
+void fill_blend_text(BLContext& context, const BLPoint& origin, std::string_view text, const TextStyle& style,
+                     const BlendFontSetup& font) {
+    context.setFillStyle(BLRgba32(style.color.r, style.color.g, style.color.b, style.color.a));
+    double baseline_y = origin.y + font.metrics.ascent;
+    context.fillUtf8Text(BLPoint(origin.x, baseline_y), font.font, text.data(), text.size());
+    if (style.bold) {
+        context.fillUtf8Text(BLPoint(origin.x + 0.5, baseline_y), font.font, text.data(), text.size());
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <blend2d.h>
+
+#include <string_view>
+
+#include "core/platform_api/IGraphicsContext.h"
+
+// Blend2D text helpers shared by every graphics context, so that windowed and headless rendering measure (and
+// therefore lay out) text identically.
+struct BlendFontSetup {
+    BLFontFace face;
+    BLFont font;
+    BLFontMetrics metrics;
+};
+
+// The font for |style|, or nullptr when it cannot be loaded. Font faces are loaded once per process and shared
+// read-only between threads; the sized fonts built from them are cached per thread, so measuring text never takes a
+// lock after the first use of a font on a thread. The pointer stays valid for the lifetime of the calling thread.
+const BlendFontSetup* acquire_blend_font(const TextStyle& style);
+
+// Layout metrics for |text|; {0, 0} when the text is empty or the font cannot be loaded.
+TextMetrics measure_blend_text(std::string_view text, const TextStyle& style);
+
+// Fills |text| with its top-left corner at |origin|, as laid out by measure_blend_text().
+void fill_blend_text(BLContext& context, const BLPoint& origin, std::string_view text, const TextStyle& style,
+                     const BlendFontSetup& font);
@@ -4,6 +4,8 @@
 
 #include <utility>
 
+#include "core/utils/Trace.h"
+
 std::atomic<int> CurlNetwork::s_instances{0};
 std::mutex CurlNetwork::s_global_mutex;
 
@@ -70,6 +72,7 @@ void CurlNetwork::get(const std::string& url, std::function<void(std::string)> c
     auto cb = std::move(callback);
 
     std::thread worker([url, cb = std::move(cb), this]() mutable {
+        HB_TRACE_THREAD_NAME("network");
         if (m_stopping.load(std::memory_order_relaxed)) {
             if (cb) cb({});
             return;
@@ -91,10 +94,15 @@ void CurlNetwork::get(const std::string& url, std::function<void(std::string)> c
         curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, 5000L);
         curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, 15000L);
 
-        CURLcode res = curl_easy_perform(curl);
+        CURLcode res;
+        {
+            HB_TRACE_ZONE("network", "CurlNetwork::fetch");
+            res = curl_easy_perform(curl);
+        }
         curl_easy_cleanup(curl);
 
         if (res != CURLE_OK) body.clear();
+        HB_TRACE_ZONE("network", "CurlNetwork::callback");
         if (cb) cb(std::move(body));
     });
 
@@ -1,22 +1,29 @@
 #include "platform/FileResourceProvider.h"
 
-#include <fstream>
-
 #include "core/utils/AssetPath.h"
 #include "core/utils/Log.h"
+#include "platform/MappedFile.h"
 
 std::optional<std::string> FileResourceProvider::load_text(std::string_view resource_id) {
+    auto view = map_resource(resource_id);
+    if (!view) {
+        return std::nullopt;
+    }
+    return std::string(view->bytes);
+}
+
+std::optional<ResourceView> FileResourceProvider::map_resource(std::string_view resource_id) {
     if (resource_id.empty()) {
         return std::nullopt;
     }
 
     auto path = Hummingbird::resolve_asset_path(resource_id);
-    std::ifstream file(path, std::ios::in | std::ios::binary);
+    auto file = MappedFileCache::instance().acquire(path);
     if (!file) {
         HB_LOG_WARN("[resource] missing text file: " << path.string());
         return std::nullopt;
     }
 
-    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-    return contents;
+    std::string_view bytes = file->bytes();
+    return ResourceView{std::move(file), bytes};
 }
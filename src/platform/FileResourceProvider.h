@@ -2,7 +2,10 @@
 
 #include "core/platform_api/IResourceProvider.h"
 
+// Serves resources from disk through the process-wide MappedFileCache, so repeated loads of the same asset
+// (UA stylesheet, fonts, local CSS) share one read-only mapping.
 class FileResourceProvider : public IResourceProvider {
 public:
     std::optional<std::string> load_text(std::string_view resource_id) override;
+    std::optional<ResourceView> map_resource(std::string_view resource_id) override;
 };
@@ -0,0 +1,58 @@
+#include "platform/HeadlessWindow.h"
+
+#include <chrono>
+#include <thread>
+
+#include "platform/BlendGraphicsContext.h"
+
+HeadlessWindow::HeadlessWindow(int width, int height) : m_width(width), m_height(height) {}
+
+void HeadlessWindow::open() {
+    m_is_open = true;
+}
+
+void HeadlessWindow::update() {}
+
+void HeadlessWindow::close() {
+    m_is_open = false;
+}
+
+bool HeadlessWindow::is_open() const {
+    return m_is_open;
+}
+
+bool HeadlessWindow::wait_event(InputEvent& out, int timeout_ms) {
+    if (poll_event(out)) return true;
+    // Nothing else can deliver events, so waiting is just the timeout; this keeps frame loops from spinning.
+    if (timeout_ms > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+    }
+    return false;
+}
+
+bool HeadlessWindow::poll_event(InputEvent& out) {
+    if (m_events.empty()) return false;
+    out = m_events.front();
+    m_events.pop_front();
+    if (out.type == EventType::Resize) {
+        m_width = out.resize.width;
+        m_height = out.resize.height;
+    }
+    return true;
+}
+
+void HeadlessWindow::start_text_input() {}
+
+void HeadlessWindow::stop_text_input() {}
+
+std::unique_ptr<IGraphicsContext> HeadlessWindow::get_graphics_context() {
+    return std::make_unique<BlendGraphicsContext>(m_width, m_height);
+}
+
+std::pair<int, int> HeadlessWindow::get_size() const {
+    return {m_width, m_height};
+}
+
+void HeadlessWindow::push_event(const InputEvent& event) {
+    m_events.push_back(event);
+}
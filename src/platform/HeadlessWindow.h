@@ -0,0 +1,36 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+
+#include "core/platform_api/IWindow.h"
+
+// IWindow with no display behind it. Graphics contexts render into memory (see BlendGraphicsContext); input only
+// arrives through push_event(), which lets tests and batch tools script the app.
+class HeadlessWindow : public IWindow {
+public:
+    HeadlessWindow(int width, int height);
+    ~HeadlessWindow() override = default;
+
+    void open() override;
+    void update() override;
+    void close() override;
+    bool is_open() const override;
+
+    bool wait_event(InputEvent& out, int timeout_ms) override;
+    bool poll_event(InputEvent& out) override;
+    void start_text_input() override;
+    void stop_text_input() override;
+
+    std::unique_ptr<IGraphicsContext> get_graphics_context() override;
+    std::pair<int, int> get_size() const override;
+
+    // Queues an event for the next poll. Resize events also change the reported window size.
+    void push_event(const InputEvent& event);
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+    bool m_is_open = false;
+    std::deque<InputEvent> m_events;
+};
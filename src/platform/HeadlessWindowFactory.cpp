@@ -0,0 +1,12 @@
+#include "core/platform_api/WindowFactory.h"
+#include "platform/BlendGraphicsContext.h"
+#include "platform/HeadlessWindow.h"
+
+std::unique_ptr<IWindow> create_headless_window(int width, int height) {
+    return std::make_unique<HeadlessWindow>(width, height);
+}
+
+std::unique_ptr<IOffscreenGraphicsContext> create_offscreen_graphics_context(int width, int height,
+                                                                             uint32_t raster_threads) {
+    return std::make_unique<BlendGraphicsContext>(width, height, raster_threads);
+}
@@ -0,0 +1,148 @@
+#include "platform/MappedFile.h"
+
+#include <system_error>
+
+#include "core/utils/Log.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+std::shared_ptr<const MappedFile> MappedFile::open(const std::filesystem::path& path) {
+    std::shared_ptr<MappedFile> file(new MappedFile());
+
+#ifdef _WIN32
+    HANDLE handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(handle, &size)) {
+        CloseHandle(handle);
+        return nullptr;
+    }
+    if (size.QuadPart == 0) {
+        CloseHandle(handle);
+        return file;
+    }
+    HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(handle);
+    if (!mapping) {
+        return nullptr;
+    }
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        return nullptr;
+    }
+    file->m_mapping_handle = mapping;
+    file->m_data = data;
+    file->m_size = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return nullptr;
+    }
+    if (st.st_size == 0) {
+        ::close(fd);
+        return file;
+    }
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping stays valid after the descriptor is closed.
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+    file->m_data = data;
+    file->m_size = static_cast<size_t>(st.st_size);
+#endif
+
+    return file;
+}
+
+MappedFile::~MappedFile() {
+    if (!m_data) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_mapping_handle));
+#else
+    munmap(const_cast<void*>(m_data), m_size);
+#endif
+}
+
+MappedFileCache& MappedFileCache::instance() {
+    static MappedFileCache cache;
+    return cache;
+}
+
+std::shared_ptr<const MappedFile> MappedFileCache::acquire(const std::filesystem::path& path) {
+    std::error_code ec;
+    auto file_size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return nullptr;
+    }
+    auto write_time = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return nullptr;
+    }
+
+    std::string key = path.lexically_normal().string();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto it = m_entries.find(key); it != m_entries.end()) {
+        if (it->second.file_size == file_size && it->second.write_time == write_time) {
+            touch(it->second);
+            return it->second.file;
+        }
+        // Stale mapping: the file changed on disk. Existing holders keep their old view alive.
+        m_lru.erase(it->second.lru_it);
+        m_entries.erase(it);
+    }
+
+    auto file = MappedFile::open(path);
+    if (!file) {
+        HB_LOG_WARN("[resource] failed to map file: " << key);
+        return nullptr;
+    }
+
+    m_lru.push_front(key);
+    m_entries.emplace(key, Entry{file, file_size, write_time, m_lru.begin()});
+    evict_if_needed();
+    return file;
+}
+
+void MappedFileCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_lru.clear();
+}
+
+size_t MappedFileCache::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+void MappedFileCache::touch(Entry& entry) {
+    m_lru.splice(m_lru.begin(), m_lru, entry.lru_it);
+}
+
+void MappedFileCache::evict_if_needed() {
+    while (m_entries.size() > kMaxEntries) {
+        m_entries.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Read-only memory mapping of a whole file. Empty files are represented without a mapping.
+class MappedFile {
+public:
+    static std::shared_ptr<const MappedFile> open(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view bytes() const { return {static_cast<const char*>(m_data), m_size}; }
+
+private:
+    MappedFile() = default;
+
+    const void* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    void* m_mapping_handle = nullptr;
+#endif
+};
+
+// Process-wide cache of mapped files so shared assets (UA stylesheet, fonts, local CSS) are mapped once and
+// reused across documents. Entries are revalidated against the file's size and mtime on every lookup.
+class MappedFileCache {
+public:
+    static MappedFileCache& instance();
+
+    // Returns the cached mapping for |path|, mapping it on first use. Returns nullptr if the file can't be mapped.
+    std::shared_ptr<const MappedFile> acquire(const std::filesystem::path& path);
+    void clear();
+    size_t size() const;
+
+private:
+    static constexpr size_t kMaxEntries = 32;
+
+    struct Entry {
+        std::shared_ptr<const MappedFile> file;
+        std::uintmax_t file_size = 0;
+        std::filesystem::file_time_type write_time;
+        std::list<std::string>::iterator lru_it;
+    };
+
+    void touch(Entry& entry);
+    void evict_if_needed();
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_entries;
+    std::list<std::string> m_lru;  // front = most recently used
+};
@@ -3,47 +3,20 @@
 #include <SDL.h>
 #include <blend2d.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <span>
 
-#include "core/utils/AssetPath.h"
 #include "core/utils/Log.h"
+#include "platform/BlendText.h"
 
 namespace {
-struct FontSetup {
-    BLFontFace face;
-    BLFont font;
-    BLFontMetrics metrics;
-};
-
-bool load_font_setup(const std::string& font_path, float font_size, FontSetup& out, bool include_error) {
-    BLResult err = out.face.createFromFile(font_path.c_str());
-    if (err != BL_SUCCESS) {
-        if (include_error) {
-            HB_LOG_ERROR("[platform] Failed to load font: " << font_path << " (err=" << err << ")");
-        } else {
-            HB_LOG_ERROR("[platform] Failed to load font: " << font_path);
-        }
-        return false;
-    }
+using Hummingbird::Layout::is_outside_viewport;
 
-    out.font.createFromFace(out.face, font_size);
-    out.metrics = out.font.metrics();
-    return true;
-}
-
-bool is_outside_viewport(const Hummingbird::Layout::Rect& viewport, float x, float y, float width, float height) {
-    if (viewport.width <= 0 || viewport.height <= 0) {
-        return false;
-    }
-    if (y + height < viewport.y || y > viewport.y + viewport.height) {
-        return true;
-    }
-    if (x + width < viewport.x || x > viewport.x + viewport.width) {
-        return true;
-    }
-    return false;
-}
+// A text batch whose bounding box is more than this many times the area of its runs is drawn run by run: one
+// texture for a few words at opposite corners of the window would mostly upload transparent pixels.
+constexpr float kMaxTextBatchSlack = 4.0f;
 
 bool resolve_target_dimensions(const TextMetrics& metrics, int& target_width, int& target_height) {
     target_width = static_cast<int>(std::ceil(metrics.width));
@@ -51,19 +24,16 @@ bool resolve_target_dimensions(const TextMetrics& metrics, int& target_width, in
     return target_width > 0 && target_height > 0;
 }
 
-SDL_Texture* build_text_texture(SDL_Renderer* renderer, const std::string& text, const TextStyle& style,
-                                const FontSetup& font_setup, int target_width, int target_height) {
+// Rasterizes |runs|, positioned relative to the texture's top-left corner, into one texture.
+SDL_Texture* build_text_texture(SDL_Renderer* renderer, std::span<const TextRun> runs, const TextStyle& style,
+                                const BlendFontSetup& font, int target_width, int target_height) {
     BLImage img(target_width, target_height, BL_FORMAT_PRGB32);
     BLContext ctx(img);
 
     // Clear to transparent; text will be blended over the target.
     ctx.clearAll();
-
-    ctx.setFillStyle(BLRgba32(style.color.r, style.color.g, style.color.b, style.color.a));
-    double baseline_y = font_setup.metrics.ascent;  // place baseline inside the image
-    ctx.fillUtf8Text(BLPoint(0.0, baseline_y), font_setup.font, text.c_str());
-    if (style.bold) {
-        ctx.fillUtf8Text(BLPoint(0.5, baseline_y), font_setup.font, text.c_str());
+    for (const TextRun& run : runs) {
+        fill_blend_text(ctx, BLPoint(run.x, run.y), run.text, style, font);
     }
     ctx.end();
 
@@ -90,21 +60,6 @@ SDL_Texture* build_text_texture(SDL_Renderer* renderer, const std::string& text,
     SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
     return texture;
 }
-
-float compute_text_width(const BLTextMetrics& tm) {
-    float width = static_cast<float>(tm.advance.x);
-    float bbox_width = static_cast<float>(tm.boundingBox.x1 - tm.boundingBox.x0);
-    if (width <= 0 && bbox_width > 0) {
-        width = bbox_width;
-    } else if (bbox_width > width) {
-        width = bbox_width;
-    }
-    return width;
-}
-
-float compute_text_height(const BLFontMetrics& fm) {
-    return fm.ascent + fm.descent + 1.0f;  // small pad to prevent clipping
-}
 }  // namespace
 
 SDLGraphicsContext::SDLGraphicsContext(SDL_Renderer* renderer) : m_renderer(renderer) {
@@ -142,22 +97,14 @@ void SDLGraphicsContext::present() {
 
 void SDLGraphicsContext::fill_rect(const Hummingbird::Layout::Rect& rect, const Color& color) {
     if (m_renderer) {
-        // Simple viewport cull
-        if (m_viewport.width > 0 && m_viewport.height > 0) {
-            if (rect.y + rect.height < m_viewport.y || rect.y > m_viewport.y + m_viewport.height) {
-                return;
-            }
-            if (rect.x + rect.width < m_viewport.x || rect.x > m_viewport.x + m_viewport.width) {
-                return;
-            }
-        }
+        if (is_outside_viewport(m_viewport, rect)) return;
         SDL_SetRenderDrawColor(m_renderer, color.r, color.g, color.b, color.a);
         SDL_Rect sdl_rect = {(int)rect.x, (int)rect.y, (int)rect.width, (int)rect.height};
         SDL_RenderFillRect(m_renderer, &sdl_rect);
     }
 }
 
-void SDLGraphicsContext::draw_text(const std::string& text, float x, float y, const TextStyle& style) {
+void SDLGraphicsContext::draw_text(std::string_view text, float x, float y, const TextStyle& style) {
     if (!m_renderer) {
         return;
     }
@@ -170,65 +117,123 @@ void SDLGraphicsContext::draw_text(const std::string& text, float x, float y, co
         HB_LOG_DEBUG("[draw_text] measured zero size for '" << text << "'");
         return;
     }
-    if (is_outside_viewport(m_viewport, x, y, target_width, target_height)) return;
-
-    auto resolved_font = Hummingbird::resolve_asset_path(style.font_path).string();
-    FontSetup font_setup;
-    if (!load_font_setup(resolved_font, style.font_size, font_setup, false)) {
+    if (is_outside_viewport(m_viewport, {x, y, static_cast<float>(target_width), static_cast<float>(target_height)})) {
         return;
     }
 
-    SDL_Texture* texture = build_text_texture(m_renderer, text, style, font_setup, target_width, target_height);
-    if (!texture) return;
-
-    SDL_Rect dest_rect = {(int)x, (int)y, target_width, target_height};
-
     static bool logged = false;
     if (!logged) {
         HB_LOG_DEBUG("[draw_text] text='" << text << "' at (" << x << ", " << y << ") size=(" << target_width << ", "
-                                          << target_height << ") font=" << resolved_font);
+                                          << target_height << ") font=" << style.font_path);
         logged = true;
     }
 
-    SDL_RenderCopy(m_renderer, texture, NULL, &dest_rect);
+    draw_text_at(text, {(int)x, (int)y, target_width, target_height}, style);
+}
+
+void SDLGraphicsContext::draw_text_at(std::string_view text, const SDL_Rect& dest, const TextStyle& style) {
+    const BlendFontSetup* font = acquire_blend_font(style);
+    if (!font) {
+        return;
+    }
+
+    const TextRun run{text, 0.0f, 0.0f};
+    SDL_Texture* texture = build_text_texture(m_renderer, std::span(&run, 1), style, *font, dest.w, dest.h);
+    if (!texture) return;
 
+    SDL_RenderCopy(m_renderer, texture, NULL, &dest);
     SDL_DestroyTexture(texture);
 }
 
-TextMetrics SDLGraphicsContext::measure_text(const std::string& text, const TextStyle& style) {
-    if (text.empty()) {
-        return {0, 0};
+void SDLGraphicsContext::fill_rects(std::span<const Hummingbird::Layout::Rect> rects, const Color& color) {
+    if (!m_renderer) {
+        return;
     }
-
-    auto resolved_font = Hummingbird::resolve_asset_path(style.font_path).string();
-    FontSetup font_setup;
-    if (!load_font_setup(resolved_font, style.font_size, font_setup, true)) {
-        return {0, 0};
+    m_rect_batch.clear();
+    for (const auto& rect : rects) {
+        if (is_outside_viewport(m_viewport, rect)) continue;
+        m_rect_batch.push_back({(int)rect.x, (int)rect.y, (int)rect.width, (int)rect.height});
     }
+    if (m_rect_batch.empty()) return;
+    SDL_SetRenderDrawColor(m_renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRects(m_renderer, m_rect_batch.data(), static_cast<int>(m_rect_batch.size()));
+}
 
-    BLGlyphBuffer glyphBuffer;
-    glyphBuffer.setUtf8Text(text.c_str());
-    font_setup.font.shape(glyphBuffer);
+void SDLGraphicsContext::draw_text_runs(std::span<const TextRun> runs, const TextStyle& style) {
+    if (!m_renderer || runs.empty()) {
+        return;
+    }
 
-    BLTextMetrics tm;
-    font_setup.font.getTextMetrics(glyphBuffer, tm);
+    // Keep the visible runs, at whole pixels as draw_text() places them, and find their bounding box.
+    m_run_batch.clear();
+    m_run_rects.clear();
+    int left = 0;
+    int top = 0;
+    int right = 0;
+    int bottom = 0;
+    float run_area = 0.0f;
+    for (const TextRun& run : runs) {
+        int width = 0;
+        int height = 0;
+        if (!resolve_target_dimensions(measure_text(run.text, style), width, height)) continue;
+        if (is_outside_viewport(m_viewport, {run.x, run.y, static_cast<float>(width), static_cast<float>(height)})) {
+            continue;
+        }
+        const int x = (int)run.x;
+        const int y = (int)run.y;
+        if (m_run_batch.empty()) {
+            left = x;
+            top = y;
+            right = x + width;
+            bottom = y + height;
+        } else {
+            left = std::min(left, x);
+            top = std::min(top, y);
+            right = std::max(right, x + width);
+            bottom = std::max(bottom, y + height);
+        }
+        run_area += static_cast<float>(width) * static_cast<float>(height);
+        m_run_batch.push_back({run.text, static_cast<float>(x), static_cast<float>(y)});
+        m_run_rects.push_back({x, y, width, height});
+    }
+    if (m_run_batch.empty()) return;
+
+    const int batch_width = right - left;
+    const int batch_height = bottom - top;
+    if (m_run_batch.size() == 1 ||
+        static_cast<float>(batch_width) * static_cast<float>(batch_height) > kMaxTextBatchSlack * run_area) {
+        for (size_t i = 0; i < m_run_batch.size(); ++i) {
+            draw_text_at(m_run_batch[i].text, m_run_rects[i], style);
+        }
+        return;
+    }
 
-    // Prefer advance width but guard with bounding box to avoid clipping.
-    float width = compute_text_width(tm);
+    const BlendFontSetup* font = acquire_blend_font(style);
+    if (!font) {
+        return;
+    }
+    for (TextRun& run : m_run_batch) {
+        run.x -= static_cast<float>(left);
+        run.y -= static_cast<float>(top);
+    }
+    SDL_Texture* texture = build_text_texture(m_renderer, m_run_batch, style, *font, batch_width, batch_height);
+    if (!texture) return;
 
-    // Simple approximations for bold/italic when only a regular font is available.
-    if (style.bold) width += 1.0f;
-    if (style.italic) width += 1.0f;
+    SDL_Rect dest_rect = {left, top, batch_width, batch_height};
+    SDL_RenderCopy(m_renderer, texture, NULL, &dest_rect);
+    SDL_DestroyTexture(texture);
+}
 
-    // Use font metrics for a consistent line height with a small fudge for descenders.
-    float height = compute_text_height(font_setup.metrics);
+TextMetrics SDLGraphicsContext::measure_text(std::string_view text, const TextStyle& style) {
+    TextMetrics metrics = measure_blend_text(text, style);
 
-    static bool logged = false;
-    if (!logged) {
-        HB_LOG_DEBUG("[measure_text] path=" << resolved_font << " text='" << text << "' size=" << style.font_size
-                                            << " -> (" << width << ", " << height << ")");
-        logged = true;
+    // Called from the layout thread as well as the main thread.
+    // Checked before the exchange so the common path is a shared read, not a write every thread contends on.
+    static std::atomic<bool> logged{false};
+    if (!logged.load(std::memory_order_relaxed) && !logged.exchange(true, std::memory_order_relaxed)) {
+        HB_LOG_DEBUG("[measure_text] font=" << style.font_path << " text='" << text << "' size=" << style.font_size
+                                            << " -> (" << metrics.width << ", " << metrics.height << ")");
     }
 
-    return {width, height};
+    return metrics;
 }
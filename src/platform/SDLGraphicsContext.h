@@ -1,12 +1,15 @@
 #pragma once
 
+#include <span>
 #include <string>
+#include <vector>
 
 #include "core/platform_api/IGraphicsContext.h"
 #include "layout/RenderObject.h"
 
-// Forward declaration
+// Forward declarations
 struct SDL_Renderer;
+struct SDL_Rect;
 
 class SDLGraphicsContext : public IGraphicsContext {
 public:
@@ -17,10 +20,23 @@ public:
     void clear(const Color& color) override;
     void present() override;
     void fill_rect(const Hummingbird::Layout::Rect& rect, const Color& color) override;
-    TextMetrics measure_text(const std::string& text, const TextStyle& style) override;
-    void draw_text(const std::string& text, float x, float y, const TextStyle& style) override;
+    TextMetrics measure_text(std::string_view text, const TextStyle& style) override;
+    void draw_text(std::string_view text, float x, float y, const TextStyle& style) override;
+
+    // One SDL_RenderFillRects call per batch.
+    void fill_rects(std::span<const Hummingbird::Layout::Rect> rects, const Color& color) override;
+    // Rasterizes the visible runs into one texture and copies it once, rather than a texture per run; runs spread
+    // too thinly over their bounding box are drawn one at a time instead.
+    void draw_text_runs(std::span<const TextRun> runs, const TextStyle& style) override;
 
 private:
+    // Rasterizes |text| into |dest|, whose size the caller has already measured and culled.
+    void draw_text_at(std::string_view text, const SDL_Rect& dest, const TextStyle& style);
+
     SDL_Renderer* m_renderer = nullptr;
     Hummingbird::Layout::Rect m_viewport{0, 0, 0, 0};
+    // Batch scratch, kept for its capacity.
+    std::vector<SDL_Rect> m_rect_batch;
+    std::vector<TextRun> m_run_batch;
+    std::vector<SDL_Rect> m_run_rects;  // where each run of m_run_batch lands, at whole pixels
 };
@@ -0,0 +1,84 @@
+#include "platform/SDLSoftwareGraphicsContext.h"
+
+#include <SDL.h>
+
+#include <utility>
+
+#include "core/utils/Log.h"
+
+SDLSoftwareGraphicsContext::SDLSoftwareGraphicsContext(SDL_Renderer* renderer, uint32_t raster_threads)
+    : m_renderer(renderer), m_framebuffer(1, 1, raster_threads) {
+    match_output_size();
+}
+
+SDLSoftwareGraphicsContext::~SDLSoftwareGraphicsContext() {
+    if (m_texture) {
+        SDL_DestroyTexture(m_texture);
+    }
+}
+
+void SDLSoftwareGraphicsContext::match_output_size() {
+    if (!m_renderer) return;
+    int width = 0;
+    int height = 0;
+    if (SDL_GetRendererOutputSize(m_renderer, &width, &height) != 0 || width <= 0 || height <= 0) return;
+    if (m_framebuffer.get_size() != std::make_pair(width, height)) {
+        // Resetting the clip along with the surface; set_viewport() restores it.
+        m_framebuffer.resize(width, height);
+    }
+}
+
+void SDLSoftwareGraphicsContext::set_viewport(const Hummingbird::Layout::Rect& viewport) {
+    match_output_size();
+    m_framebuffer.set_viewport(viewport);
+}
+
+void SDLSoftwareGraphicsContext::clear(const Color& color) {
+    match_output_size();
+    m_framebuffer.clear(color);
+}
+
+void SDLSoftwareGraphicsContext::present() {
+    if (!m_renderer) return;
+    const BlendGraphicsContext::Pixels pixels = m_framebuffer.pixels();
+    if (!m_texture || m_texture_width != pixels.width || m_texture_height != pixels.height) {
+        if (m_texture) SDL_DestroyTexture(m_texture);
+        // PRGB32 is premultiplied BGRA in memory, which SDL calls ARGB8888 on little-endian. Every frame starts with
+        // an opaque clear, so the texture is copied without blending.
+        m_texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, pixels.width,
+                                      pixels.height);
+        if (!m_texture) {
+            HB_LOG_ERROR("[platform] SDL_CreateTexture (streaming) failed: " << SDL_GetError());
+            m_texture_width = 0;
+            m_texture_height = 0;
+            return;
+        }
+        SDL_SetTextureBlendMode(m_texture, SDL_BLENDMODE_NONE);
+        m_texture_width = pixels.width;
+        m_texture_height = pixels.height;
+    }
+    SDL_UpdateTexture(m_texture, nullptr, pixels.data, static_cast<int>(pixels.stride));
+    SDL_RenderCopy(m_renderer, m_texture, nullptr, nullptr);
+    SDL_RenderPresent(m_renderer);
+}
+
+void SDLSoftwareGraphicsContext::fill_rect(const Hummingbird::Layout::Rect& rect, const Color& color) {
+    m_framebuffer.fill_rect(rect, color);
+}
+
+TextMetrics SDLSoftwareGraphicsContext::measure_text(std::string_view text, const TextStyle& style) {
+    // Drawing state is not touched, so this stays safe to call from the layout thread.
+    return m_framebuffer.measure_text(text, style);
+}
+
+void SDLSoftwareGraphicsContext::draw_text(std::string_view text, float x, float y, const TextStyle& style) {
+    m_framebuffer.draw_text(text, x, y, style);
+}
+
+void SDLSoftwareGraphicsContext::fill_rects(std::span<const Hummingbird::Layout::Rect> rects, const Color& color) {
+    m_framebuffer.fill_rects(rects, color);
+}
+
+void SDLSoftwareGraphicsContext::draw_text_runs(std::span<const TextRun> runs, const TextStyle& style) {
+    m_framebuffer.draw_text_runs(runs, style);
+}
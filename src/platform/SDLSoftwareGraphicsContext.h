@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "core/platform_api/IGraphicsContext.h"
+#include "platform/BlendGraphicsContext.h"
+
+// Forward declarations
+struct SDL_Renderer;
+struct SDL_Texture;
+
+// Paints the whole frame into one Blend2D framebuffer, rasterized on |raster_threads| worker threads (0: on the
+// calling thread), and uploads it to a streaming texture once per present(). The SDL renderer only copies that
+// texture, so drawing costs the same with or without a GPU and scales with cores instead. The framebuffer follows the
+// renderer's output size, checked at set_viewport() and clear(), which start every frame.
+class SDLSoftwareGraphicsContext : public IGraphicsContext {
+public:
+    SDLSoftwareGraphicsContext(SDL_Renderer* renderer, uint32_t raster_threads);
+    ~SDLSoftwareGraphicsContext() override;
+
+    void set_viewport(const Hummingbird::Layout::Rect& viewport) override;
+    void clear(const Color& color) override;
+    void present() override;
+    void fill_rect(const Hummingbird::Layout::Rect& rect, const Color& color) override;
+    TextMetrics measure_text(std::string_view text, const TextStyle& style) override;
+    void draw_text(std::string_view text, float x, float y, const TextStyle& style) override;
+    void fill_rects(std::span<const Hummingbird::Layout::Rect> rects, const Color& color) override;
+    void draw_text_runs(std::span<const TextRun> runs, const TextStyle& style) override;
+
+private:
+    void match_output_size();
+
+    SDL_Renderer* m_renderer = nullptr;
+    SDL_Texture* m_texture = nullptr;
+    int m_texture_width = 0;
+    int m_texture_height = 0;
+    BlendGraphicsContext m_framebuffer;
+};
@@ -4,8 +4,9 @@
 
 #include "core/utils/Log.h"
 #include "platform/SDLGraphicsContext.h"
+#include "platform/SDLSoftwareGraphicsContext.h"
 
-SDLWindow::SDLWindow() {
+SDLWindow::SDLWindow(const WindowOptions& options) : m_options(options) {
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
         HB_LOG_ERROR("[platform] SDL_Init failed: " << SDL_GetError());
     }
@@ -58,6 +59,9 @@ bool SDLWindow::is_open() const {
 }
 
 std::unique_ptr<IGraphicsContext> SDLWindow::get_graphics_context() {
+    if (m_options.raster == RasterBackend::Software) {
+        return std::make_unique<SDLSoftwareGraphicsContext>(m_renderer, m_options.raster_threads);
+    }
     return std::make_unique<SDLGraphicsContext>(m_renderer);
 }
 
@@ -91,6 +95,8 @@ static Key to_key(SDL_Keycode kc) {
             return Key::Escape;
         case SDLK_F1:
             return Key::F1;
+        case SDLK_F2:
+            return Key::F2;
         default:
             return Key::Unknown;
     }
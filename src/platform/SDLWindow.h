@@ -3,6 +3,7 @@
 #include <memory>
 
 #include "core/platform_api/IWindow.h"
+#include "core/platform_api/WindowFactory.h"
 
 // Forward declarations
 struct SDL_Window;
@@ -10,7 +11,7 @@ struct SDL_Renderer;
 
 class SDLWindow : public IWindow {
 public:
-    SDLWindow();
+    explicit SDLWindow(const WindowOptions& options = {});
     ~SDLWindow() override;
 
     void open() override;
@@ -30,6 +31,7 @@ public:
     SDL_Window* get_native_window() const { return m_window; }
 
 private:
+    WindowOptions m_options;
     SDL_Window* m_window = nullptr;
     SDL_Renderer* m_renderer = nullptr;
     bool m_is_open = false;
@@ -1,6 +1,6 @@
 #include "core/platform_api/WindowFactory.h"
 #include "platform/SDLWindow.h"
 
-std::unique_ptr<IWindow> create_window() {
-    return std::make_unique<SDLWindow>();
+std::unique_ptr<IWindow> create_window(const WindowOptions& options) {
+    return std::make_unique<SDLWindow>(options);
 }
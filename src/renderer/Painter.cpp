@@ -1,22 +1,21 @@
 #include "renderer/Painter.h"
 
+#include <vector>
+
 #include "core/platform_api/IGraphicsContext.h"
+#include "core/utils/Trace.h"
 #include "layout/RenderObject.h"
 
 namespace Hummingbird::Renderer {
 
 namespace {
 
-void draw_outline(IGraphicsContext& context, const Layout::Rect& rect, const Color& color) {
+void append_outline(std::vector<Layout::Rect>& rects, const Layout::Rect& rect) {
     constexpr float kThickness = 1.0f;
-    Layout::Rect top{rect.x, rect.y, rect.width, kThickness};
-    Layout::Rect bottom{rect.x, rect.y + rect.height - kThickness, rect.width, kThickness};
-    Layout::Rect left{rect.x, rect.y, kThickness, rect.height};
-    Layout::Rect right{rect.x + rect.width - kThickness, rect.y, kThickness, rect.height};
-    context.fill_rect(top, color);
-    context.fill_rect(bottom, color);
-    context.fill_rect(left, color);
-    context.fill_rect(right, color);
+    rects.push_back({rect.x, rect.y, rect.width, kThickness});                             // top
+    rects.push_back({rect.x, rect.y + rect.height - kThickness, rect.width, kThickness});  // bottom
+    rects.push_back({rect.x, rect.y, kThickness, rect.height});                            // left
+    rects.push_back({rect.x + rect.width - kThickness, rect.y, kThickness, rect.height});  // right
 }
 
 bool intersects(const Layout::Rect& a, const Layout::Rect& b) {
@@ -44,7 +43,8 @@ void paint_tree_culled(const Layout::RenderObject& node, IGraphicsContext& conte
     traverse_tree(
         node, offset,
         [&](const Layout::RenderObject& current, const Layout::Rect& absolute, const Layout::Point& local_offset) {
-            if (!intersects(absolute, viewport)) {
+            // Estimated boxes haven't been laid out; their subtrees may hold geometry from an older layout.
+            if (current.is_layout_estimated() || !intersects(absolute, viewport)) {
                 return false;
             }
             current.paint_self(context, local_offset);
@@ -52,19 +52,28 @@ void paint_tree_culled(const Layout::RenderObject& node, IGraphicsContext& conte
         });
 }
 
+// Outlines every box that intersects |viewport| (all of them when it has no area), in one batch: they share a color,
+// so a page of thousands of boxes costs one submission rather than four per box.
 void paint_debug_outlines(const Layout::RenderObject& node, IGraphicsContext& context, const Layout::Point& offset,
-                          const Color& color) {
+                          const Layout::Rect& viewport, const Color& color, std::vector<Layout::Rect>& rects) {
+    const bool cull = viewport.width > 0.0f && viewport.height > 0.0f;
+    rects.clear();
     traverse_tree(node, offset,
-                  [&](const Layout::RenderObject& /*current*/, const Layout::Rect& absolute,
+                  [&](const Layout::RenderObject& current, const Layout::Rect& absolute,
                       const Layout::Point& /*local_offset*/) {
-                      draw_outline(context, absolute, color);
-                      return true;
+                      if (cull && !intersects(absolute, viewport)) {
+                          return false;
+                      }
+                      append_outline(rects, absolute);
+                      return !current.is_layout_estimated();
                   });
+    context.fill_rects(rects, color);
 }
 
 }  // namespace
 
 void Painter::paint(const Layout::RenderObject& root, IGraphicsContext& context, const PaintOptions& options) {
+    HB_TRACE_ZONE("paint", "Painter::paint");
     context.set_viewport(options.viewport);
     // Start the recursive paint process from the root with scroll offset applied.
     Layout::Point offset{0, -options.scroll_y};
@@ -75,7 +84,7 @@ void Painter::paint(const Layout::RenderObject& root, IGraphicsContext& context,
     }
     if (options.debug_outlines) {
         Color outline{255, 0, 0, 100};
-        paint_debug_outlines(root, context, offset, outline);
+        paint_debug_outlines(root, context, offset, options.viewport, outline, m_outline_rects);
     }
 }
 
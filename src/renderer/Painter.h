@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "core/platform_api/IGraphicsContext.h"
 #include "layout/RenderObject.h"
 
@@ -15,6 +17,9 @@ class Painter {
 public:
     void paint(const Layout::RenderObject& root, IGraphicsContext& context,
                const PaintOptions& options = PaintOptions{});
+
+private:
+    std::vector<Layout::Rect> m_outline_rects;  // debug outline batch, kept for its capacity
 };
 
 }  // namespace Hummingbird::Renderer
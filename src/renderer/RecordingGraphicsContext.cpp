@@ -0,0 +1,275 @@
+#include "renderer/RecordingGraphicsContext.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+namespace Hummingbird::Renderer {
+
+namespace {
+static_assert(sizeof(RecordingGraphicsContext::Command) == 32, "keep recorded commands compact");
+
+// Coverage grids larger than this switch to coarser cells (a 2048x2048 surface still gets one cell per pixel).
+constexpr double kMaxCoverageCells = 4.0 * 1024 * 1024;
+
+bool same_color(const Color& a, const Color& b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+bool same_style(const TextStyle& a, const TextStyle& b) {
+    return a.font_size == b.font_size && a.bold == b.bold && a.italic == b.italic && a.monospace == b.monospace &&
+           same_color(a.color, b.color) && a.font_path == b.font_path;
+}
+
+bool same_rect(const Layout::Rect& a, const Layout::Rect& b) {
+    return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+bool has_area(const Layout::Rect& rect) {
+    return rect.width > 0.0f && rect.height > 0.0f;
+}
+
+Layout::Rect intersection(const Layout::Rect& a, const Layout::Rect& b) {
+    const float left = std::max(a.x, b.x);
+    const float top = std::max(a.y, b.y);
+    const float right = std::min(a.x + a.width, b.x + b.width);
+    const float bottom = std::min(a.y + a.height, b.y + b.height);
+    return {left, top, std::max(0.0f, right - left), std::max(0.0f, bottom - top)};
+}
+
+// Adds up how many of |rects| cover each cell with a 2D difference array: O(rects + cells) however large the rects.
+void measure_coverage(const std::vector<Layout::Rect>& rects, PaintAnalysis& analysis) {
+    if (rects.empty()) return;
+    float min_x = std::numeric_limits<float>::max();
+    float min_y = std::numeric_limits<float>::max();
+    float max_x = std::numeric_limits<float>::lowest();
+    float max_y = std::numeric_limits<float>::lowest();
+    for (const auto& rect : rects) {
+        min_x = std::min(min_x, rect.x);
+        min_y = std::min(min_y, rect.y);
+        max_x = std::max(max_x, rect.x + rect.width);
+        max_y = std::max(max_y, rect.y + rect.height);
+    }
+    const double area = static_cast<double>(max_x - min_x) * static_cast<double>(max_y - min_y);
+    const float cell = area > kMaxCoverageCells ? static_cast<float>(std::ceil(std::sqrt(area / kMaxCoverageCells)))
+                                                : 1.0f;
+    const auto columns = static_cast<size_t>(std::ceil((max_x - min_x) / cell));
+    const auto rows = static_cast<size_t>(std::ceil((max_y - min_y) / cell));
+    const size_t stride = columns + 1;
+    std::vector<int32_t> depth(stride * (rows + 1), 0);
+
+    auto to_cell = [cell](float offset, size_t limit, bool round_up) {
+        const float index = round_up ? std::ceil(offset / cell) : std::floor(offset / cell);
+        return std::min(limit, static_cast<size_t>(std::max(0.0f, index)));
+    };
+    for (const auto& rect : rects) {
+        const size_t x0 = to_cell(rect.x - min_x, columns, false);
+        const size_t x1 = to_cell(rect.x + rect.width - min_x, columns, true);
+        const size_t y0 = to_cell(rect.y - min_y, rows, false);
+        const size_t y1 = to_cell(rect.y + rect.height - min_y, rows, true);
+        ++depth[y0 * stride + x0];
+        --depth[y0 * stride + x1];
+        --depth[y1 * stride + x0];
+        ++depth[y1 * stride + x1];
+    }
+
+    uint64_t painted_cells = 0;
+    uint64_t covered_cells = 0;
+    for (size_t y = 0; y < rows; ++y) {
+        for (size_t x = 0; x < columns; ++x) {
+            int32_t& value = depth[y * stride + x];
+            if (x > 0) value += depth[y * stride + x - 1];
+            if (y > 0) value += depth[(y - 1) * stride + x];
+            if (x > 0 && y > 0) value -= depth[(y - 1) * stride + x - 1];
+            if (value > 0) {
+                painted_cells += static_cast<uint64_t>(value);
+                ++covered_cells;
+                analysis.max_depth = std::max(analysis.max_depth, static_cast<uint32_t>(value));
+            }
+        }
+    }
+    const double cell_area = static_cast<double>(cell) * static_cast<double>(cell);
+    analysis.coverage_cell_size = cell;
+    analysis.painted_area = static_cast<double>(painted_cells) * cell_area;
+    analysis.covered_area = static_cast<double>(covered_cells) * cell_area;
+}
+}  // namespace
+
+void PaintAnalysis::write_report(std::ostream& out) const {
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(2);
+    out << "commands: " << commands << " (fill_rect " << fill_rects << ", draw_text " << draw_texts
+        << ", set_viewport " << viewport_changes << ", clear " << clears << "), text bytes: " << text_bytes << "\n";
+    out << "waste: " << off_viewport_draws << " draws off the viewport, " << clipped_draws << " clipped, "
+        << empty_draws << " empty, " << redundant_viewport_changes << " redundant viewport changes\n";
+    out << "batch breaks: " << color_changes << " fill color changes, " << style_changes << " text style changes\n";
+    out << "overdraw: " << overdraw() << "x (painted " << painted_area << " px over " << covered_area
+        << " px, deepest " << max_depth << ", cell " << coverage_cell_size << " px)\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void RecordingGraphicsContext::set_viewport(const Layout::Rect& viewport) {
+    m_commands.push_back({.op = Op::SetViewport, .color = {}, .rect = viewport});
+}
+
+void RecordingGraphicsContext::clear(const Color& color) {
+    m_commands.push_back({.op = Op::Clear, .color = color, .rect = {}});
+}
+
+void RecordingGraphicsContext::present() {
+    m_commands.push_back({.op = Op::Present, .color = {}, .rect = {}});
+}
+
+void RecordingGraphicsContext::fill_rect(const Layout::Rect& rect, const Color& color) {
+    m_commands.push_back({.op = Op::FillRect, .color = color, .rect = rect});
+}
+
+TextMetrics RecordingGraphicsContext::measure_text(std::string_view text, const TextStyle& style) {
+    if (m_metrics) return m_metrics->measure_text(text, style);
+    return TextMetrics{static_cast<float>(text.size()) * style.font_size * 0.5f, style.font_size * 1.2f};
+}
+
+void RecordingGraphicsContext::draw_text(std::string_view text, float x, float y, const TextStyle& style) {
+    const TextMetrics metrics = measure_text(text, style);
+    const auto offset = static_cast<uint32_t>(m_text.size());
+    m_text.append(text);
+    m_commands.push_back({.op = Op::DrawText,
+                          .color = style.color,
+                          .style = intern_style(style),
+                          .text_offset = offset,
+                          .text_length = static_cast<uint32_t>(text.size()),
+                          .rect = {x, y, metrics.width, metrics.height}});
+}
+
+void RecordingGraphicsContext::reset() {
+    m_commands.clear();
+    m_text.clear();
+}
+
+std::string_view RecordingGraphicsContext::text(const Command& command) const {
+    return std::string_view(m_text).substr(command.text_offset, command.text_length);
+}
+
+uint16_t RecordingGraphicsContext::intern_style(const TextStyle& style) {
+    // Text runs come in long stretches of one style, so the last style used almost always matches.
+    if (!m_styles.empty() && same_style(m_styles[m_last_style], style)) return m_last_style;
+    for (size_t i = 0; i < m_styles.size(); ++i) {
+        if (same_style(m_styles[i], style)) {
+            m_last_style = static_cast<uint16_t>(i);
+            return m_last_style;
+        }
+    }
+    if (m_styles.size() > std::numeric_limits<uint16_t>::max()) {
+        throw std::length_error("RecordingGraphicsContext: too many distinct text styles");
+    }
+    m_styles.push_back(style);
+    m_last_style = static_cast<uint16_t>(m_styles.size() - 1);
+    return m_last_style;
+}
+
+void RecordingGraphicsContext::replay(IGraphicsContext& target) const {
+    // Runs of fills in one color and of text in one style are replayed through the batch calls.
+    std::vector<Layout::Rect> rects;
+    std::vector<TextRun> runs;
+    const Command* batch = nullptr;  // first command of the pending batch
+    auto flush = [&] {
+        if (!rects.empty()) target.fill_rects(rects, batch->color);
+        if (!runs.empty()) target.draw_text_runs(runs, style(*batch));
+        rects.clear();
+        runs.clear();
+        batch = nullptr;
+    };
+
+    for (const Command& command : m_commands) {
+        const bool extends_batch =
+            batch && batch->op == command.op &&
+            ((command.op == Op::FillRect && same_color(batch->color, command.color)) ||
+             (command.op == Op::DrawText && batch->style == command.style));
+        if (!extends_batch) flush();
+        switch (command.op) {
+            case Op::SetViewport:
+                target.set_viewport(command.rect);
+                break;
+            case Op::Clear:
+                target.clear(command.color);
+                break;
+            case Op::Present:
+                target.present();
+                break;
+            case Op::FillRect:
+                if (!batch) batch = &command;
+                rects.push_back(command.rect);
+                break;
+            case Op::DrawText:
+                if (!batch) batch = &command;
+                runs.push_back({text(command), command.rect.x, command.rect.y});
+                break;
+        }
+    }
+    flush();
+}
+
+PaintAnalysis RecordingGraphicsContext::analyze() const {
+    PaintAnalysis analysis;
+    analysis.commands = m_commands.size();
+    analysis.text_bytes = m_text.size();
+
+    Layout::Rect clip{0, 0, 0, 0};  // no area: unclipped, as in the backends
+    bool viewport_set = false;
+    const Command* previous_fill = nullptr;
+    const Command* previous_text = nullptr;
+    std::vector<Layout::Rect> visible;
+    visible.reserve(m_commands.size());
+
+    for (const Command& command : m_commands) {
+        switch (command.op) {
+            case Op::SetViewport:
+                ++analysis.viewport_changes;
+                if (viewport_set && same_rect(clip, command.rect)) ++analysis.redundant_viewport_changes;
+                clip = command.rect;
+                viewport_set = true;
+                continue;
+            case Op::Clear:
+                ++analysis.clears;
+                continue;
+            case Op::Present:
+                continue;
+            case Op::FillRect:
+                ++analysis.fill_rects;
+                if (previous_fill && !same_color(previous_fill->color, command.color)) ++analysis.color_changes;
+                previous_fill = &command;
+                break;
+            case Op::DrawText:
+                ++analysis.draw_texts;
+                if (previous_text && previous_text->style != command.style) ++analysis.style_changes;
+                previous_text = &command;
+                break;
+        }
+
+        if (!has_area(command.rect) || (command.op == Op::DrawText && command.text_length == 0)) {
+            ++analysis.empty_draws;
+            continue;
+        }
+        if (!has_area(clip)) {
+            visible.push_back(command.rect);
+            continue;
+        }
+        const Layout::Rect shown = intersection(command.rect, clip);
+        if (!has_area(shown)) {
+            ++analysis.off_viewport_draws;
+            continue;
+        }
+        if (!same_rect(shown, command.rect)) ++analysis.clipped_draws;
+        visible.push_back(shown);
+    }
+
+    measure_coverage(visible, analysis);
+    return analysis;
+}
+
+}  // namespace Hummingbird::Renderer
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/platform_api/IGraphicsContext.h"
+#include "layout/Geometry.h"
+
+namespace Hummingbird::Renderer {
+
+// What a recorded frame costs and wastes. Areas are in pixels, measured on a coverage grid whose cells grow for very
+// large surfaces (see coverage_cell_size), so they are exact to a cell.
+struct PaintAnalysis {
+    size_t commands = 0;
+    size_t fill_rects = 0;
+    size_t draw_texts = 0;
+    size_t viewport_changes = 0;
+    size_t clears = 0;
+    size_t text_bytes = 0;
+
+    size_t empty_draws = 0;                 // zero-area rects, empty strings
+    size_t off_viewport_draws = 0;          // entirely outside the clip: nothing reaches the screen
+    size_t clipped_draws = 0;               // partly outside the clip
+    size_t redundant_viewport_changes = 0;  // set_viewport() to the viewport already set
+    // Batch breaks: a fill_rect whose color differs from the previous fill_rect's, and likewise for text styles.
+    size_t color_changes = 0;
+    size_t style_changes = 0;
+
+    // Visible parts of all draws, text by its measured box; overdraw is painted / covered (1.0: no pixel drawn twice).
+    double painted_area = 0.0;
+    double covered_area = 0.0;
+    uint32_t max_depth = 0;  // most draws stacked on one cell
+    float coverage_cell_size = 1.0f;
+
+    double overdraw() const { return covered_area > 0.0 ? painted_area / covered_area : 0.0; }
+    void write_report(std::ostream& out) const;
+};
+
+// An IGraphicsContext that records every call into a compact command buffer instead of drawing: 32 bytes per
+// command, text bytes in one shared buffer and text styles interned in a small table. The buffer can be analyzed for
+// waste, or replayed against a real backend, which separates raster cost from the tree traversal that produced it.
+//
+// Text is measured by |metrics| when given, so layout done against the recorder matches the backend it is replayed
+// on; otherwise by a fixed heuristic (half the font size per character, lines 1.2x the font size).
+class RecordingGraphicsContext : public IGraphicsContext {
+public:
+    enum class Op : uint8_t { SetViewport, Clear, Present, FillRect, DrawText };
+
+    struct Command {
+        Op op;
+        Color color;         // FillRect, Clear; DrawText takes its color from the style
+        uint16_t style = 0;  // DrawText: index into the style table
+        uint32_t text_offset = 0;
+        uint32_t text_length = 0;
+        Layout::Rect rect;  // SetViewport, FillRect; DrawText: origin and measured size
+    };
+
+    explicit RecordingGraphicsContext(IGraphicsContext* metrics = nullptr) : m_metrics(metrics) {}
+
+    void set_viewport(const Layout::Rect& viewport) override;
+    void clear(const Color& color) override;
+    void present() override;
+    void fill_rect(const Layout::Rect& rect, const Color& color) override;
+    TextMetrics measure_text(std::string_view text, const TextStyle& style) override;
+    void draw_text(std::string_view text, float x, float y, const TextStyle& style) override;
+
+    // Drops the recorded commands, keeping buffer capacity and the style table for the next frame.
+    void reset();
+
+    const std::vector<Command>& commands() const { return m_commands; }
+    std::string_view text(const Command& command) const;
+    const TextStyle& style(const Command& command) const { return m_styles[command.style]; }
+
+    // Issues every recorded command, in order, on |target|; consecutive fills of one color and text runs of one style
+    // go through fill_rects() and draw_text_runs().
+    void replay(IGraphicsContext& target) const;
+
+    PaintAnalysis analyze() const;
+
+private:
+    uint16_t intern_style(const TextStyle& style);
+
+    IGraphicsContext* m_metrics;
+    std::vector<Command> m_commands;
+    std::string m_text;
+    std::vector<TextStyle> m_styles;
+    uint16_t m_last_style = 0;
+};
+
+}  // namespace Hummingbird::Renderer
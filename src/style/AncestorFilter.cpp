@@ -0,0 +1,101 @@
+#include "style/AncestorFilter.h"
+
+#include <limits>
+
+#include "core/dom/Element.h"
+#include "html/HtmlAttributeNames.h"
+
+namespace Hummingbird::Css {
+
+namespace {
+constexpr uint32_t kFnvOffset = 2166136261u;
+constexpr uint32_t kFnvPrime = 16777619u;
+constexpr uint8_t kSaturated = std::numeric_limits<uint8_t>::max();
+}  // namespace
+
+uint32_t selector_hash(SelectorType type, std::string_view value) {
+    uint32_t hash = kFnvOffset;
+    hash = (hash ^ static_cast<uint32_t>(type)) * kFnvPrime;
+    for (char c : value) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * kFnvPrime;
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+void compute_ancestor_hashes(Selector& selector) {
+    selector.ancestor_hashes.fill(0);
+    size_t count = 0;
+    for (size_t i = 1; i < selector.compounds.size(); ++i) {
+        for (const auto& simple : selector.compounds[i].simple_selectors) {
+            if (count == Selector::kMaxAncestorHashes) return;
+            selector.ancestor_hashes[count++] = selector_hash(simple.type, simple.value);
+        }
+    }
+}
+
+void collect_element_hashes(const DOM::Element& element, std::vector<uint32_t>& out) {
+    out.push_back(selector_hash(SelectorType::Tag, element.get_tag_name()));
+
+    const auto& attributes = element.get_attributes();
+    if (auto it = attributes.find(std::string(Html::AttributeNames::Id)); it != attributes.end()) {
+        out.push_back(selector_hash(SelectorType::Id, it->second));
+    }
+    if (auto it = attributes.find(std::string(Html::AttributeNames::Class)); it != attributes.end()) {
+        for_each_class_name(it->second,
+                            [&out](std::string_view cls) { out.push_back(selector_hash(SelectorType::Class, cls)); });
+    }
+}
+
+void AncestorFilter::push_element(const DOM::Element& element) {
+    const size_t start = m_hashes.size();
+    m_frame_starts.push_back(start);
+    collect_element_hashes(element, m_hashes);
+    for (size_t i = start; i < m_hashes.size(); ++i) {
+        increment(m_hashes[i] & kMask);
+        increment((m_hashes[i] >> kBits) & kMask);
+    }
+}
+
+void AncestorFilter::pop_element() {
+    if (m_frame_starts.empty()) return;
+    size_t start = m_frame_starts.back();
+    m_frame_starts.pop_back();
+    for (size_t i = start; i < m_hashes.size(); ++i) {
+        remove(m_hashes[i]);
+    }
+    m_hashes.resize(start);
+}
+
+void AncestorFilter::clear() {
+    m_counters.fill(0);
+    m_hashes.clear();
+    m_frame_starts.clear();
+}
+
+bool AncestorFilter::may_contain(uint32_t hash) const {
+    return m_counters[hash & kMask] != 0 && m_counters[(hash >> kBits) & kMask] != 0;
+}
+
+bool AncestorFilter::may_match(const Selector& selector) const {
+    for (uint32_t hash : selector.ancestor_hashes) {
+        if (hash == 0) break;
+        if (!may_contain(hash)) return false;
+    }
+    return true;
+}
+
+void AncestorFilter::remove(uint32_t hash) {
+    decrement(hash & kMask);
+    decrement((hash >> kBits) & kMask);
+}
+
+// Saturated counters stick so an overflowing bucket can only cause false positives, never false negatives.
+void AncestorFilter::increment(uint32_t index) {
+    if (m_counters[index] != kSaturated) ++m_counters[index];
+}
+
+void AncestorFilter::decrement(uint32_t index) {
+    if (m_counters[index] != kSaturated) --m_counters[index];
+}
+
+}  // namespace Hummingbird::Css
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "style/Stylesheet.h"
+
+namespace Hummingbird::DOM {
+class Element;
+}
+
+namespace Hummingbird::Css {
+
+inline bool is_class_separator(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+// Hash of a simple selector as seen by the AncestorFilter; never returns 0 (used as terminator).
+uint32_t selector_hash(SelectorType type, std::string_view value);
+
+// Appends the hashes of |element|'s tag, id and each of its classes to |out|.
+void collect_element_hashes(const DOM::Element& element, std::vector<uint32_t>& out);
+
+// Invokes |fn| with each whitespace-separated name in a class attribute value.
+template <typename Fn>
+void for_each_class_name(std::string_view classes, Fn&& fn) {
+    size_t pos = 0;
+    while (pos < classes.size()) {
+        while (pos < classes.size() && is_class_separator(classes[pos])) ++pos;
+        size_t start = pos;
+        while (pos < classes.size() && !is_class_separator(classes[pos])) ++pos;
+        if (pos > start) fn(classes.substr(start, pos - start));
+    }
+}
+
+// Fills selector.ancestor_hashes with (up to kMaxAncestorHashes) hashes of simple selectors from the non-subject
+// compounds that sit behind a descendant or child combinator.
+void compute_ancestor_hashes(Selector& selector);
+
+// Counting Bloom filter of the tag/class/id hashes of the current element's ancestors, maintained by the style
+// traversal. may_match() answering false proves a selector can't match; true means "walk the tree to find out".
+class AncestorFilter {
+public:
+    void push_element(const DOM::Element& element);
+    void pop_element();
+    void clear();
+    size_t depth() const { return m_frame_starts.size(); }
+
+    bool may_contain(uint32_t hash) const;
+    bool may_match(const Selector& selector) const;
+
+private:
+    static constexpr size_t kBits = 12;
+    static constexpr size_t kCounterCount = size_t{1} << kBits;
+    static constexpr uint32_t kMask = kCounterCount - 1;
+
+    void remove(uint32_t hash);
+    void increment(uint32_t index);
+    void decrement(uint32_t index);
+
+    std::array<uint8_t, kCounterCount> m_counters{};
+    std::vector<uint32_t> m_hashes;       // hashes of every pushed element, in push order
+    std::vector<size_t> m_frame_starts;  // offset into m_hashes where each pushed element begins
+};
+
+}  // namespace Hummingbird::Css
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+
+#include "style/Stylesheet.h"
+
+namespace Hummingbird::Css {
+
+struct MatchedProperty {
+    Origin origin = Origin::UserAgent;
+    int specificity = 0;
+    size_t order = 0;
+    Value value;
+};
+
+// Cascade precedence: origin first, then specificity, then source order.
+inline bool wins_over(const MatchedProperty& candidate, const MatchedProperty& current) {
+    if (candidate.origin != current.origin) return candidate.origin > current.origin;
+    if (candidate.specificity != current.specificity) return candidate.specificity > current.specificity;
+    return candidate.order > current.order;
+}
+
+// Winning declaration per property for one element, stored in a flat array indexed by Property. The StyleEngine
+// keeps one instance and clears it between nodes, so cascading never allocates.
+class CascadedProperties {
+public:
+    void clear() { m_set.reset(); }
+
+    void offer(Property property, const MatchedProperty& candidate) {
+        const auto index = static_cast<size_t>(property);
+        if (!m_set.test(index) || wins_over(candidate, m_slots[index])) {
+            m_slots[index] = candidate;
+            m_set.set(index);
+        }
+    }
+
+    bool has(Property property) const { return m_set.test(static_cast<size_t>(property)); }
+
+    // Returns the cascaded value of |property|, or nullptr if no declaration matched.
+    const Value* find(Property property) const {
+        const auto index = static_cast<size_t>(property);
+        return m_set.test(index) ? &m_slots[index].value : nullptr;
+    }
+
+private:
+    std::array<MatchedProperty, kPropertyCount> m_slots{};
+    std::bitset<kPropertyCount> m_set;
+};
+
+}  // namespace Hummingbird::Css
@@ -19,6 +19,12 @@ struct ComputedStyle {
     Display display = Display::Block;
     enum class TextAlign { Left, Center, Right };
     TextAlign text_align = TextAlign::Left;
+    // text-wrap: pretty selects the total-fit line breaker for the block's inline content.
+    enum class TextWrap { Wrap, Pretty };
+    TextWrap text_wrap = TextWrap::Wrap;
+    // table-layout: fixed sizes columns from the first row only.
+    enum class TableLayout { Auto, Fixed };
+    TableLayout table_layout = TableLayout::Auto;
     enum class BorderStyle { None, Solid };
     BorderStyle border_style = BorderStyle::None;
     EdgeSizes border_width;
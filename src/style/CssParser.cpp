@@ -1,24 +1,29 @@
 #include "style/CssParser.h"
 
+#include <algorithm>
+#include <charconv>
 #include <optional>
 
+#include "core/utils/Trace.h"
+#include "style/AncestorFilter.h"
 #include "style/CssPropertyNames.h"
 #include "style/CssValueNames.h"
 
 namespace Hummingbird::Css {
 
-Parser::Parser(std::string_view input) : m_buffer(input) {
-    Tokenizer tokenizer(m_buffer);
-    m_tokens = tokenizer.tokenize();
+Parser::Parser(std::string_view input) : m_tokenizer(input) {
+    m_current = m_tokenizer.next_token();
 }
 
 const Token& Parser::peek() const {
-    return m_tokens[m_pos];
+    return m_current;
 }
 
 const Token& Parser::advance() {
-    if (!eof()) ++m_pos;
-    return m_tokens[m_pos - 1];
+    if (eof()) return m_current;
+    m_previous = m_current;
+    m_current = m_tokenizer.next_token();
+    return m_previous;
 }
 
 bool Parser::match(TokenType type) {
@@ -37,18 +42,52 @@ static bool is_selector_start(TokenType type) {
     return type == TokenType::Identifier || type == TokenType::Dot || type == TokenType::Hash;
 }
 
-Selector Parser::parse_selector() {
+SimpleSelector Parser::parse_simple_selector() {
     SelectorType type = SelectorType::Tag;
     if (match(TokenType::Dot)) {
         type = SelectorType::Class;
     } else if (match(TokenType::Hash)) {
         type = SelectorType::Id;
     }
-    std::string value;
+    std::string_view value;
     if (peek().type == TokenType::Identifier) {
         value = advance().lexeme;
     }
-    return Selector{type, value};
+    return SimpleSelector{type, value};
+}
+
+CompoundSelector Parser::parse_compound_selector() {
+    CompoundSelector compound;
+    compound.simple_selectors.push_back(parse_simple_selector());
+    // Whitespace ends the compound: "div.a" is one compound, "div .a" is two.
+    while (is_selector_start(peek().type) && !peek().whitespace_before) {
+        compound.simple_selectors.push_back(parse_simple_selector());
+    }
+    return compound;
+}
+
+std::optional<Combinator> Parser::parse_combinator() {
+    if (match(TokenType::Greater)) {
+        return Combinator::Child;
+    }
+    if (is_selector_start(peek().type) && peek().whitespace_before) {
+        return Combinator::Descendant;
+    }
+    return std::nullopt;
+}
+
+Selector Parser::parse_selector() {
+    // Compounds are parsed left-to-right, then reversed so the subject comes first for right-to-left matching.
+    Selector selector;
+    selector.compounds.push_back(parse_compound_selector());
+    while (auto combinator = parse_combinator()) {
+        if (!is_selector_start(peek().type)) break;
+        selector.compounds.push_back(parse_compound_selector());
+        selector.compounds.back().combinator = *combinator;
+    }
+    std::reverse(selector.compounds.begin(), selector.compounds.end());
+    compute_ancestor_hashes(selector);
+    return selector;
 }
 
 std::vector<Selector> Parser::parse_selectors() {
@@ -110,14 +149,14 @@ Property Parser::parse_property() {
 }
 
 Value Parser::parse_value() {
-    if (eof()) return Value::identifier("");
+    if (eof()) return Value::keyword_value(Keyword::Unknown);
 
     if (match(TokenType::Hash)) return parse_hash_value();
     if (peek().type == TokenType::Identifier) return parse_identifier_value();
     if (peek().type == TokenType::Number) return parse_number_value();
 
     advance();
-    return Value::identifier("");
+    return Value::keyword_value(Keyword::Unknown);
 }
 
 std::vector<Declaration> Parser::parse_declarations() {
@@ -154,42 +193,64 @@ Property Parser::parse_property_name(std::string_view name) const {
     if (name == PropertyNames::FontSize) return Property::FontSize;
     if (name == PropertyNames::LineHeight) return Property::LineHeight;
     if (name == PropertyNames::MaxWidth) return Property::MaxWidth;
+    if (name == PropertyNames::TextWrap) return Property::TextWrap;
+    if (name == PropertyNames::TableLayout) return Property::TableLayout;
     return Property::Unknown;
 }
 
+Keyword Parser::parse_keyword(std::string_view name) const {
+    if (name == ValueNames::None) return Keyword::None;
+    if (name == ValueNames::Inline) return Keyword::Inline;
+    if (name == ValueNames::InlineBlock) return Keyword::InlineBlock;
+    if (name == ValueNames::ListItem) return Keyword::ListItem;
+    if (name == ValueNames::Block) return Keyword::Block;
+    if (name == ValueNames::Solid) return Keyword::Solid;
+    if (name == ValueNames::Wrap) return Keyword::Wrap;
+    if (name == ValueNames::Pretty) return Keyword::Pretty;
+    if (name == ValueNames::Auto) return Keyword::Auto;
+    if (name == ValueNames::Fixed) return Keyword::Fixed;
+    return Keyword::Unknown;
+}
+
 Value Parser::parse_hash_value() {
-    if (peek().type == TokenType::Identifier || peek().type == TokenType::Number) {
-        std::string hex;
-        while (peek().type == TokenType::Identifier || peek().type == TokenType::Number) {
-            hex.append(advance().lexeme);
+    // "#3a5" may be split into several Number/Identifier tokens; gather them into a fixed buffer since only
+    // 3- and 6-digit colors are valid.
+    char hex[6];
+    size_t hex_size = 0;
+    bool overflow = false;
+    while (peek().type == TokenType::Identifier || peek().type == TokenType::Number) {
+        std::string_view part = advance().lexeme;
+        if (overflow || hex_size + part.size() > sizeof(hex)) {
+            overflow = true;
+            continue;
         }
-        if (auto color = parse_hex_color(hex)) {
+        part.copy(hex + hex_size, part.size());
+        hex_size += part.size();
+    }
+    if (!overflow) {
+        if (auto color = parse_hex_color(std::string_view(hex, hex_size))) {
             return Value::color_value(*color);
         }
-        return Value::identifier("#" + hex);
     }
-    return Value::identifier("#");
+    return Value::keyword_value(Keyword::Unknown);
 }
 
 Value Parser::parse_identifier_value() {
-    std::string ident = std::string(advance().lexeme);
+    std::string_view ident = advance().lexeme;
     if (auto color = parse_named_color(ident)) {
         return Value::color_value(*color);
     }
-    return Value::identifier(std::move(ident));
+    return Value::keyword_value(parse_keyword(ident));
 }
 
 Value Parser::parse_number_value() {
-    std::string number_text = std::string(advance().lexeme);
+    std::string_view number_text = advance().lexeme;
     float number = 0.0f;
-    try {
-        number = std::stof(number_text);
-    } catch (...) {
+    if (std::from_chars(number_text.data(), number_text.data() + number_text.size(), number).ec != std::errc{}) {
         number = 0.0f;
     }
     if (peek().type == TokenType::Identifier) {
-        std::string unit_text = std::string(advance().lexeme);
-        Unit unit = unit_text == ValueNames::Px ? Unit::Px : Unit::Unknown;
+        Unit unit = advance().lexeme == ValueNames::Px ? Unit::Px : Unit::Unknown;
         return Value::length_value(number, unit);
     }
     return Value::number_value(number);
@@ -211,6 +272,7 @@ bool Parser::consume_declaration(std::vector<Declaration>& decls) {
 }
 
 Stylesheet Parser::parse() {
+    HB_TRACE_ZONE("style", "Css::Parser::parse");
     Stylesheet sheet;
     while (!eof()) {
         // Selector
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -9,6 +10,8 @@
 
 namespace Hummingbird::Css {
 
+// Recursive-descent parser driving a streaming Tokenizer with one token of lookahead.
+// |input| is not copied: it must outlive the parser (the resulting Stylesheet owns its strings).
 class Parser {
 public:
     explicit Parser(std::string_view input);
@@ -20,20 +23,24 @@ private:
     bool match(TokenType type);
     bool eof() const;
 
+    SimpleSelector parse_simple_selector();
+    CompoundSelector parse_compound_selector();
+    std::optional<Combinator> parse_combinator();
     Selector parse_selector();
     std::vector<Selector> parse_selectors();
     Property parse_property();
     Value parse_value();
     std::vector<Declaration> parse_declarations();
     Property parse_property_name(std::string_view name) const;
+    Keyword parse_keyword(std::string_view name) const;
     Value parse_hash_value();
     Value parse_identifier_value();
     Value parse_number_value();
     bool consume_declaration(std::vector<Declaration>& decls);
 
-    std::string m_buffer;
-    std::vector<Token> m_tokens;
-    size_t m_pos = 0;
+    Tokenizer m_tokenizer;
+    Token m_current{TokenType::End, ""};
+    Token m_previous{TokenType::End, ""};
 };
 
 }  // namespace Hummingbird::Css
@@ -25,5 +25,7 @@ static constexpr std::string_view BackgroundColor = "background-color";
 static constexpr std::string_view FontSize = "font-size";
 static constexpr std::string_view LineHeight = "line-height";
 static constexpr std::string_view MaxWidth = "max-width";
+static constexpr std::string_view TextWrap = "text-wrap";
+static constexpr std::string_view TableLayout = "table-layout";
 
 }  // namespace Hummingbird::Css::PropertyNames
@@ -67,53 +67,61 @@ Token Tokenizer::emit_single(TokenType type, std::string_view lexeme) {
     return Token{type, lexeme};
 }
 
-bool Tokenizer::consume_simple_token(std::vector<Token>& tokens) {
+bool Tokenizer::consume_simple_token(Token& out) {
     switch (peek()) {
         case '{':
-            tokens.push_back(emit_single(TokenType::LBrace, "{"));
+            out = emit_single(TokenType::LBrace, "{");
             return true;
         case '}':
-            tokens.push_back(emit_single(TokenType::RBrace, "}"));
+            out = emit_single(TokenType::RBrace, "}");
             return true;
         case ',':
-            tokens.push_back(emit_single(TokenType::Comma, ","));
+            out = emit_single(TokenType::Comma, ",");
             return true;
         case ':':
-            tokens.push_back(emit_single(TokenType::Colon, ":"));
+            out = emit_single(TokenType::Colon, ":");
             return true;
         case ';':
-            tokens.push_back(emit_single(TokenType::Semicolon, ";"));
+            out = emit_single(TokenType::Semicolon, ";");
             return true;
         case '.':
-            tokens.push_back(emit_single(TokenType::Dot, "."));
+            out = emit_single(TokenType::Dot, ".");
             return true;
         case '#':
-            tokens.push_back(emit_single(TokenType::Hash, "#"));
+            out = emit_single(TokenType::Hash, "#");
+            return true;
+        case '>':
+            out = emit_single(TokenType::Greater, ">");
             return true;
         default:
             return false;
     }
 }
 
-std::vector<Token> Tokenizer::tokenize() {
-    std::vector<Token> tokens;
-    tokens.reserve(m_input.size() + 1);
-    while (!eof()) {
+Token Tokenizer::next_token() {
+    const size_t start = m_pos;
+    size_t lexeme_start = start;
+    Token token{TokenType::End, ""};
+    while (true) {
         skip_whitespace();
+        lexeme_start = m_pos;
         if (eof()) break;
-        if (consume_simple_token(tokens)) continue;
+        if (consume_simple_token(token)) break;
         char c = peek();
         if (is_identifier_start(c)) {
-            tokens.push_back(identifier());
-        } else if (std::isdigit(static_cast<unsigned char>(c))) {
-            tokens.push_back(number());
-        } else {
-            // Unknown character; skip it.
-            advance();
+            token = identifier();
+            break;
         }
+        if (std::isdigit(static_cast<unsigned char>(c))) {
+            token = number();
+            break;
+        }
+        // Unknown character; skip it.
+        advance();
     }
-    tokens.push_back({TokenType::End, ""});
-    return tokens;
+    // Anything skipped before the lexeme (whitespace or unknown characters) separates it from the previous token.
+    token.whitespace_before = start > 0 && lexeme_start > start;
+    return token;
 }
 
 }  // namespace Hummingbird::Css
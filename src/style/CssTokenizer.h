@@ -1,8 +1,6 @@
 #pragma once
 
-#include <string>
 #include <string_view>
-#include <vector>
 
 namespace Hummingbird::Css {
 
@@ -16,18 +14,24 @@ enum class TokenType {
     Semicolon,
     Dot,
     Hash,
+    Greater,
     End,
 };
 
 struct Token {
     TokenType type;
     std::string_view lexeme;
+    // True if whitespace separated this token from the previous one; significant in selectors ("div p").
+    bool whitespace_before = false;
 };
 
+// Pull-based tokenizer: the parser requests one token at a time, so no token vector is materialized.
+// Token lexemes are views into |input|, which must outlive the tokenizer and every token it returns.
 class Tokenizer {
 public:
     explicit Tokenizer(std::string_view input);
-    std::vector<Token> tokenize();
+    // Returns the next token, or TokenType::End once the input is exhausted (repeatedly).
+    Token next_token();
 
 private:
     char peek() const;
@@ -37,7 +41,7 @@ private:
     Token identifier();
     Token number();
     Token emit_single(TokenType type, std::string_view lexeme);
-    bool consume_simple_token(std::vector<Token>& tokens);
+    bool consume_simple_token(Token& out);
 
     std::string_view m_input;
     size_t m_pos = 0;
@@ -0,0 +1,72 @@
+#include "style/InvalidationSet.h"
+
+#include <algorithm>
+#include <optional>
+
+#include "style/AncestorFilter.h"
+
+namespace Hummingbird::Css {
+
+namespace {
+bool is_invalidation_feature(const SimpleSelector& simple) {
+    return (simple.type == SelectorType::Class || simple.type == SelectorType::Id) && !simple.value.empty();
+}
+
+// Picks the most selective simple selector of the subject compound; an element has to carry it to match.
+std::optional<uint32_t> subject_feature(const CompoundSelector& subject) {
+    const SimpleSelector* best = nullptr;
+    for (const auto& simple : subject.simple_selectors) {
+        if (simple.value.empty()) continue;
+        if (!best || simple.type == SelectorType::Id ||
+            (simple.type == SelectorType::Class && best->type == SelectorType::Tag)) {
+            best = &simple;
+        }
+    }
+    if (!best) return std::nullopt;
+    return selector_hash(best->type, best->value);
+}
+}  // namespace
+
+RuleInvalidationData RuleInvalidationData::build(std::span<const CascadeSheet> sheets) {
+    RuleInvalidationData data;
+    for (const auto& cascade_sheet : sheets) {
+        if (!cascade_sheet.sheet) continue;
+        for (const auto& rule : cascade_sheet.sheet->rules) {
+            for (const auto& selector : rule.selectors) {
+                data.add_selector(selector);
+            }
+        }
+    }
+    return data;
+}
+
+const InvalidationSet* RuleInvalidationData::find(SelectorType type, std::string_view value) const {
+    auto it = m_sets.find(selector_hash(type, value));
+    return it == m_sets.end() ? nullptr : &it->second;
+}
+
+void RuleInvalidationData::add_selector(const Selector& selector) {
+    if (selector.compounds.empty()) return;
+
+    for (const auto& simple : selector.compounds.front().simple_selectors) {
+        if (is_invalidation_feature(simple)) {
+            m_sets[selector_hash(simple.type, simple.value)].invalidates_self = true;
+        }
+    }
+
+    const auto subject = subject_feature(selector.compounds.front());
+    for (size_t i = 1; i < selector.compounds.size(); ++i) {
+        for (const auto& simple : selector.compounds[i].simple_selectors) {
+            if (!is_invalidation_feature(simple)) continue;
+            auto& set = m_sets[selector_hash(simple.type, simple.value)];
+            if (!subject) {
+                set.invalidates_subtree = true;
+            } else if (std::find(set.descendant_features.begin(), set.descendant_features.end(), *subject) ==
+                       set.descendant_features.end()) {
+                set.descendant_features.push_back(*subject);
+            }
+        }
+    }
+}
+
+}  // namespace Hummingbird::Css
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "style/Stylesheet.h"
+
+namespace Hummingbird::Css {
+
+// What has to be restyled when an element gains or loses one class/id. Derived from the selectors that mention it.
+struct InvalidationSet {
+    // The feature appears in a subject compound, so the element itself may change.
+    bool invalidates_self = false;
+    // The feature appears left of a combinator and some of those selectors' subjects can't be keyed, so every
+    // descendant may change.
+    bool invalidates_subtree = false;
+    // selector_hash() of the subject features of descendant selectors; only descendants carrying one may change.
+    std::vector<uint32_t> descendant_features;
+
+    bool invalidates_descendants() const { return invalidates_subtree || !descendant_features.empty(); }
+};
+
+// Invalidation sets for every class and id referenced by a set of cascaded stylesheets.
+class RuleInvalidationData {
+public:
+    static RuleInvalidationData build(std::span<const CascadeSheet> sheets);
+
+    // Returns the invalidation set for a class or id, or nullptr if no selector depends on it.
+    const InvalidationSet* find(SelectorType type, std::string_view value) const;
+    size_t size() const { return m_sets.size(); }
+
+private:
+    void add_selector(const Selector& selector);
+
+    // Keyed by selector_hash(); colliding names share (and so over-invalidate) a set, which is safe.
+    std::unordered_map<uint32_t, InvalidationSet> m_sets;
+};
+
+}  // namespace Hummingbird::Css
@@ -1,10 +1,10 @@
 #include "style/SelectorMatcher.h"
 
-#include <sstream>
 #include <string_view>
 
 #include "core/dom/Element.h"
 #include "html/HtmlAttributeNames.h"
+#include "style/AncestorFilter.h"
 
 namespace Hummingbird::Css {
 
@@ -16,13 +16,16 @@ const std::string* find_attribute_value(const DOM::Element& element, std::string
     return &it->second;
 }
 
-bool has_class(const DOM::Element& element, const std::string& expected) {
+bool has_class(const DOM::Element& element, std::string_view expected) {
     const auto* value = find_attribute_value(element, Hummingbird::Html::AttributeNames::Class);
     if (!value) return false;
-    std::istringstream ss(*value);
-    std::string cls;
-    while (ss >> cls) {
-        if (cls == expected) return true;
+    std::string_view classes = *value;
+    size_t pos = 0;
+    while (pos < classes.size()) {
+        while (pos < classes.size() && is_class_separator(classes[pos])) ++pos;
+        size_t start = pos;
+        while (pos < classes.size() && !is_class_separator(classes[pos])) ++pos;
+        if (pos > start && classes.substr(start, pos - start) == expected) return true;
     }
     return false;
 }
@@ -31,25 +34,53 @@ bool has_id(const DOM::Element& element, const std::string& expected) {
     const auto* value = find_attribute_value(element, Hummingbird::Html::AttributeNames::Id);
     return value && *value == expected;
 }
+
+bool matches_simple(const DOM::Element& element, const SimpleSelector& selector) {
+    switch (selector.type) {
+        case SelectorType::Tag:
+            return element.get_tag_name() == selector.value;
+        case SelectorType::Class:
+            return has_class(element, selector.value);
+        case SelectorType::Id:
+            return has_id(element, selector.value);
+    }
+    return false;
+}
+
+bool matches_compound(const DOM::Element& element, const CompoundSelector& compound) {
+    for (const auto& simple : compound.simple_selectors) {
+        if (!matches_simple(element, simple)) return false;
+    }
+    return true;
+}
+
+const DOM::Element* parent_element(const DOM::Element& element) {
+    return dynamic_cast<const DOM::Element*>(element.get_parent());
+}
+
+// Matches compounds[index..] against |element| and its ancestors, backtracking over descendant combinators.
+bool matches_from(const DOM::Element& element, const Selector& selector, size_t index) {
+    const auto& compound = selector.compounds[index];
+    if (!matches_compound(element, compound)) return false;
+    if (index + 1 == selector.compounds.size()) return true;
+
+    const DOM::Element* ancestor = parent_element(element);
+    if (compound.combinator == Combinator::Child) {
+        return ancestor && matches_from(*ancestor, selector, index + 1);
+    }
+    for (; ancestor; ancestor = parent_element(*ancestor)) {
+        if (matches_from(*ancestor, selector, index + 1)) return true;
+    }
+    return false;
+}
 }  // namespace
 
 bool matches_selector(const DOM::Node* node, const Selector& selector) {
     auto element = dynamic_cast<const DOM::Element*>(node);
-    if (!element) {
+    if (!element || selector.compounds.empty()) {
         return false;
     }
-
-    switch (selector.type) {
-        case SelectorType::Tag:
-            return element->get_tag_name() == selector.value;
-        case SelectorType::Class: {
-            return has_class(*element, selector.value);
-        }
-        case SelectorType::Id: {
-            return has_id(*element, selector.value);
-        }
-    }
-    return false;
+    return matches_from(*element, selector, 0);
 }
 
 }  // namespace Hummingbird::Css
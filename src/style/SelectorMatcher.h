@@ -8,6 +8,7 @@ class Node;
 
 namespace Hummingbird::Css {
 
+// Right-to-left match of a complex selector: the subject compound is tested first, ancestors only if it matches.
 bool matches_selector(const DOM::Node* node, const Selector& selector);
 
 }  // namespace Hummingbird::Css
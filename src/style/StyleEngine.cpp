@@ -3,13 +3,13 @@
 #include <algorithm>
 #include <cctype>
 #include <cstdlib>
-#include <unordered_map>
+#include <vector>
 
 #include "core/dom/Element.h"
 #include "core/dom/Node.h"
+#include "core/utils/Trace.h"
 #include "html/HtmlAttributeNames.h"
 #include "html/HtmlTagNames.h"
-#include "style/CssValueNames.h"
 #include "style/SelectorMatcher.h"
 
 namespace Hummingbird::Css {
@@ -26,12 +26,6 @@ void apply_edge(EdgeSizes& edges, float value) {
     edges.top = edges.right = edges.bottom = edges.left = value;
 }
 
-struct MatchedProperty {
-    int specificity;
-    size_t order;
-    Value value;
-};
-
 struct StyleOverrides {
     bool color = false;
     bool underline = false;
@@ -42,6 +36,7 @@ struct StyleOverrides {
     bool font_size = false;
     bool font_face = false;
     bool text_align = false;
+    bool text_wrap = false;
     bool background = false;
 };
 
@@ -50,108 +45,129 @@ struct StyleResult {
     StyleOverrides overrides;
 };
 
-struct PropertyHash {
-    size_t operator()(Property property) const { return static_cast<size_t>(property); }
-};
-
-using PropertyMap = std::unordered_map<Property, MatchedProperty, PropertyHash>;
-
-PropertyMap collect_matched_properties(const Stylesheet& sheet, const DOM::Node* node) {
-    PropertyMap properties;
+void collect_matched_properties(std::span<const CascadeSheet> sheets, const DOM::Node* node,
+                                const AncestorFilter& ancestors, CascadedProperties& properties) {
+    properties.clear();
     size_t order = 0;
 
     const auto* element = dynamic_cast<const DOM::Element*>(node);
-    if (!element) return properties;
-
-    for (const auto& rule : sheet.rules) {
-        for (const auto& selector : rule.selectors) {
-            if (!matches_selector(node, selector)) continue;
-            int spec = selector.specificity();
-            for (const auto& decl : rule.declarations) {
-                auto it = properties.find(decl.property);
-                if (it == properties.end() || spec > it->second.specificity ||
-                    (spec == it->second.specificity && order > it->second.order)) {
-                    properties[decl.property] = {spec, order, decl.value};
+    if (!element) return;
+
+    for (const auto& cascade_sheet : sheets) {
+        if (!cascade_sheet.sheet) continue;
+        for (const auto& rule : cascade_sheet.sheet->rules) {
+            for (const auto& selector : rule.selectors) {
+                // The Bloom filter rejects most descendant selectors without walking up the tree.
+                if (!ancestors.may_match(selector) || !matches_selector(node, selector)) continue;
+                int spec = selector.specificity();
+                for (const auto& decl : rule.declarations) {
+                    properties.offer(decl.property, {cascade_sheet.origin, spec, order, decl.value});
+                    ++order;
                 }
-                ++order;
             }
         }
     }
+}
 
-    return properties;
+void apply_length_if_present(const CascadedProperties& properties, Property property, float& target) {
+    if (const Value* value = properties.find(property)) {
+        target = value_to_length(*value, target);
+    }
 }
 
-void apply_length_if_present(const PropertyMap& properties, Property property, float& target) {
-    auto it = properties.find(property);
-    if (it != properties.end()) {
-        target = value_to_length(it->second.value, target);
+void apply_optional_length_if_present(const CascadedProperties& properties, Property property,
+                                      std::optional<float>& target) {
+    if (const Value* value = properties.find(property)) {
+        target = value_to_length(*value, target.value_or(0.0f));
     }
 }
 
-void apply_optional_length_if_present(const PropertyMap& properties, Property property, std::optional<float>& target) {
-    auto it = properties.find(property);
-    if (it != properties.end()) {
-        target = value_to_length(it->second.value, target.value_or(0.0f));
+void apply_edge_if_present(const CascadedProperties& properties, Property property, EdgeSizes& target) {
+    if (const Value* value = properties.find(property)) {
+        apply_edge(target, value_to_length(*value, 0.0f));
     }
 }
 
+const Color* find_color(const CascadedProperties& properties, Property property) {
+    const Value* value = properties.find(property);
+    return value && value->type == Value::Type::Color ? &value->color : nullptr;
+}
+
 void apply_border_style(ComputedStyle& style, const Value& value) {
-    if (value.type != Value::Type::Identifier) return;
-    if (value.ident == ValueNames::Solid) {
+    if (value.type != Value::Type::Keyword) return;
+    if (value.keyword == Keyword::Solid) {
         style.border_style = ComputedStyle::BorderStyle::Solid;
     }
 }
 
-bool apply_display_property(const PropertyMap& properties, ComputedStyle& style) {
-    auto display_it = properties.find(Property::Display);
-    if (display_it == properties.end() || display_it->second.value.type != Value::Type::Identifier) {
+bool apply_display_property(const CascadedProperties& properties, ComputedStyle& style) {
+    const Value* display = properties.find(Property::Display);
+    if (!display || display->type != Value::Type::Keyword) {
         return false;
     }
 
-    const auto& ident = display_it->second.value.ident;
-    if (ident == ValueNames::None) {
-        style.display = ComputedStyle::Display::None;
-    } else if (ident == ValueNames::Inline) {
-        style.display = ComputedStyle::Display::Inline;
-    } else if (ident == ValueNames::InlineBlock) {
-        style.display = ComputedStyle::Display::InlineBlock;
-    } else if (ident == ValueNames::ListItem) {
-        style.display = ComputedStyle::Display::ListItem;
-    } else if (ident == ValueNames::Block) {
-        style.display = ComputedStyle::Display::Block;
+    switch (display->keyword) {
+        case Keyword::None:
+            style.display = ComputedStyle::Display::None;
+            break;
+        case Keyword::Inline:
+            style.display = ComputedStyle::Display::Inline;
+            break;
+        case Keyword::InlineBlock:
+            style.display = ComputedStyle::Display::InlineBlock;
+            break;
+        case Keyword::ListItem:
+            style.display = ComputedStyle::Display::ListItem;
+            break;
+        case Keyword::Block:
+            style.display = ComputedStyle::Display::Block;
+            break;
+        default:
+            break;
     }
     return true;
 }
 
-void apply_color_property(const PropertyMap& properties, ComputedStyle& style, StyleOverrides& overrides) {
-    auto color_it = properties.find(Property::Color);
-    if (color_it != properties.end() && color_it->second.value.type == Value::Type::Color) {
-        style.color = color_it->second.value.color;
-        overrides.color = true;
+void apply_text_wrap_property(const CascadedProperties& properties, ComputedStyle& style, StyleOverrides& overrides) {
+    const Value* text_wrap = properties.find(Property::TextWrap);
+    if (!text_wrap || text_wrap->type != Value::Type::Keyword) return;
+    if (text_wrap->keyword == Keyword::Pretty) {
+        style.text_wrap = ComputedStyle::TextWrap::Pretty;
+        overrides.text_wrap = true;
+    } else if (text_wrap->keyword == Keyword::Wrap) {
+        style.text_wrap = ComputedStyle::TextWrap::Wrap;
+        overrides.text_wrap = true;
     }
 }
 
-void apply_background_property(const PropertyMap& properties, ComputedStyle& style, StyleOverrides& overrides) {
-    auto bg_it = properties.find(Property::BackgroundColor);
-    if (bg_it != properties.end() && bg_it->second.value.type == Value::Type::Color) {
-        style.background = bg_it->second.value.color;
+void apply_table_layout_property(const CascadedProperties& properties, ComputedStyle& style) {
+    const Value* table_layout = properties.find(Property::TableLayout);
+    if (!table_layout || table_layout->type != Value::Type::Keyword) return;
+    if (table_layout->keyword == Keyword::Fixed) {
+        style.table_layout = ComputedStyle::TableLayout::Fixed;
+    } else if (table_layout->keyword == Keyword::Auto) {
+        style.table_layout = ComputedStyle::TableLayout::Auto;
+    }
+}
+
+void apply_color_properties(const CascadedProperties& properties, ComputedStyle& style, StyleOverrides& overrides) {
+    if (const Color* color = find_color(properties, Property::Color)) {
+        style.color = *color;
+        overrides.color = true;
+    }
+    if (const Color* background = find_color(properties, Property::BackgroundColor)) {
+        style.background = *background;
         overrides.background = true;
     }
 }
 
-void apply_properties_to_style(const PropertyMap& properties, ComputedStyle& style, StyleOverrides& overrides,
+void apply_properties_to_style(const CascadedProperties& properties, ComputedStyle& style, StyleOverrides& overrides,
                                bool& display_set) {
     display_set = apply_display_property(properties, style);
 
     // margin / padding shorthand and individual edges
-    auto margin_it = properties.find(Property::Margin);
-    if (margin_it != properties.end()) {
-        apply_edge(style.margin, value_to_length(margin_it->second.value, 0.0f));
-    }
-    auto padding_it = properties.find(Property::Padding);
-    if (padding_it != properties.end()) {
-        apply_edge(style.padding, value_to_length(padding_it->second.value, 0.0f));
-    }
+    apply_edge_if_present(properties, Property::Margin, style.margin);
+    apply_edge_if_present(properties, Property::Padding, style.padding);
 
     apply_length_if_present(properties, Property::MarginTop, style.margin.top);
     apply_length_if_present(properties, Property::MarginRight, style.margin.right);
@@ -163,24 +179,20 @@ void apply_properties_to_style(const PropertyMap& properties, ComputedStyle& sty
     apply_length_if_present(properties, Property::PaddingBottom, style.padding.bottom);
     apply_length_if_present(properties, Property::PaddingLeft, style.padding.left);
 
-    auto border_width_it = properties.find(Property::BorderWidth);
-    if (border_width_it != properties.end()) {
-        apply_edge(style.border_width, value_to_length(border_width_it->second.value, 0.0f));
-    }
-    auto border_color_it = properties.find(Property::BorderColor);
-    if (border_color_it != properties.end() && border_color_it->second.value.type == Value::Type::Color) {
-        style.border_color = border_color_it->second.value.color;
+    apply_edge_if_present(properties, Property::BorderWidth, style.border_width);
+    if (const Color* border_color = find_color(properties, Property::BorderColor)) {
+        style.border_color = *border_color;
     }
-    auto border_style_it = properties.find(Property::BorderStyle);
-    if (border_style_it != properties.end()) {
-        apply_border_style(style, border_style_it->second.value);
+    if (const Value* border_style = properties.find(Property::BorderStyle)) {
+        apply_border_style(style, *border_style);
     }
 
     apply_optional_length_if_present(properties, Property::Width, style.width);
     apply_optional_length_if_present(properties, Property::Height, style.height);
 
-    apply_color_property(properties, style, overrides);
-    apply_background_property(properties, style, overrides);
+    apply_text_wrap_property(properties, style, overrides);
+    apply_table_layout_property(properties, style);
+    apply_color_properties(properties, style, overrides);
 }
 
 void apply_ua_defaults(const DOM::Element& element, ComputedStyle& style, StyleOverrides& overrides, bool display_set) {
@@ -414,6 +426,7 @@ void apply_non_inheritable(ComputedStyle& target, const ComputedStyle& source) {
     target.border_width = source.border_width;
     target.border_color = source.border_color;
     target.border_style = source.border_style;
+    target.table_layout = source.table_layout;
     target.background = source.background;
 }
 
@@ -427,15 +440,17 @@ void apply_inheritable_overrides(ComputedStyle& target, const ComputedStyle& sou
     if (overrides.font_size) target.font_size = source.font_size;
     if (overrides.font_face) target.font_face = source.font_face;
     if (overrides.text_align) target.text_align = source.text_align;
+    if (overrides.text_wrap) target.text_wrap = source.text_wrap;
     if (overrides.background) target.background = source.background;
 }
 
 // Returns a computed style based on matching rules and parent style (for inheritance in the future).
-StyleResult build_style_for(const Stylesheet& sheet, const DOM::Node* node) {
+StyleResult build_style_for(std::span<const CascadeSheet> sheets, const DOM::Node* node,
+                            const AncestorFilter& ancestors, CascadedProperties& properties) {
     StyleResult result{default_computed_style(), {}};
     ComputedStyle& style = result.style;
-    PropertyMap properties = collect_matched_properties(sheet, node);
-    bool display_set = properties.find(Property::Display) != properties.end();
+    collect_matched_properties(sheets, node, ancestors, properties);
+    bool display_set = properties.has(Property::Display);
 
     // Minimal UA defaults for basic HTML readability.
     if (const auto* element = dynamic_cast<const DOM::Element*>(node)) {
@@ -448,11 +463,42 @@ StyleResult build_style_for(const Stylesheet& sheet, const DOM::Node* node) {
     return result;
 }
 
+bool inherited_properties_equal(const ComputedStyle& a, const ComputedStyle& b) {
+    return a.color.r == b.color.r && a.color.g == b.color.g && a.color.b == b.color.b && a.color.a == b.color.a &&
+           a.underline == b.underline && a.font_monospace == b.font_monospace && a.whitespace == b.whitespace &&
+           a.weight == b.weight && a.style == b.style && a.font_size == b.font_size && a.font_face == b.font_face &&
+           a.text_align == b.text_align && a.text_wrap == b.text_wrap;
+}
+
+std::string_view find_attribute(const DOM::Element& element, const std::string& name) {
+    const auto& attributes = element.get_attributes();
+    auto it = attributes.find(name);
+    return it == attributes.end() ? std::string_view{} : std::string_view(it->second);
+}
+
+bool contains_class(std::string_view classes, std::string_view name) {
+    bool found = false;
+    for_each_class_name(classes, [&](std::string_view cls) { found = found || cls == name; });
+    return found;
+}
+
+// Invokes |fn| for each class present in exactly one of the two class attribute values.
+template <typename Fn>
+void for_each_changed_class(std::string_view old_classes, std::string_view new_classes, Fn&& fn) {
+    for_each_class_name(old_classes, [&](std::string_view cls) {
+        if (!contains_class(new_classes, cls)) fn(cls);
+    });
+    for_each_class_name(new_classes, [&](std::string_view cls) {
+        if (!contains_class(old_classes, cls)) fn(cls);
+    });
+}
+
 }  // namespace
 
-void StyleEngine::compute_node(const Stylesheet& sheet, DOM::Node* node, const ComputedStyle* parent_style) {
+std::shared_ptr<ComputedStyle> StyleEngine::compute_style(std::span<const CascadeSheet> sheets, DOM::Node* node,
+                                                          const ComputedStyle* parent_style) {
     ComputedStyle base = parent_style ? *parent_style : default_computed_style();
-    StyleResult own = build_style_for(sheet, node);
+    StyleResult own = build_style_for(sheets, node, m_ancestor_filter, m_cascade);
 
     // Non-inheritable box properties come from the computed (own) style.
     apply_non_inheritable(base, own.style);
@@ -462,18 +508,159 @@ void StyleEngine::compute_node(const Stylesheet& sheet, DOM::Node* node, const C
         apply_inheritable_overrides(base, own.style, own.overrides);
     }
 
-    ComputedStyle style = base;
+    ++m_restyle_count;
+    return std::make_shared<ComputedStyle>(base);
+}
 
-    node->set_computed_style(std::make_shared<ComputedStyle>(style));
+void StyleEngine::compute_node(std::span<const CascadeSheet> sheets, DOM::Node* node,
+                               const ComputedStyle* parent_style) {
+    node->set_computed_style(compute_style(sheets, node, parent_style));
+    node->clear_restyle_flags();
 
+    auto* element = dynamic_cast<DOM::Element*>(node);
+    if (element) {
+        // A full style pass subsumes any recorded mutations.
+        element->clear_pending_mutations();
+        m_ancestor_filter.push_element(*element);
+    }
     for (const auto& child : node->get_children()) {
-        compute_node(sheet, child.get(), node->get_computed_style().get());
+        compute_node(sheets, child.get(), node->get_computed_style().get());
+    }
+    if (element) m_ancestor_filter.pop_element();
+}
+
+void StyleEngine::update_invalidation_data(std::span<const CascadeSheet> sheets) {
+    const bool same_sheets = std::equal(sheets.begin(), sheets.end(), m_invalidation_sheets.begin(),
+                                        m_invalidation_sheets.end(), [](const auto& a, const auto& b) {
+                                            return a.sheet == b.sheet && a.origin == b.origin;
+                                        });
+    if (same_sheets && m_invalidation_data) return;
+    m_invalidation_sheets.assign(sheets.begin(), sheets.end());
+    m_invalidation_data = RuleInvalidationData::build(sheets);
+}
+
+// Turns recorded attribute mutations into restyle marks, visiting only subtrees that contain mutated elements.
+void StyleEngine::schedule_invalidations(DOM::Node* node) {
+    auto* element = dynamic_cast<DOM::Element*>(node);
+    if (element && !element->get_pending_mutations().empty()) {
+        invalidate_for_mutations(*element);
+    }
+    if (!node->child_needs_restyle()) return;
+    for (const auto& child : node->get_children()) {
+        schedule_invalidations(child.get());
+    }
+}
+
+void StyleEngine::invalidate_for_mutations(DOM::Element& element) {
+    bool invalidate_self = false;
+    auto invalidate_feature = [&](SelectorType type, std::string_view value) {
+        if (value.empty()) return;
+        const InvalidationSet* set = m_invalidation_data->find(type, value);
+        if (!set) return;
+        invalidate_self = invalidate_self || set->invalidates_self;
+        if (set->invalidates_descendants()) invalidate_descendants(element, *set);
+    };
+
+    for (const auto& mutation : element.get_pending_mutations()) {
+        const std::string_view old_value = mutation.old_value ? std::string_view(*mutation.old_value) : "";
+        const std::string_view new_value = find_attribute(element, mutation.name);
+        if (mutation.name == Hummingbird::Html::AttributeNames::Class) {
+            for_each_changed_class(old_value, new_value,
+                                   [&](std::string_view cls) { invalidate_feature(SelectorType::Class, cls); });
+        } else if (mutation.name == Hummingbird::Html::AttributeNames::Id) {
+            invalidate_feature(SelectorType::Id, old_value);
+            invalidate_feature(SelectorType::Id, new_value);
+        } else {
+            // Presentational attributes (align, width, size, ...) feed the element's own style.
+            invalidate_self = true;
+        }
+    }
+    element.clear_pending_mutations();
+    if (invalidate_self) element.mark_for_restyle();
+}
+
+void StyleEngine::invalidate_descendants(DOM::Node& node, const InvalidationSet& set) {
+    for (const auto& child : node.get_children()) {
+        if (auto* element = dynamic_cast<DOM::Element*>(child.get())) {
+            if (set.invalidates_subtree || has_any_feature(*element, set.descendant_features)) {
+                element->mark_for_restyle();
+            }
+        }
+        invalidate_descendants(*child, set);
+    }
+}
+
+bool StyleEngine::has_any_feature(const DOM::Element& element, const std::vector<uint32_t>& features) {
+    m_feature_scratch.clear();
+    collect_element_hashes(element, m_feature_scratch);
+    return std::any_of(m_feature_scratch.begin(), m_feature_scratch.end(), [&](uint32_t hash) {
+        return std::find(features.begin(), features.end(), hash) != features.end();
+    });
+}
+
+// Recomputes nodes marked for restyle. Descendants are only revisited when they are marked themselves or when
+// the node's inherited properties changed.
+void StyleEngine::recalc_node(std::span<const CascadeSheet> sheets, DOM::Node* node, const ComputedStyle* parent_style,
+                              bool parent_inherited_changed) {
+    bool inherited_changed = false;
+    if (parent_inherited_changed || node->needs_restyle()) {
+        auto previous = node->get_computed_style();
+        auto style = compute_style(sheets, node, parent_style);
+        inherited_changed = !previous || !inherited_properties_equal(*previous, *style);
+        node->set_computed_style(std::move(style));
+    }
+    const bool descend = inherited_changed || node->child_needs_restyle();
+    node->clear_restyle_flags();
+    if (!descend) return;
+
+    const auto* element = dynamic_cast<const DOM::Element*>(node);
+    if (element) m_ancestor_filter.push_element(*element);
+    for (const auto& child : node->get_children()) {
+        recalc_node(sheets, child.get(), node->get_computed_style().get(), inherited_changed);
+    }
+    if (element) m_ancestor_filter.pop_element();
+}
+
+// Styling may start below the document root; the root's ancestors still count for descendant selectors.
+void StyleEngine::seed_ancestor_filter(const DOM::Node* root) {
+    m_ancestor_filter.clear();
+    std::vector<const DOM::Element*> ancestors;
+    for (const DOM::Node* node = root->get_parent(); node; node = node->get_parent()) {
+        if (const auto* element = dynamic_cast<const DOM::Element*>(node)) ancestors.push_back(element);
+    }
+    for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
+        m_ancestor_filter.push_element(**it);
     }
 }
 
 void StyleEngine::apply(const Stylesheet& sheet, DOM::Node* root) {
+    const CascadeSheet sheets[] = {{&sheet, Origin::Author}};
+    apply(sheets, root);
+}
+
+void StyleEngine::apply(std::span<const CascadeSheet> sheets, DOM::Node* root) {
+    HB_TRACE_ZONE("style", "StyleEngine::apply");
+    m_restyle_count = 0;
+    if (!root) return;
+    seed_ancestor_filter(root);
+    compute_node(sheets, root, nullptr);
+}
+
+void StyleEngine::restyle(const Stylesheet& sheet, DOM::Node* root) {
+    const CascadeSheet sheets[] = {{&sheet, Origin::Author}};
+    restyle(sheets, root);
+}
+
+void StyleEngine::restyle(std::span<const CascadeSheet> sheets, DOM::Node* root) {
+    HB_TRACE_ZONE("style", "StyleEngine::restyle");
+    m_restyle_count = 0;
     if (!root) return;
-    compute_node(sheet, root, nullptr);
+    update_invalidation_data(sheets);
+    schedule_invalidations(root);
+
+    seed_ancestor_filter(root);
+    const DOM::Node* parent = root->get_parent();
+    recalc_node(sheets, root, parent ? parent->get_computed_style().get() : nullptr, false);
 }
 
 }  // namespace Hummingbird::Css
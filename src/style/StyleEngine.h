@@ -1,9 +1,20 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "style/AncestorFilter.h"
+#include "style/CascadedProperties.h"
 #include "style/ComputedStyle.h"
+#include "style/InvalidationSet.h"
 #include "style/Stylesheet.h"
 
 namespace Hummingbird::DOM {
+class Element;
 class Node;
 }
 
@@ -11,10 +22,43 @@ namespace Hummingbird::Css {
 
 class StyleEngine {
 public:
+    // Applies a single author stylesheet.
     void apply(const Stylesheet& sheet, DOM::Node* root);
+    // Cascades several already-parsed sheets (e.g. cached UA + linked + inline sheets) in origin order.
+    void apply(std::span<const CascadeSheet> sheets, DOM::Node* root);
+    // Incremental counterpart of apply() for a tree that was already styled with |sheets|: turns attribute mutations
+    // recorded by DOM::Element::set_attribute into invalidations and recomputes only the affected nodes.
+    // Sheets are identified by address, so a modified sheet must be a new Stylesheet object.
+    void restyle(const Stylesheet& sheet, DOM::Node* root);
+    void restyle(std::span<const CascadeSheet> sheets, DOM::Node* root);
+
+    // Number of nodes whose style was computed by the last apply() or restyle() call.
+    size_t restyle_count() const { return m_restyle_count; }
 
 private:
-    void compute_node(const Stylesheet& sheet, DOM::Node* node, const ComputedStyle* parent_style);
+    void seed_ancestor_filter(const DOM::Node* root);
+    std::shared_ptr<ComputedStyle> compute_style(std::span<const CascadeSheet> sheets, DOM::Node* node,
+                                                 const ComputedStyle* parent_style);
+    void compute_node(std::span<const CascadeSheet> sheets, DOM::Node* node, const ComputedStyle* parent_style);
+
+    void update_invalidation_data(std::span<const CascadeSheet> sheets);
+    void schedule_invalidations(DOM::Node* node);
+    void invalidate_for_mutations(DOM::Element& element);
+    void invalidate_descendants(DOM::Node& node, const InvalidationSet& set);
+    bool has_any_feature(const DOM::Element& element, const std::vector<uint32_t>& features);
+    void recalc_node(std::span<const CascadeSheet> sheets, DOM::Node* node, const ComputedStyle* parent_style,
+                     bool parent_inherited_changed);
+
+    // Scratch cascade reused for every node; only valid while that node's style is being built.
+    CascadedProperties m_cascade;
+    // Tag/class/id hashes of the elements above the node being styled.
+    AncestorFilter m_ancestor_filter;
+
+    // Invalidation sets for the sheets last passed to restyle(); rebuilt when the sheet list changes.
+    std::vector<CascadeSheet> m_invalidation_sheets;
+    std::optional<RuleInvalidationData> m_invalidation_data;
+    std::vector<uint32_t> m_feature_scratch;
+    size_t m_restyle_count = 0;
 };
 
 }  // namespace Hummingbird::Css
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 #include "core/platform_api/IGraphicsContext.h"
@@ -33,9 +37,13 @@ enum class Property {
     FontSize,
     LineHeight,
     MaxWidth,
+    TextWrap,
+    TableLayout,
 };
 
-enum class Unit {
+inline constexpr size_t kPropertyCount = static_cast<size_t>(Property::TableLayout) + 1;
+
+enum class Unit : uint8_t {
     Px,
     Unknown,
 };
@@ -45,24 +53,45 @@ struct Length {
     Unit unit = Unit::Unknown;
 };
 
+// Interned identifier values. Identifiers the engine doesn't model are parsed as Unknown, so keyword values never
+// own any text.
+enum class Keyword : uint8_t {
+    Unknown,
+    None,
+    Inline,
+    InlineBlock,
+    ListItem,
+    Block,
+    Solid,
+    Wrap,
+    Pretty,
+    Auto,
+    Fixed,
+};
+
+// Tagged union holding one declaration value inline; trivially copyable so the cascade can copy it freely.
 struct Value {
-    enum class Type {
-        Identifier,
+    enum class Type : uint8_t {
+        Keyword,
         Length,
         Color,
         Number,
     };
 
-    Type type = Type::Identifier;
-    std::string ident;
-    Length length;
-    Color color{0, 0, 0, 255};
-    float number = 0.0f;
+    Type type = Type::Keyword;
+    union {
+        Css::Keyword keyword;
+        Css::Length length;
+        ::Color color;
+        float number;
+    };
+
+    Value() : keyword(Css::Keyword::Unknown) {}
 
-    static Value identifier(std::string text) {
+    static Value keyword_value(Css::Keyword keyword) {
         Value v;
-        v.type = Type::Identifier;
-        v.ident = std::move(text);
+        v.type = Type::Keyword;
+        v.keyword = keyword;
         return v;
     }
 
@@ -73,7 +102,7 @@ struct Value {
         return v;
     }
 
-    static Value color_value(Color color) {
+    static Value color_value(::Color color) {
         Value v;
         v.type = Type::Color;
         v.color = color;
@@ -88,11 +117,14 @@ struct Value {
     }
 };
 
-struct Selector {
+static_assert(std::is_trivially_copyable_v<Value>);
+static_assert(sizeof(Value) <= 16);
+
+struct SimpleSelector {
     SelectorType type;
     std::string value;
 
-    Selector(SelectorType type, std::string_view value) : type(type), value(value) {}
+    SimpleSelector(SelectorType type, std::string_view value) : type(type), value(value) {}
 
     int specificity() const {
         switch (type) {
@@ -107,6 +139,40 @@ struct Selector {
     }
 };
 
+// How a compound selector relates to the compound on its left ("div p" is Descendant, "ul > li" is Child).
+enum class Combinator : uint8_t { None, Descendant, Child };
+
+// Simple selectors that must all match the same element, e.g. "div.note#intro".
+struct CompoundSelector {
+    std::vector<SimpleSelector> simple_selectors;
+    // Relation to the next compound in Selector::compounds (i.e. the one written to the left); None for the last.
+    Combinator combinator = Combinator::None;
+};
+
+// Complex selector stored right-to-left: compounds.front() is the subject (key) compound, so matching starts at the
+// element being styled and walks up only when the subject matches.
+struct Selector {
+    static constexpr size_t kMaxAncestorHashes = 4;
+
+    std::vector<CompoundSelector> compounds;
+    // Hashes of simple selectors that must be present on some ancestor, for AncestorFilter fast rejection.
+    // Zero-terminated; filled in by compute_ancestor_hashes().
+    std::array<uint32_t, kMaxAncestorHashes> ancestor_hashes{};
+
+    Selector() = default;
+    Selector(SelectorType type, std::string_view value) : compounds{{{SimpleSelector{type, value}}}} {}
+
+    int specificity() const {
+        int total = 0;
+        for (const auto& compound : compounds) {
+            for (const auto& simple : compound.simple_selectors) {
+                total += simple.specificity();
+            }
+        }
+        return total;
+    }
+};
+
 struct Declaration {
     Property property = Property::Unknown;
     Value value;
@@ -121,4 +187,14 @@ struct Stylesheet {
     std::vector<Rule> rules;
 };
 
+// Cascade origin of a stylesheet. Author declarations win over user-agent ones regardless of specificity.
+enum class Origin { UserAgent, Author };
+
+// A parsed stylesheet taking part in the cascade. Sheets are passed in document order; later sheets of the same
+// origin win ties on specificity.
+struct CascadeSheet {
+    const Stylesheet* sheet = nullptr;
+    Origin origin = Origin::Author;
+};
+
 }  // namespace Hummingbird::Css
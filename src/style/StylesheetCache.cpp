@@ -0,0 +1,72 @@
+#include "style/StylesheetCache.h"
+
+#include <functional>
+
+#include "style/CssParser.h"
+
+namespace Hummingbird::Css {
+
+uint64_t StylesheetCache::hash_content(std::string_view css) {
+    // FNV-1a: stable across runs and platforms, unlike std::hash.
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : css) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+size_t StylesheetCache::KeyHash::operator()(const Key& key) const {
+    size_t seed = std::hash<std::string>{}(key.source);
+    return seed ^ (static_cast<size_t>(key.content_hash) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+}
+
+std::shared_ptr<const Stylesheet> StylesheetCache::get_or_parse(std::string_view source_key, std::string_view css) {
+    Key key{std::string(source_key), hash_content(css), css.size()};
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto it = m_entries.find(key); it != m_entries.end()) {
+            m_lru.splice(m_lru.begin(), m_lru, it->second.lru_it);
+            return it->second.sheet;
+        }
+    }
+
+    // Parse outside the lock; a concurrent miss on the same key just parses twice.
+    Parser parser(css);
+    auto sheet = std::make_shared<const Stylesheet>(parser.parse());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_parse_count;
+    if (auto it = m_entries.find(key); it != m_entries.end()) {
+        return it->second.sheet;
+    }
+    m_lru.push_front(key);
+    m_entries.emplace(std::move(key), Entry{sheet, m_lru.begin()});
+    evict_if_needed();
+    return sheet;
+}
+
+void StylesheetCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_lru.clear();
+}
+
+size_t StylesheetCache::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+size_t StylesheetCache::parse_count() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_parse_count;
+}
+
+void StylesheetCache::evict_if_needed() {
+    while (m_entries.size() > m_max_entries && !m_lru.empty()) {
+        m_entries.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+}
+
+}  // namespace Hummingbird::Css
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "style/Stylesheet.h"
+
+namespace Hummingbird::Css {
+
+// Caches parsed stylesheets keyed by source (URL, or empty for inline <style> blocks) and content hash, so shared
+// site stylesheets and repeated inline blocks are tokenized and parsed once instead of on every navigation.
+class StylesheetCache {
+public:
+    explicit StylesheetCache(size_t max_entries = kDefaultMaxEntries) : m_max_entries(max_entries) {}
+
+    // Returns the parsed sheet for |css|, parsing it only if this (source_key, content) pair is not cached.
+    std::shared_ptr<const Stylesheet> get_or_parse(std::string_view source_key, std::string_view css);
+
+    void clear();
+    size_t size() const;
+    size_t parse_count() const;
+
+    static uint64_t hash_content(std::string_view css);
+
+private:
+    static constexpr size_t kDefaultMaxEntries = 64;
+
+    struct Key {
+        std::string source;
+        uint64_t content_hash = 0;
+        size_t content_size = 0;
+
+        bool operator==(const Key& other) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        std::shared_ptr<const Stylesheet> sheet;
+        std::list<Key>::iterator lru_it;
+    };
+
+    void evict_if_needed();
+
+    size_t m_max_entries;
+    size_t m_parse_count = 0;
+    mutable std::mutex m_mutex;
+    std::unordered_map<Key, Entry, KeyHash> m_entries;
+    std::list<Key> m_lru;  // front = most recently used
+};
+
+}  // namespace Hummingbird::Css
@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "app/BatchRenderer.h"
+#include "core/platform_api/IOffscreenGraphicsContext.h"
+#include "core/platform_api/ResourceProviderFactory.h"
+#include "core/utils/AllocationStats.h"
+
+namespace {
+// Checksums what is drawn instead of rasterizing; text metrics match TestGraphicsContext (8px per character, 16px
+// lines). The "PNG" is the draw call count and a checksum of every draw since the last clear, so results can be
+// compared between runs and a page drawn in place of another shows up.
+class CountingOffscreenContext : public IOffscreenGraphicsContext {
+public:
+    CountingOffscreenContext(int width, int height) : m_width(width), m_height(height) {}
+
+    void set_viewport(const Hummingbird::Layout::Rect& /*viewport*/) override {}
+    void clear(const Color& /*color*/) override {
+        m_draw_calls = 0;
+        m_checksum = kFnvOffset;
+    }
+    void present() override {}
+    void fill_rect(const Hummingbird::Layout::Rect& rect, const Color& /*color*/) override {
+        ++m_draw_calls;
+        for (float coordinate : {rect.x, rect.y, rect.width, rect.height}) {
+            mix_coordinate(coordinate);
+        }
+    }
+    TextMetrics measure_text(std::string_view text, const TextStyle& /*style*/) override {
+        return TextMetrics{.width = static_cast<float>(text.size()) * 8.0f, .height = 16.0f};
+    }
+    void draw_text(std::string_view text, float x, float y, const TextStyle& /*style*/) override {
+        ++m_draw_calls;
+        for (char c : text) {
+            mix(static_cast<unsigned char>(c));
+        }
+        mix_coordinate(x);
+        mix_coordinate(y);
+    }
+
+    std::pair<int, int> get_size() const override { return {m_width, m_height}; }
+    void resize(int width, int height) override {
+        m_width = width;
+        m_height = height;
+    }
+    std::vector<uint8_t> encode_png() override {
+        std::vector<uint8_t> bytes{static_cast<uint8_t>(m_draw_calls)};
+        for (int shift = 0; shift < 64; shift += 8) {
+            bytes.push_back(static_cast<uint8_t>(m_checksum >> shift));
+        }
+        return bytes;
+    }
+
+private:
+    static constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+
+    void mix(uint64_t value) { m_checksum = (m_checksum ^ value) * 1099511628211ull; }
+    void mix_coordinate(float value) { mix(static_cast<uint64_t>(static_cast<int64_t>(value * 64.0f))); }
+
+    int m_width = 0;
+    int m_height = 0;
+    int m_draw_calls = 0;
+    uint64_t m_checksum = kFnvOffset;
+};
+
+std::map<std::string, std::string> make_corpus(int count) {
+    std::map<std::string, std::string> corpus;
+    for (int i = 0; i < count; ++i) {
+        std::string html = "<html><head><style>p { margin: 4px; }</style></head><body>";
+        for (int p = 0; p <= i % 5; ++p) {
+            html += "<p>paragraph " + std::to_string(p) + " of page " + std::to_string(i) + "</p>";
+        }
+        html += "</body></html>";
+        corpus.emplace("page" + std::to_string(i), std::move(html));
+    }
+    return corpus;
+}
+
+// Writes the "PNGs" to |output_dir| when it is set.
+std::vector<BatchDocumentResult> render_corpus(size_t worker_count, const std::vector<std::string>& inputs,
+                                               const std::map<std::string, std::string>& corpus,
+                                               const std::filesystem::path& output_dir = {}) {
+    auto resources = create_resource_provider();
+    BatchSettings settings;
+    settings.width = 400;
+    settings.height = 300;
+    settings.worker_count = worker_count;
+    settings.output_dir = output_dir;
+    settings.write_png = !output_dir.empty();
+    BatchRenderer renderer(settings, resources.get(), [](int width, int height) {
+        return std::make_unique<CountingOffscreenContext>(width, height);
+    });
+    return renderer.render(inputs, [&corpus](const std::string& input) -> std::optional<std::string> {
+        auto it = corpus.find(input);
+        if (it == corpus.end()) return std::nullopt;
+        return it->second;
+    });
+}
+// Lets a test allocation escape so the optimizer cannot drop it.
+char* volatile g_escaped_block = nullptr;
+
+std::filesystem::path make_scratch_dir(const std::string& name) {
+    auto dir = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::string read_all(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+}  // namespace
+
+TEST(BatchRendererTest, ParallelRunMatchesSequentialRunInInputOrder) {
+    auto corpus = make_corpus(40);
+    std::vector<std::string> inputs;
+    for (const auto& [name, html] : corpus) {
+        inputs.push_back(name);
+    }
+    inputs.push_back("missing");
+
+    auto sequential = render_corpus(1, inputs, corpus, make_scratch_dir("hb_batch_sequential"));
+    auto parallel = render_corpus(4, inputs, corpus, make_scratch_dir("hb_batch_parallel"));
+    ASSERT_EQ(sequential.size(), inputs.size());
+    ASSERT_EQ(parallel.size(), inputs.size());
+
+    std::set<std::string> distinct_images;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        EXPECT_EQ(parallel[i].input, inputs[i]);
+        EXPECT_EQ(parallel[i].ok, sequential[i].ok) << inputs[i];
+        if (!sequential[i].ok) continue;
+        // Same image as the sequential run, so every worker drew the document it was handed.
+        const std::string image = read_all(sequential[i].output);
+        EXPECT_FALSE(image.empty()) << inputs[i];
+        EXPECT_EQ(read_all(parallel[i].output), image) << inputs[i];
+        distinct_images.insert(image);
+    }
+    // Every page has its own text, so the comparison can tell pages apart.
+    EXPECT_EQ(distinct_images.size(), corpus.size());
+    EXPECT_FALSE(parallel.back().ok);
+    EXPECT_EQ(sequential.back().error, "failed to load input");
+}
+
+TEST(BatchRendererTest, EveryWorkerTakesPart) {
+    constexpr size_t kWorkers = 4;
+    auto corpus = make_corpus(static_cast<int>(kWorkers));
+    std::vector<std::string> inputs;
+    for (const auto& [name, html] : corpus) {
+        inputs.push_back(name);
+    }
+
+    // Each load waits until every worker holds an input, so the calling thread can't drain the batch on its own.
+    std::mutex mutex;
+    std::condition_variable all_entered;
+    std::set<std::thread::id> loading_threads;
+    auto load = [&](const std::string& input) -> std::optional<std::string> {
+        std::unique_lock<std::mutex> lock(mutex);
+        loading_threads.insert(std::this_thread::get_id());
+        all_entered.notify_all();
+        all_entered.wait_for(lock, std::chrono::seconds(10), [&] { return loading_threads.size() == kWorkers; });
+        return corpus.at(input);
+    };
+
+    auto resources = create_resource_provider();
+    BatchSettings settings;
+    settings.worker_count = kWorkers;
+    BatchRenderer renderer(settings, resources.get(), [](int width, int height) {
+        return std::make_unique<CountingOffscreenContext>(width, height);
+    });
+    std::set<size_t> workers_used;
+    for (const auto& result : renderer.render(inputs, load)) {
+        EXPECT_TRUE(result.ok) << result.input << ": " << result.error;
+        workers_used.insert(result.worker);
+    }
+    EXPECT_EQ(loading_threads.size(), kWorkers);
+    EXPECT_EQ(workers_used.size(), kWorkers);
+}
+
+TEST(BatchRendererTest, WorkersAreReusedAcrossRenderCalls) {
+    auto corpus = make_corpus(8);
+    std::vector<std::string> inputs;
+    for (const auto& [name, html] : corpus) {
+        inputs.push_back(name);
+    }
+
+    auto resources = create_resource_provider();
+    BatchSettings settings;
+    settings.worker_count = 2;
+    BatchRenderer renderer(settings, resources.get(), [](int width, int height) {
+        return std::make_unique<CountingOffscreenContext>(width, height);
+    });
+    auto load = [&corpus](const std::string& input) -> std::optional<std::string> { return corpus.at(input); };
+    for (int round = 0; round < 3; ++round) {
+        for (const auto& result : renderer.render(inputs, load)) {
+            EXPECT_TRUE(result.ok) << result.input << ": " << result.error;
+            EXPECT_GT(result.pipeline.layout_ms + result.pipeline.parse_ms, 0.0);
+        }
+    }
+}
+
+TEST(BatchRendererTest, ReportsAllocationsPerStage) {
+    if (!Hummingbird::Core::Allocations::hooks_installed()) {
+        GTEST_SKIP() << "Configure with HB_ALLOCATION_STATS=ON to count allocations.";
+    }
+    auto corpus = make_corpus(4);
+    const std::vector<std::string> inputs = {"page1", "page3"};
+    for (const auto& result : render_corpus(2, inputs, corpus)) {
+        ASSERT_TRUE(result.ok) << result.input << ": " << result.error;
+        using Hummingbird::Core::Allocations::Stage;
+        for (Stage stage : {Stage::Parse, Stage::Style, Stage::TreeBuild, Stage::Layout}) {
+            EXPECT_GT(result.pipeline.allocations[stage].count, 0u) << result.input;
+            EXPECT_EQ(result.allocations[stage].count, result.pipeline.allocations[stage].count) << result.input;
+        }
+        EXPECT_GE(result.allocations.total().bytes, result.pipeline.allocations.total().bytes);
+    }
+}
+
+TEST(BatchRendererTest, ReportsAllocationsOfFailedInputs) {
+    if (!Hummingbird::Core::Allocations::hooks_installed()) {
+        GTEST_SKIP() << "Configure with HB_ALLOCATION_STATS=ON to count allocations.";
+    }
+    auto resources = create_resource_provider();
+    BatchRenderer renderer(BatchSettings{}, resources.get(), [](int width, int height) {
+        return std::make_unique<CountingOffscreenContext>(width, height);
+    });
+    // The loader allocates before giving up, as a failed read or fetch would.
+    auto results = renderer.render({"unreadable"}, [](const std::string& /*input*/) -> std::optional<std::string> {
+        std::string scratch(4096, 'x');
+        g_escaped_block = scratch.data();
+        return std::nullopt;
+    });
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_FALSE(results[0].ok);
+    EXPECT_GE(results[0].allocations[Hummingbird::Core::Allocations::Stage::Other].bytes, 4096u);
+}
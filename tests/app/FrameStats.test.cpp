@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "app/FrameStats.h"
+
+namespace {
+FrameTimes frame(double layout_ms, double paint_ms) {
+    FrameTimes times;
+    times.phase_ms[static_cast<size_t>(FramePhase::Layout)] = layout_ms;
+    times.phase_ms[static_cast<size_t>(FramePhase::Paint)] = paint_ms;
+    return times;
+}
+}  // namespace
+
+TEST(FrameHistogramTest, PercentilesResolveToBucketEdges) {
+    FrameHistogram histogram;
+    for (int i = 1; i <= 100; ++i) {
+        histogram.add(static_cast<double>(i) * 0.5);  // 0.5ms .. 50ms
+    }
+    EXPECT_EQ(histogram.count(), 100u);
+    EXPECT_NEAR(histogram.percentile(50.0), 25.1, 0.11);
+    EXPECT_NEAR(histogram.percentile(95.0), 47.6, 0.11);
+    EXPECT_NEAR(histogram.percentile(99.0), 49.6, 0.11);
+    EXPECT_DOUBLE_EQ(histogram.max_ms(), 50.0);
+    EXPECT_NEAR(histogram.mean_ms(), 25.25, 1e-9);
+}
+
+TEST(FrameHistogramTest, OverflowReportsExactMaximum) {
+    FrameHistogram histogram;
+    histogram.add(1.0);
+    histogram.add(250.0);
+    EXPECT_DOUBLE_EQ(histogram.percentile(99.0), 250.0);
+    EXPECT_EQ(FrameHistogram{}.percentile(50.0), 0.0);
+}
+
+TEST(FrameStatsTest, CountsJankAndMissedVsyncs) {
+    FrameStats stats;
+    stats.record_frame(frame(2.0, 3.0));    // within budget
+    stats.record_frame(frame(10.0, 10.0));  // one vsync missed
+    stats.record_frame(frame(40.0, 0.0));   // two missed
+    EXPECT_EQ(stats.frames(), 3u);
+    EXPECT_EQ(stats.janky_frames(), 2u);
+    EXPECT_EQ(stats.missed_vsyncs(), 3u);
+    EXPECT_DOUBLE_EQ(stats.total().max_ms(), 40.0);
+    EXPECT_DOUBLE_EQ(stats.phase(FramePhase::Paint).max_ms(), 10.0);
+    EXPECT_EQ(stats.phase(FramePhase::Present).max_ms(), 0.0);
+}
+
+TEST(FrameStatsTest, IdleFramesAreNotRecorded) {
+    FrameStats stats;
+    stats.begin_frame();
+    stats.end_frame();
+    EXPECT_EQ(stats.frames(), 0u);
+
+    stats.begin_frame();
+    { FrameStats::Scope paint(stats, FramePhase::Paint); }
+    stats.end_frame();
+    EXPECT_EQ(stats.frames(), 1u);
+}
+
+TEST(FrameStatsTest, NestedScopesPauseTheEnclosingPhase) {
+    FrameStats stats;
+    stats.begin_frame();
+    {
+        FrameStats::Scope event(stats, FramePhase::EventPump);
+        FrameStats::Scope layout(stats, FramePhase::Layout);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    stats.end_frame();
+    EXPECT_GE(stats.phase(FramePhase::Layout).max_ms(), 19.0);
+    EXPECT_LT(stats.phase(FramePhase::EventPump).max_ms(), 10.0);
+    EXPECT_EQ(stats.janky_frames(), 1u);
+}
+
+TEST(FrameStatsTest, WritesReportAndJson) {
+    FrameStats stats;
+    stats.record_frame(frame(1.0, 2.0));
+    EXPECT_NE(stats.overlay_text().find("jank 0/1"), std::string::npos);
+
+    std::ostringstream report;
+    stats.write_report(report);
+    EXPECT_NE(report.str().find("layout"), std::string::npos);
+    EXPECT_NE(report.str().find("total"), std::string::npos);
+
+    std::ostringstream json;
+    stats.write_json(json);
+    EXPECT_NE(json.str().find("\"frames\": 1"), std::string::npos);
+    EXPECT_NE(json.str().find("\"present\": {\"p50_ms\""), std::string::npos);
+}
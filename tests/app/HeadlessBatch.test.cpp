@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "app/HeadlessBatch.h"
+
+namespace {
+std::optional<HeadlessOptions> parse(std::vector<std::string> args) {
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    return parse_headless_args(static_cast<int>(argv.size()), argv.data());
+}
+
+std::filesystem::path make_scratch_dir(const std::string& name) {
+    auto dir = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::string read_all(const std::filesystem::path& path) {
+    std::ifstream in(path);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+}  // namespace
+
+TEST(HeadlessBatchTest, ParsesOptionsAndInputLists) {
+    auto dir = make_scratch_dir("hb_headless_args");
+    std::ofstream(dir / "inputs.txt") << "# pages\nb.html\n\n  https://example.dev/c  \n";
+
+    auto options = parse({"Hummingbird", "--headless", "--width", "640", "--height", "480", "--raster-threads", "4",
+                          "--out", "shots", "--timings", "t.json", "--trace", "trace.json", "a.html",
+                          "@" + (dir / "inputs.txt").string()});
+    ASSERT_TRUE(options.has_value());
+    EXPECT_EQ(options->width, 640);
+    EXPECT_EQ(options->height, 480);
+    EXPECT_EQ(options->raster_threads, 4u);
+    EXPECT_EQ(options->output_dir, "shots");
+    EXPECT_EQ(options->timings_path, "t.json");
+    EXPECT_EQ(options->trace_path, "trace.json");
+    EXPECT_EQ(options->inputs, (std::vector<std::string>{"a.html", "b.html", "https://example.dev/c"}));
+
+    EXPECT_FALSE(parse({"Hummingbird", "--headless"}).has_value());
+    EXPECT_FALSE(parse({"Hummingbird", "--headless", "--width", "0", "a.html"}).has_value());
+    EXPECT_FALSE(parse({"Hummingbird", "--headless", "--raster-threads", "1000", "a.html"}).has_value());
+    EXPECT_FALSE(parse({"Hummingbird", "--headless", "--bogus", "a.html"}).has_value());
+}
+
+TEST(HeadlessBatchTest, ParsesRasterThreadCounts) {
+    EXPECT_EQ(parse_raster_threads("0"), 0u);
+    EXPECT_EQ(parse_raster_threads("8"), 8u);
+    EXPECT_EQ(parse_raster_threads("64"), kMaxRasterThreads);
+    EXPECT_FALSE(parse_raster_threads("65").has_value());
+    EXPECT_FALSE(parse_raster_threads("").has_value());
+    EXPECT_FALSE(parse_raster_threads("-1").has_value());
+    EXPECT_FALSE(parse_raster_threads("4x").has_value());
+    EXPECT_FALSE(parse_raster_threads("99999999999").has_value());
+}
+
+TEST(HeadlessBatchTest, RendersFilesToPngsWithStageTimings) {
+    auto dir = make_scratch_dir("hb_headless_render");
+    std::ofstream(dir / "page.html") << "<html><body><h1>Title</h1><p>Some text.</p></body></html>";
+
+    HeadlessOptions options;
+    options.width = 200;
+    options.height = 120;
+    options.output_dir = dir / "out";
+    options.timings_path = dir / "timings.json";
+    options.inputs = {(dir / "page.html").string(), (dir / "missing.html").string()};
+
+    EXPECT_EQ(run_headless_batch(options), 1);  // one input is missing
+    EXPECT_TRUE(std::filesystem::exists(dir / "out" / "0000-page.png"));
+
+    std::string json = read_all(options.timings_path);
+    for (const char* key : {"\"parse_ms\"", "\"style_ms\"", "\"tree_ms\"", "\"layout_ms\"", "\"paint_ms\"",
+                            "\"encode_ms\"", "\"pages_per_second_per_core\"", "\"ok\": false"}) {
+        EXPECT_NE(json.find(key), std::string::npos) << key;
+    }
+}
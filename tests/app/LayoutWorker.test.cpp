@@ -0,0 +1,138 @@
+#include "app/LayoutWorker.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "../layout/TestGraphicsContext.h"
+#include "layout/RenderObject.h"
+#include "style/Stylesheet.h"
+
+namespace {
+constexpr Hummingbird::Layout::Rect kViewport{0, 0, 400, 300};
+constexpr auto kTimeout = std::chrono::seconds(10);
+
+// A page whose style stage loads "gate.css", which blocks in GatedResources until the test opens the gate.
+const std::string kGatedPage =
+    "<html><head><link rel=\"stylesheet\" href=\"gate.css\"></head><body><p>gated</p></body></html>";
+const std::string kPlainPage = "<html><body><p>plain</p></body></html>";
+
+// Serves "p { margin: 1px; }" for every stylesheet, holding the first caller until open() so the test can change
+// things while a build is parked between parse and style.
+class GatedResources : public IResourceProvider {
+public:
+    std::optional<std::string> load_text(std::string_view /*resource_id*/) override { return std::nullopt; }
+
+    std::optional<ResourceView> map_resource(std::string_view /*resource_id*/) override {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_entered = true;
+        m_changed.notify_all();
+        m_changed.wait(lock, [this] { return m_open; });
+        static constexpr std::string_view kCss = "p { margin: 1px; }";
+        return ResourceView{nullptr, kCss};
+    }
+
+    // Returns false when no build reached the style stage in time.
+    bool wait_until_entered() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_changed.wait_for(lock, kTimeout, [this] { return m_entered; });
+    }
+
+    void open() {
+        {
+            std::lock_guard<std::mutex> lg(m_mutex);
+            m_open = true;
+        }
+        m_changed.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    bool m_entered = false;
+    bool m_open = false;
+};
+
+std::unique_ptr<DocumentSnapshot> wait_for_snapshot(LayoutWorker& worker) {
+    const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (auto snapshot = worker.take_ready()) return snapshot;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return nullptr;
+}
+
+struct WorkerFixture {
+    TestGraphicsContext graphics;
+    GatedResources resources;
+    std::atomic<uint64_t> active_nav{1};
+    LayoutWorker worker{graphics, &resources, std::make_shared<const Hummingbird::Css::Stylesheet>(), active_nav};
+};
+}  // namespace
+
+TEST(LayoutWorkerTest, HandsOutEachSnapshotOnce) {
+    WorkerFixture fixture;
+    fixture.resources.open();
+    fixture.worker.submit(1, kPlainPage, kViewport);
+
+    auto snapshot = wait_for_snapshot(fixture.worker);
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->nav_id, 1u);
+    EXPECT_NE(snapshot->render_tree, nullptr);
+    EXPECT_EQ(fixture.worker.take_ready(), nullptr);
+}
+
+TEST(LayoutWorkerTest, KeepsOnlyTheNewestPendingJob) {
+    WorkerFixture fixture;
+    fixture.worker.submit(1, kGatedPage, kViewport);
+    ASSERT_TRUE(fixture.resources.wait_until_entered());
+
+    // While the worker is parked in job 1, job 3 replaces job 2 before it can start.
+    fixture.worker.submit(2, kPlainPage, kViewport);
+    fixture.worker.submit(3, kPlainPage, kViewport);
+    fixture.active_nav = 3;
+    fixture.resources.open();
+
+    auto snapshot = wait_for_snapshot(fixture.worker);
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->nav_id, 3u);
+    fixture.worker.stop();
+    EXPECT_EQ(fixture.worker.take_ready(), nullptr);
+}
+
+TEST(LayoutWorkerTest, DropsABuildWhoseNavigationMovedOn) {
+    WorkerFixture fixture;
+    fixture.worker.submit(1, kGatedPage, kViewport);
+    ASSERT_TRUE(fixture.resources.wait_until_entered());
+
+    fixture.active_nav = 2;
+    fixture.resources.open();
+    // stop() waits for the job in flight, so whatever it produced is in the ready slot afterwards.
+    fixture.worker.stop();
+    EXPECT_EQ(fixture.worker.take_ready(), nullptr);
+}
+
+TEST(LayoutWorkerTest, StopJoinsWithAJobInFlight) {
+    WorkerFixture fixture;
+    fixture.worker.submit(1, kGatedPage, kViewport);
+    ASSERT_TRUE(fixture.resources.wait_until_entered());
+
+    auto stopped = std::async(std::launch::async, [&fixture] { fixture.worker.stop(); });
+    fixture.resources.open();
+    ASSERT_EQ(stopped.wait_for(kTimeout), std::future_status::ready);
+
+    // The job in flight still finishes; later calls are no-ops.
+    auto snapshot = fixture.worker.take_ready();
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->nav_id, 1u);
+    fixture.worker.submit(3, kPlainPage, kViewport);
+    fixture.worker.stop();
+    EXPECT_EQ(fixture.worker.take_ready(), nullptr);
+}
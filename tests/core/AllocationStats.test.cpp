@@ -0,0 +1,89 @@
+#include "core/utils/AllocationStats.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <thread>
+
+namespace Allocations = Hummingbird::Core::Allocations;
+
+namespace {
+char* volatile g_escaped_block = nullptr;
+
+// Heap allocations the optimizer cannot drop: each block escapes through a volatile global before it is freed.
+void allocate(size_t count, size_t bytes) {
+    for (size_t i = 0; i < count; ++i) {
+        g_escaped_block = new char[bytes];
+        delete[] g_escaped_block;
+    }
+}
+}  // namespace
+
+TEST(AllocationStatsTest, HooksAreLinkedIntoThisExecutable) {
+    EXPECT_TRUE(Allocations::hooks_installed());
+}
+
+TEST(AllocationStatsTest, FailedAllocationsConsultTheNewHandler) {
+    static int handler_calls = 0;
+    handler_calls = 0;
+    // Gives up on the second failure, like a handler with nothing left to free.
+    std::set_new_handler([] {
+        ++handler_calls;
+        std::set_new_handler(nullptr);
+    });
+    const volatile std::size_t impossible = std::numeric_limits<std::size_t>::max() / 2;
+    EXPECT_THROW(::operator delete(::operator new(impossible)), std::bad_alloc);
+    EXPECT_EQ(handler_calls, 1);
+    std::set_new_handler(nullptr);
+}
+
+TEST(AllocationStatsTest, ChargesTheEnclosingStage) {
+    const auto before = Allocations::thread_snapshot();
+    {
+        Allocations::StageScope parse(Allocations::Stage::Parse);
+        allocate(3, 100);
+        {
+            Allocations::StageScope layout(Allocations::Stage::Layout);
+            allocate(2, 1000);
+        }
+        allocate(1, 100);
+    }
+    const auto delta = Allocations::thread_snapshot() - before;
+
+    EXPECT_EQ(delta[Allocations::Stage::Parse].count, 4u);
+    EXPECT_EQ(delta[Allocations::Stage::Parse].bytes, 400u);
+    EXPECT_EQ(delta[Allocations::Stage::Layout].count, 2u);
+    EXPECT_EQ(delta[Allocations::Stage::Layout].bytes, 2000u);
+    EXPECT_EQ(delta[Allocations::Stage::Style].count, 0u);
+    EXPECT_EQ(delta.total().count, delta[Allocations::Stage::Other].count + 6u);
+}
+
+TEST(AllocationStatsTest, CountsArePerThread) {
+    const auto before = Allocations::thread_snapshot();
+    std::thread worker([] {
+        Allocations::StageScope paint(Allocations::Stage::Paint);
+        allocate(50, 64);
+    });
+    worker.join();
+    const auto delta = Allocations::thread_snapshot() - before;
+    EXPECT_EQ(delta[Allocations::Stage::Paint].count, 0u);
+}
+
+TEST(AllocationStatsTest, SummaryListsStagesThatAllocated) {
+    Allocations::Snapshot snapshot;
+    snapshot.stages[static_cast<size_t>(Allocations::Stage::Style)] = {12, 2048};
+    Allocations::Snapshot more;
+    more.stages[static_cast<size_t>(Allocations::Stage::Style)] = {3, 1024};
+    snapshot += more;
+
+    std::ostringstream out;
+    Allocations::write_summary(out, snapshot);
+    EXPECT_EQ(out.str(), "style 15 (3.0 KB)");
+
+    std::ostringstream empty;
+    Allocations::write_summary(empty, Allocations::Snapshot{});
+    EXPECT_EQ(empty.str(), "none");
+}
@@ -24,6 +24,8 @@ TEST(ArenaAllocatorTest, Reset) {
     void* ptr2 = allocator.allocate(70);
     ASSERT_NE(ptr2, nullptr);
     // After reset, we should be able to allocate more than the remaining space before reset
+    EXPECT_EQ(ptr2, ptr1);  // same buffer, reused from the start
+    EXPECT_EQ(allocator.capacity(), 100u);
 }
 
 TEST(ArenaAllocatorTest, ZeroAllocation) {
@@ -0,0 +1,47 @@
+#include "core/dom/Text.h"
+
+#include <gtest/gtest.h>
+
+#include "core/ArenaAllocator.h"
+#include "core/dom/DomFactory.h"
+
+using namespace Hummingbird::DOM;
+
+TEST(TextTest, CollapsesWhitespaceIntoWordAndSpaceSegments) {
+    ArenaAllocator arena(1024);
+    auto text = DomFactory::create_text(arena, "  Hello \n\t world ");
+
+    const auto& prepared = text->prepared_text(WhitespaceMode::Collapse);
+    EXPECT_EQ(prepared.text, " Hello world ");
+    ASSERT_EQ(prepared.segments.size(), 5u);
+    EXPECT_TRUE(prepared.segments[0].is_space);
+    EXPECT_EQ(prepared.slice(prepared.segments[1]), "Hello");
+    EXPECT_TRUE(prepared.segments[2].is_space);
+    EXPECT_EQ(prepared.slice(prepared.segments[3]), "world");
+    EXPECT_TRUE(prepared.segments[4].is_space);
+}
+
+TEST(TextTest, PreservedTextIsSegmentedByLine) {
+    ArenaAllocator arena(1024);
+    auto text = DomFactory::create_text(arena, "Line1\n  Line2");
+
+    const auto& prepared = text->prepared_text(WhitespaceMode::Preserve);
+    EXPECT_EQ(prepared.text, "Line1\n  Line2");
+    ASSERT_EQ(prepared.segments.size(), 2u);
+    EXPECT_EQ(prepared.slice(prepared.segments[0]), "Line1");
+    EXPECT_EQ(prepared.slice(prepared.segments[1]), "  Line2");
+}
+
+TEST(TextTest, CachesPreparedTextUntilTextChanges) {
+    ArenaAllocator arena(1024);
+    auto text = DomFactory::create_text(arena, "a b");
+
+    const auto* first = &text->prepared_text(WhitespaceMode::Collapse);
+    const char* first_data = first->text.data();
+    EXPECT_EQ(text->prepared_text(WhitespaceMode::Collapse).text.data(), first_data);
+
+    text->append(" c");
+    const auto& updated = text->prepared_text(WhitespaceMode::Collapse);
+    EXPECT_EQ(updated.text, "a b c");
+    EXPECT_EQ(updated.segments.size(), 5u);
+}
@@ -0,0 +1,147 @@
+#include "core/utils/Trace.h"
+
+#include <gtest/gtest.h>
+
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace Trace = Hummingbird::Core::Trace;
+
+namespace {
+std::string export_trace() {
+    std::ostringstream out;
+    Trace::write_chrome_json(out);
+    return out.str();
+}
+
+size_t count_occurrences(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + needle.size())) {
+        ++count;
+    }
+    return count;
+}
+
+// The tid the export gives to zones named |zone| and to the thread named |thread|; empty when either is missing.
+std::pair<std::string, std::string> exported_tids(const std::string& json, const std::string& thread,
+                                                  const std::string& zone) {
+    std::smatch named;
+    std::smatch zoned;
+    std::regex_search(json, named, std::regex(R"("tid":(\d+),"args":\{"name":")" + thread + "\""));
+    std::regex_search(json, zoned, std::regex(R"("tid":(\d+),"cat":"test","name":")" + zone + "\""));
+    return {named.empty() ? "" : named[1].str(), zoned.empty() ? "" : zoned[1].str()};
+}
+
+// Tracing is process-wide state: every test starts from an empty, stopped recorder.
+class TraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Trace::stop();
+        Trace::clear();
+    }
+    void TearDown() override {
+        Trace::stop();
+        Trace::clear();
+    }
+};
+}  // namespace
+
+TEST_F(TraceTest, ZonesRecordOnlyWhileRecording) {
+    { Trace::Zone zone("test", "before start"); }
+    Trace::start();
+    { Trace::Zone zone("test", "while recording"); }
+    Trace::stop();
+    { Trace::Zone zone("test", "after stop"); }
+
+    const std::string json = export_trace();
+    EXPECT_EQ(json.find("before start"), std::string::npos);
+    EXPECT_NE(json.find(R"("cat":"test","name":"while recording")"), std::string::npos);
+    EXPECT_EQ(json.find("after stop"), std::string::npos);
+}
+
+TEST_F(TraceTest, ExportsCompleteEventsPerNamedThread) {
+    Trace::start();
+    std::thread worker([] {
+        Trace::set_thread_name("trace \"worker\"");
+        Trace::Zone outer("test", "outer");
+        Trace::Zone inner("test", "inner");
+    });
+    worker.join();
+    Trace::stop();
+
+    const std::string json = export_trace();
+    EXPECT_EQ(json.rfind(R"({"displayTimeUnit":"ms","traceEvents":[)", 0), 0u);
+    EXPECT_NE(json.find(R"("name":"thread_name")"), std::string::npos);
+    EXPECT_NE(json.find(R"({"name":"trace \"worker\""})"), std::string::npos);
+    EXPECT_EQ(count_occurrences(json, R"("ph":"X")"), 2u);
+    // The inner zone closes first, so it is recorded first.
+    EXPECT_LT(json.find(R"("name":"inner")"), json.find(R"("name":"outer")"));
+}
+
+TEST_F(TraceTest, ClearForgetsRecordedZones) {
+    Trace::start();
+    { Trace::Zone zone("test", "forgotten"); }
+    Trace::clear();
+    { Trace::Zone zone("test", "kept"); }
+    Trace::stop();
+
+    const std::string json = export_trace();
+    EXPECT_EQ(json.find("forgotten"), std::string::npos);
+    EXPECT_NE(json.find("kept"), std::string::npos);
+}
+
+TEST_F(TraceTest, FullRingKeepsTheNewestZones) {
+    Trace::start();
+    // Far more zones than one thread's ring holds.
+    for (int i = 0; i < 100000; ++i) {
+        Trace::record("test", "old", 1, 2);
+    }
+    Trace::record("test", "newest", 3, 4);
+    Trace::stop();
+
+    const std::string json = export_trace();
+    EXPECT_NE(json.find("newest"), std::string::npos);
+    EXPECT_LT(count_occurrences(json, R"("name":"old")"), 100000u);
+    EXPECT_NE(json.find(R"("ts":0.003,"dur":0.001)"), std::string::npos);
+}
+
+TEST_F(TraceTest, NamingAThreadThatNeverRecordsCostsNoRing) {
+    const size_t rings = Trace::detail::ring_count();
+    std::thread worker([] {
+        Trace::set_thread_name("idle worker");
+        Trace::Zone zone("test", "not recorded");
+    });
+    worker.join();
+
+    EXPECT_EQ(Trace::detail::ring_count(), rings);
+    EXPECT_EQ(export_trace().find("idle worker"), std::string::npos);
+}
+
+TEST_F(TraceTest, ExitedThreadsHandTheirRingOn) {
+    const size_t rings = Trace::detail::ring_count();
+    Trace::start();
+    for (const char* name : {"first", "second", "third"}) {
+        std::thread worker([name] {
+            Trace::set_thread_name(name);
+            Trace::record("test", name, 1, 2);
+        });
+        worker.join();
+    }
+    Trace::stop();
+    EXPECT_LE(Trace::detail::ring_count(), rings + 1);
+
+    // Each thread keeps its own tid and name in the export, even though they shared a ring.
+    const std::string json = export_trace();
+    std::set<std::string> tids;
+    for (const char* name : {"first", "second", "third"}) {
+        const auto [named, zoned] = exported_tids(json, name, name);
+        ASSERT_FALSE(named.empty()) << name;
+        EXPECT_EQ(named, zoned) << name;
+        tids.insert(named);
+    }
+    EXPECT_EQ(tids.size(), 3u);
+}
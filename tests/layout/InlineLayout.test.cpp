@@ -307,6 +307,35 @@ TEST(InlineLayoutTest, AlignAttributeCentersInlineText) {
     EXPECT_FLOAT_EQ(text_rect.x, 92.0f);
 }
 
+TEST(InlineLayoutTest, CenteringIgnoresTrailingSpace) {
+    ArenaAllocator arena(4096);
+    auto body = DomFactory::create_element(arena, "body");
+    auto p = DomFactory::create_element(arena, "p");
+    p->set_attribute(Attr::Align, "center");
+    p->append_child(DomFactory::create_text(arena, "Hi "));
+    body->append_child(std::move(p));
+
+    Stylesheet sheet;
+    StyleEngine engine;
+    engine.apply(sheet, body.get());
+
+    TreeBuilder builder;
+    auto render_root = builder.build(body.get());
+    ASSERT_NE(render_root, nullptr);
+
+    TestGraphicsContext context;
+    Rect viewport{0, 0, 200, 200};
+    render_root->layout(context, viewport);
+
+    const auto& para = render_root->get_children()[0];
+    ASSERT_EQ(para->get_children().size(), 1u);
+    const auto& text_rect = para->get_children()[0]->get_rect();
+
+    // "Hi" is centered on its own; the trailing space hangs past it.
+    EXPECT_FLOAT_EQ(text_rect.width, 24.0f);
+    EXPECT_FLOAT_EQ(text_rect.x, 92.0f);
+}
+
 TEST(InlineLayoutTest, NoWrapAttributeKeepsSingleLine) {
     ArenaAllocator arena(4096);
     auto body = DomFactory::create_element(arena, "body");
@@ -334,3 +363,80 @@ TEST(InlineLayoutTest, NoWrapAttributeKeepsSingleLine) {
     EXPECT_FLOAT_EQ(text_rect.height, 16.0f);
     EXPECT_GT(text_rect.width, viewport.width);
 }
+
+namespace {
+std::unique_ptr<RenderObject> build_paragraph_tree(ArenaAllocator& arena, ArenaPtr<Element>& body_out) {
+    auto body = DomFactory::create_element(arena, "body");
+    auto p = DomFactory::create_element(arena, "p");
+    p->append_child(DomFactory::create_text(arena, "one two three four five six"));
+    body->append_child(std::move(p));
+
+    Stylesheet sheet;
+    StyleEngine engine;
+    engine.apply(sheet, body.get());
+
+    TreeBuilder builder;
+    auto render_root = builder.build(body.get());
+    body_out = std::move(body);
+    return render_root;
+}
+}  // namespace
+
+TEST(InlineLayoutTest, RepeatedLayoutAtSameWidthIsCached) {
+    ArenaAllocator arena(4096);
+    ArenaPtr<Element> body;
+    auto render_root = build_paragraph_tree(arena, body);
+    ASSERT_NE(render_root, nullptr);
+
+    TestGraphicsContext context;
+    render_root->layout(context, {0, 0, 300, 200});
+    const int calls_after_first = context.measure_text_calls;
+    const Rect first_rect = render_root->get_children()[0]->get_rect();
+    EXPECT_GT(calls_after_first, 0);
+
+    render_root->layout(context, {0, 10, 300, 200});
+    EXPECT_EQ(context.measure_text_calls, calls_after_first);
+    EXPECT_FLOAT_EQ(render_root->get_rect().y, 10.0f);
+    const Rect& second_rect = render_root->get_children()[0]->get_rect();
+    EXPECT_FLOAT_EQ(second_rect.width, first_rect.width);
+    EXPECT_FLOAT_EQ(second_rect.height, first_rect.height);
+}
+
+TEST(InlineLayoutTest, WidthChangeReusesMeasuredRuns) {
+    ArenaAllocator arena(4096);
+    ArenaPtr<Element> body;
+    auto render_root = build_paragraph_tree(arena, body);
+    ASSERT_NE(render_root, nullptr);
+
+    TestGraphicsContext context;
+    render_root->layout(context, {0, 0, 300, 200});
+    const int calls_after_first = context.measure_text_calls;
+    const float wide_height = render_root->get_children()[0]->get_rect().height;
+
+    render_root->layout(context, {0, 0, 80, 200});
+    EXPECT_EQ(context.measure_text_calls, calls_after_first);
+    EXPECT_GT(render_root->get_children()[0]->get_rect().height, wide_height);
+
+    render_root->layout(context, {0, 0, 300, 200});
+    EXPECT_FLOAT_EQ(render_root->get_children()[0]->get_rect().height, wide_height);
+}
+
+TEST(InlineLayoutTest, MarkNeedsLayoutRemeasuresInlineContent) {
+    ArenaAllocator arena(4096);
+    ArenaPtr<Element> body;
+    auto render_root = build_paragraph_tree(arena, body);
+    ASSERT_NE(render_root, nullptr);
+
+    TestGraphicsContext context;
+    render_root->layout(context, {0, 0, 300, 200});
+    const int calls_after_first = context.measure_text_calls;
+
+    auto& paragraph = render_root->get_children()[0];
+    ASSERT_FALSE(paragraph->get_children().empty());
+    paragraph->get_children()[0]->mark_needs_layout();
+    EXPECT_TRUE(render_root->needs_layout());
+
+    render_root->layout(context, {0, 0, 300, 200});
+    EXPECT_GT(context.measure_text_calls, calls_after_first);
+    EXPECT_FALSE(render_root->needs_layout());
+}
@@ -4,12 +4,13 @@
 
 using Hummingbird::Layout::InlineLineBuilder;
 using Hummingbird::Layout::InlineRun;
+using Hummingbird::Layout::LineBreakMode;
 
 TEST(InlineLineBuilderTest, WrapsRunsAcrossLines) {
     InlineLineBuilder builder;
-    builder.add_run({nullptr, 0, "", 6.0f, 10.0f});
-    builder.add_run({nullptr, 0, "", 6.0f, 10.0f});
-    builder.add_run({nullptr, 0, "", 4.0f, 12.0f});
+    builder.add_run({nullptr, 0, 0, 0, 6.0f, 10.0f});
+    builder.add_run({nullptr, 0, 0, 0, 6.0f, 10.0f});
+    builder.add_run({nullptr, 0, 0, 0, 4.0f, 12.0f});
 
     auto lines = builder.layout(10.0f);
     ASSERT_EQ(lines.size(), 2u);
@@ -32,8 +33,8 @@ TEST(InlineLineBuilderTest, WrapsRunsAcrossLines) {
 
 TEST(InlineLineBuilderTest, HonorsStartOffset) {
     InlineLineBuilder builder;
-    builder.add_run({nullptr, 0, "", 6.0f, 10.0f});
-    builder.add_run({nullptr, 0, "", 6.0f, 10.0f});
+    builder.add_run({nullptr, 0, 0, 0, 6.0f, 10.0f});
+    builder.add_run({nullptr, 0, 0, 0, 6.0f, 10.0f});
 
     auto lines = builder.layout(10.0f, 4.0f);
     ASSERT_EQ(lines.size(), 2u);
@@ -47,3 +48,58 @@ TEST(InlineLineBuilderTest, HonorsStartOffset) {
     EXPECT_FLOAT_EQ(lines[1].fragments[0].rect.x, 0.0f);
     EXPECT_FLOAT_EQ(lines[1].fragments[0].rect.y, 10.0f);
 }
+
+TEST(InlineLineBuilderTest, OptimalModeBalancesLines) {
+    // Greedy fills the first line (10+40+40) and strands a single run on the second; total-fit moves one run down
+    // so the first two lines share the slack.
+    InlineLineBuilder builder;
+    for (float width : {10.0f, 40.0f, 40.0f, 40.0f, 70.0f}) {
+        builder.add_run({nullptr, 0, 0, 0, width, 10.0f});
+    }
+
+    auto greedy = builder.layout(100.0f, 0.0f, LineBreakMode::Greedy);
+    ASSERT_EQ(greedy.size(), 3u);
+    EXPECT_EQ(greedy[0].fragments.size(), 3u);
+    EXPECT_EQ(greedy[1].fragments.size(), 1u);
+
+    auto optimal = builder.layout(100.0f, 0.0f, LineBreakMode::Optimal);
+    ASSERT_EQ(optimal.size(), 3u);
+    ASSERT_EQ(optimal[0].fragments.size(), 2u);
+    ASSERT_EQ(optimal[1].fragments.size(), 2u);
+    ASSERT_EQ(optimal[2].fragments.size(), 1u);
+    EXPECT_EQ(optimal[1].fragments[0].run_index, 2u);
+    EXPECT_EQ(optimal[1].fragments[0].line_index, 1u);
+    EXPECT_FLOAT_EQ(optimal[1].fragments[0].rect.x, 0.0f);
+    EXPECT_FLOAT_EQ(optimal[1].fragments[1].rect.x, 40.0f);
+    EXPECT_FLOAT_EQ(optimal[2].fragments[0].rect.y, 20.0f);
+}
+
+TEST(InlineLineBuilderTest, OptimalModeKeepsOverwideRunAlone) {
+    InlineLineBuilder builder;
+    builder.add_run({nullptr, 0, 0, 0, 30.0f, 10.0f});
+    builder.add_run({nullptr, 0, 0, 0, 150.0f, 10.0f});
+    builder.add_run({nullptr, 0, 0, 0, 30.0f, 10.0f});
+
+    auto lines = builder.layout(100.0f, 0.0f, LineBreakMode::Optimal);
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(lines[0].fragments.size(), 1u);
+    EXPECT_EQ(lines[1].fragments.size(), 1u);
+    EXPECT_EQ(lines[1].fragments[0].run_index, 1u);
+    EXPECT_EQ(lines[2].fragments.size(), 1u);
+}
+
+TEST(InlineLineBuilderTest, OptimalModeLetsTrailingSpaceHang) {
+    // "A B C" with each word 45 wide: the space after B hangs past the 100 wide line instead of overflowing it, so
+    // the first line ends after that space rather than before it (which would start the last line with a space).
+    InlineLineBuilder builder;
+    for (size_t i = 0; i < 5; ++i) {
+        bool space = i % 2 == 1;
+        builder.add_run({nullptr, i, 0, 0, space ? 10.0f : 45.0f, 10.0f, space});
+    }
+
+    auto lines = builder.layout(100.0f, 0.0f, LineBreakMode::Optimal);
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0].fragments.size(), 4u);
+    ASSERT_EQ(lines[1].fragments.size(), 1u);
+    EXPECT_EQ(lines[1].fragments[0].run_index, 4u);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include "TestGraphicsContext.h"
+#include "core/ArenaAllocator.h"
+#include "core/dom/DomFactory.h"
+#include "core/dom/Element.h"
+#include "core/dom/Text.h"
+#include "layout/TreeBuilder.h"
+#include "style/CssParser.h"
+#include "style/StyleEngine.h"
+
+using namespace Hummingbird::Layout;
+using namespace Hummingbird::DOM;
+using namespace Hummingbird::Css;
+
+namespace {
+// Test text metrics are 8px per character.
+std::unique_ptr<RenderObject> build_styled_tree(Element& root, const char* css) {
+    Parser parser(css);
+    auto sheet = parser.parse();
+    StyleEngine engine;
+    engine.apply(sheet, &root);
+    TreeBuilder builder;
+    return builder.build(&root);
+}
+}  // namespace
+
+TEST(IntrinsicSizesTest, ParagraphMinIsWidestWordAndMaxIsUnwrappedLine) {
+    ArenaAllocator arena(4096);
+    auto body = DomFactory::create_element(arena, "body");
+    auto p = DomFactory::create_element(arena, "p");
+    p->append_child(DomFactory::create_text(arena, "one two three"));
+    body->append_child(std::move(p));
+
+    auto render_root = build_styled_tree(*body, "p { padding: 2px; }");
+    ASSERT_NE(render_root, nullptr);
+
+    TestGraphicsContext context;
+    IntrinsicSizes sizes = render_root->compute_intrinsic_sizes(context);
+    EXPECT_FLOAT_EQ(sizes.min_content, 40.0f + 4.0f);   // "three"
+    EXPECT_FLOAT_EQ(sizes.max_content, 104.0f + 4.0f);  // "one two three"
+}
+
+TEST(IntrinsicSizesTest, IsMemoizedAndDoesNotTouchGeometry) {
+    ArenaAllocator arena(4096);
+    auto body = DomFactory::create_element(arena, "body");
+    auto p = DomFactory::create_element(arena, "p");
+    p->append_child(DomFactory::create_text(arena, "alpha beta"));
+    body->append_child(std::move(p));
+
+    auto render_root = build_styled_tree(*body, "");
+    ASSERT_NE(render_root, nullptr);
+
+    TestGraphicsContext context;
+    IntrinsicSizes first = render_root->compute_intrinsic_sizes(context);
+    const int calls = context.measure_text_calls;
+    EXPECT_FLOAT_EQ(render_root->get_rect().width, 0.0f);
+    EXPECT_FLOAT_EQ(render_root->get_children()[0]->get_rect().width, 0.0f);
+
+    IntrinsicSizes second = render_root->compute_intrinsic_sizes(context);
+    EXPECT_EQ(context.measure_text_calls, calls);
+    EXPECT_FLOAT_EQ(second.max_content, first.max_content);
+
+    // Layout reuses the runs measured for the intrinsic pass.
+    render_root->layout(context, {0, 0, 300, 200});
+    EXPECT_EQ(context.measure_text_calls, calls);
+
+    // Invalidating the text (and with it every ancestor) measures it again.
+    auto& text = *render_root->get_children()[0]->get_children()[0];
+    text.mark_needs_layout();
+    render_root->compute_intrinsic_sizes(context);
+    EXPECT_GT(context.measure_text_calls, calls);
+
+    // Sizes measured with one context's text metrics aren't reused for another.
+    TestGraphicsContext other;
+    render_root->compute_intrinsic_sizes(other);
+    EXPECT_GT(other.measure_text_calls, 0);
+}
+
+TEST(IntrinsicSizesTest, LeavesInlineBlockGeometryAlone) {
+    ArenaAllocator arena(4096);
+    auto body = DomFactory::create_element(arena, "body");
+    auto p = DomFactory::create_element(arena, "p");
+    auto box = DomFactory::create_element(arena, "span");
+    box->append_child(DomFactory::create_text(arena, "abc de"));
+    p->append_child(DomFactory::create_text(arena, "x "));
+    p->append_child(std::move(box));
+    body->append_child(std::move(p));
+
+    auto render_root = build_styled_tree(*body, "span { display: inline-block; padding: 3px; }");
+    ASSERT_NE(render_root, nullptr);
+
+    TestGraphicsContext context;
+    IntrinsicSizes sizes = render_root->compute_intrinsic_sizes(context);
+    EXPECT_FLOAT_EQ(sizes.min_content, 24.0f + 6.0f);          // "abc" inside the inline-block
+    EXPECT_FLOAT_EQ(sizes.max_content, 16.0f + 48.0f + 6.0f);  // "x " then "abc de"
+    const auto& inline_block = render_root->get_children()[0]->get_children()[1];
+    EXPECT_FLOAT_EQ(inline_block->get_rect().width, 0.0f);
+    EXPECT_FLOAT_EQ(inline_block->get_rect().height, 0.0f);
+}
+
+TEST(IntrinsicSizesTest, InlineBlockShrinksToMaxContentInOneLayout) {
+    ArenaAllocator arena(4096);
+    auto body = DomFactory::create_element(arena, "body");
+    auto box = DomFactory::create_element(arena, "span");
+    box->append_child(DomFactory::create_text(arena, "abc de"));
+    body->append_child(std::move(box));
+
+    auto render_root = build_styled_tree(*body, "span { display: inline-block; padding: 3px; }");
+    ASSERT_NE(render_root, nullptr);
+
+    TestGraphicsContext context;
+    render_root->layout(context, {0, 0, 400, 200});
+    ASSERT_EQ(render_root->get_children().size(), 1u);
+    const Rect& rect = render_root->get_children()[0]->get_rect();
+    EXPECT_FLOAT_EQ(rect.width, 48.0f + 6.0f);
+    EXPECT_FLOAT_EQ(rect.height, 16.0f + 6.0f);
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "TestGraphicsContext.h"
+#include "core/ArenaAllocator.h"
+#include "core/dom/DomFactory.h"
+#include "core/dom/Element.h"
+#include "core/dom/Text.h"
+#include "layout/ProgressiveLayout.h"
+#include "layout/TreeBuilder.h"
+#include "style/CssParser.h"
+#include "style/StyleEngine.h"
+
+using namespace Hummingbird::Layout;
+using namespace Hummingbird::DOM;
+using namespace Hummingbird::Css;
+
+namespace {
+constexpr int kParagraphCount = 400;
+
+// Paragraphs of one to four lines at a 200px width (test text metrics are 8px per character, 16px per line).
+ArenaPtr<Element> make_long_document(ArenaAllocator& arena) {
+    auto body = DomFactory::create_element(arena, "body");
+    for (int i = 0; i < kParagraphCount; ++i) {
+        auto p = DomFactory::create_element(arena, "p");
+        std::string text;
+        for (int word = 0; word <= (i % 4) * 6; ++word) {
+            text += "word ";
+        }
+        p->append_child(DomFactory::create_text(arena, text));
+        body->append_child(std::move(p));
+    }
+    return body;
+}
+
+std::unique_ptr<RenderObject> build_styled_tree(Element& root) {
+    Parser parser("p { margin: 4px; }");
+    auto sheet = parser.parse();
+    StyleEngine engine;
+    engine.apply(sheet, &root);
+    TreeBuilder builder;
+    return builder.build(&root);
+}
+
+float child_offset(const RenderObject& root, size_t index) {
+    return root.get_children()[index]->get_rect().y;
+}
+}  // namespace
+
+TEST(ProgressiveLayoutTest, LaysOutOnlyWhatTheViewportNeeds) {
+    ArenaAllocator arena(1 << 20);
+    auto body = make_long_document(arena);
+    auto root = build_styled_tree(*body);
+    ASSERT_NE(root, nullptr);
+
+    TestGraphicsContext context;
+    ProgressiveLayout progressive;
+    const Rect viewport{0, 0, 200, 100};
+    float scroll_y = progressive.layout_viewport(*root, context, viewport, 0.0f);
+    EXPECT_FLOAT_EQ(scroll_y, 0.0f);
+
+    EXPECT_FALSE(ProgressiveLayout::is_complete(*root));
+    EXPECT_FALSE(root->get_children().front()->is_layout_estimated());
+    EXPECT_TRUE(root->get_children().back()->is_layout_estimated());
+    EXPECT_LT(context.measure_text_calls, kParagraphCount / 4);
+    // The estimated tail still contributes to the document height.
+    EXPECT_GT(root->get_rect().height, 100.0f * 4);
+}
+
+TEST(ProgressiveLayoutTest, IdleStepsConvergeToTheFullLayout) {
+    ArenaAllocator arena(1 << 20);
+    auto body = make_long_document(arena);
+    auto lazy_root = build_styled_tree(*body);
+    ASSERT_NE(lazy_root, nullptr);
+
+    TestGraphicsContext context;
+    ProgressiveLayout progressive;
+    const Rect viewport{0, 0, 200, 100};
+    float scroll_y = progressive.layout_viewport(*lazy_root, context, viewport, 0.0f);
+    int steps = 0;
+    while (!ProgressiveLayout::is_complete(*lazy_root) && steps < 1000) {
+        scroll_y = progressive.advance(*lazy_root, context, viewport, scroll_y);
+        ++steps;
+    }
+    EXPECT_TRUE(ProgressiveLayout::is_complete(*lazy_root));
+    EXPECT_GT(steps, 1);
+    EXPECT_FLOAT_EQ(scroll_y, 0.0f);
+
+    auto full_root = build_styled_tree(*body);
+    full_root->layout(context, viewport);
+    EXPECT_FLOAT_EQ(lazy_root->get_rect().height, full_root->get_rect().height);
+    for (size_t i = 0; i < lazy_root->get_children().size(); ++i) {
+        EXPECT_FALSE(lazy_root->get_children()[i]->is_layout_estimated());
+        EXPECT_FLOAT_EQ(child_offset(*lazy_root, i), child_offset(*full_root, i));
+    }
+}
+
+TEST(ProgressiveLayoutTest, ScrollAnchorStaysPutWhenEstimatesAboveAreReplaced) {
+    ArenaAllocator arena(1 << 20);
+    auto body = make_long_document(arena);
+    auto root = build_styled_tree(*body);
+    ASSERT_NE(root, nullptr);
+
+    TestGraphicsContext context;
+    ProgressiveLayout progressive;
+    const Rect viewport{0, 0, 200, 100};
+    progressive.layout_viewport(*root, context, viewport, 0.0f);
+
+    // Jump deep into the estimated part of the document.
+    float scroll_y = progressive.layout_viewport(*root, context, viewport, root->get_rect().height / 2);
+    const RenderObject* anchor = nullptr;
+    for (const auto& child : root->get_children()) {
+        const Rect& rect = child->get_rect();
+        if (rect.y <= scroll_y && scroll_y < rect.y + rect.height) {
+            anchor = child.get();
+            break;
+        }
+    }
+    ASSERT_NE(anchor, nullptr);
+    EXPECT_FALSE(anchor->is_layout_estimated());
+    const float anchor_on_screen = anchor->get_rect().y - scroll_y;
+    const float jump_scroll_y = scroll_y;
+
+    while (!ProgressiveLayout::is_complete(*root)) {
+        scroll_y = progressive.advance(*root, context, viewport, scroll_y);
+    }
+    EXPECT_NE(scroll_y, jump_scroll_y);  // estimates above the anchor were replaced
+    EXPECT_NEAR(anchor->get_rect().y - scroll_y, anchor_on_screen, 0.5f);
+}
@@ -9,6 +9,7 @@
 #include "html/HtmlTagNames.h"
 #include "layout/RenderTable.h"
 #include "layout/TreeBuilder.h"
+#include "style/CssParser.h"
 #include "style/StyleEngine.h"
 
 using namespace Hummingbird::Layout;
@@ -17,6 +18,28 @@ using namespace Hummingbird::Css;
 namespace TagNames = Hummingbird::Html::TagNames;
 namespace Attr = Hummingbird::Html::AttributeNames;
 
+namespace {
+ArenaPtr<Element> make_cell(ArenaAllocator& arena, const char* text) {
+    auto cell = DomFactory::create_element(arena, TagNames::Td);
+    cell->append_child(DomFactory::create_text(arena, text));
+    return cell;
+}
+
+std::unique_ptr<RenderObject> build_styled_tree(Element& root, const char* css) {
+    Parser parser(css);
+    auto sheet = parser.parse();
+    StyleEngine engine;
+    engine.apply(sheet, &root);
+    TreeBuilder builder;
+    return builder.build(&root);
+}
+
+RenderTableCell* cell_at(RenderObject& table, size_t row, size_t cell) {
+    auto& row_render = *table.get_children()[row];
+    return dynamic_cast<RenderTableCell*>(row_render.get_children()[cell].get());
+}
+}  // namespace
+
 TEST(TableLayoutTest, AlignsCellsIntoColumns) {
     ArenaAllocator arena(4096);
     auto body = DomFactory::create_element(arena, TagNames::Body);
@@ -242,3 +265,140 @@ TEST(TableLayoutTest, AlignDoesNotInflateIntrinsicWidths) {
     EXPECT_FLOAT_EQ(cell1_render->get_rect().width, 40.0f);
     EXPECT_FLOAT_EQ(cell2_render->get_rect().width, 8.0f);
 }
+
+TEST(TableLayoutTest, ShrinksColumnsBetweenMinAndMaxContent) {
+    ArenaAllocator arena(4096);
+    auto body = DomFactory::create_element(arena, TagNames::Body);
+    auto table = DomFactory::create_element(arena, TagNames::Table);
+    auto row = DomFactory::create_element(arena, TagNames::Tr);
+    row->append_child(make_cell(arena, "aaaa bbbb cccc dddd"));
+    row->append_child(make_cell(arena, "ee ff"));
+    table->append_child(std::move(row));
+    body->append_child(std::move(table));
+
+    auto render_root = build_styled_tree(*body, "");
+    ASSERT_NE(render_root, nullptr);
+
+    TestGraphicsContext context;
+    render_root->layout(context, {0, 0, 120, 200});
+
+    auto* table_render = render_root->get_children()[0].get();
+    auto* cell1 = cell_at(*table_render, 0, 0);
+    auto* cell2 = cell_at(*table_render, 0, 1);
+    ASSERT_NE(cell1, nullptr);
+    ASSERT_NE(cell2, nullptr);
+
+    // Max-content (152 + 40) doesn't fit, so both columns give up the same fraction of their flexible width.
+    EXPECT_FLOAT_EQ(table_render->get_rect().width, 120.0f);
+    EXPECT_FLOAT_EQ(cell1->get_rect().width + cell2->get_rect().width, 120.0f);
+    IntrinsicSizes sizes1 = cell1->compute_intrinsic_sizes(context);
+    IntrinsicSizes sizes2 = cell2->compute_intrinsic_sizes(context);
+    EXPECT_GT(cell1->get_rect().width, sizes1.min_content);
+    EXPECT_LT(cell1->get_rect().width, sizes1.max_content);
+    EXPECT_GT(cell2->get_rect().width, sizes2.min_content);
+    EXPECT_LT(cell2->get_rect().width, sizes2.max_content);
+    EXPECT_GT(cell1->get_rect().height, 16.0f);
+}
+
+TEST(TableLayoutTest, RowspanReservesColumnInFollowingRows) {
+    ArenaAllocator arena(4096);
+    auto body = DomFactory::create_element(arena, TagNames::Body);
+    auto table = DomFactory::create_element(arena, TagNames::Table);
+    auto row1 = DomFactory::create_element(arena, TagNames::Tr);
+    auto tall = make_cell(arena, "AA");
+    tall->set_attribute(Attr::RowSpan, "2");
+    row1->append_child(std::move(tall));
+    row1->append_child(make_cell(arena, "B"));
+    table->append_child(std::move(row1));
+    auto row2 = DomFactory::create_element(arena, TagNames::Tr);
+    row2->append_child(make_cell(arena, "CCC"));
+    table->append_child(std::move(row2));
+    body->append_child(std::move(table));
+
+    auto render_root = build_styled_tree(*body, "");
+    ASSERT_NE(render_root, nullptr);
+
+    TestGraphicsContext context;
+    render_root->layout(context, {0, 0, 400, 200});
+
+    auto* table_render = render_root->get_children()[0].get();
+    auto* tall_render = cell_at(*table_render, 0, 0);
+    auto* b_render = cell_at(*table_render, 0, 1);
+    auto* c_render = cell_at(*table_render, 1, 0);
+    ASSERT_NE(tall_render, nullptr);
+    ASSERT_NE(b_render, nullptr);
+    ASSERT_NE(c_render, nullptr);
+
+    EXPECT_FLOAT_EQ(tall_render->get_rect().width, 16.0f);
+    EXPECT_FLOAT_EQ(c_render->get_rect().x, 16.0f);
+    EXPECT_FLOAT_EQ(b_render->get_rect().width, 24.0f);
+    EXPECT_FLOAT_EQ(c_render->get_rect().width, 24.0f);
+}
+
+TEST(TableLayoutTest, FixedLayoutSizesColumnsFromFirstRowOnly) {
+    ArenaAllocator arena(4096);
+    auto body = DomFactory::create_element(arena, TagNames::Body);
+    auto table = DomFactory::create_element(arena, TagNames::Table);
+    auto row1 = DomFactory::create_element(arena, TagNames::Tr);
+    auto narrow = make_cell(arena, "A");
+    narrow->set_attribute(Attr::Class, "narrow");
+    row1->append_child(std::move(narrow));
+    row1->append_child(make_cell(arena, "B"));
+    row1->append_child(make_cell(arena, "C"));
+    table->append_child(std::move(row1));
+    auto row2 = DomFactory::create_element(arena, TagNames::Tr);
+    row2->append_child(make_cell(arena, "a much longer first column"));
+    row2->append_child(make_cell(arena, "x"));
+    row2->append_child(make_cell(arena, "y"));
+    table->append_child(std::move(row2));
+    body->append_child(std::move(table));
+
+    auto render_root = build_styled_tree(
+        *body, "table { width: 300px; table-layout: fixed; } td.narrow { width: 40px; padding: 5px; }");
+    ASSERT_NE(render_root, nullptr);
+
+    TestGraphicsContext context;
+    render_root->layout(context, {0, 0, 800, 200});
+
+    auto* table_render = render_root->get_children()[0].get();
+    EXPECT_FLOAT_EQ(table_render->get_rect().width, 300.0f);
+    for (size_t row = 0; row < 2; ++row) {
+        auto* first = cell_at(*table_render, row, 0);
+        auto* second = cell_at(*table_render, row, 1);
+        auto* third = cell_at(*table_render, row, 2);
+        ASSERT_NE(first, nullptr);
+        ASSERT_NE(second, nullptr);
+        ASSERT_NE(third, nullptr);
+        EXPECT_FLOAT_EQ(first->get_rect().width, 50.0f);
+        EXPECT_FLOAT_EQ(second->get_rect().width, 125.0f);
+        EXPECT_FLOAT_EQ(third->get_rect().width, 125.0f);
+        EXPECT_FLOAT_EQ(third->get_rect().x, 175.0f);
+    }
+    // The overlong second-row cell wraps inside its fixed column instead of widening it.
+    EXPECT_GT(cell_at(*table_render, 1, 0)->get_rect().height, 16.0f);
+}
+
+TEST(TableLayoutTest, RelayoutAtSameWidthReusesMeasurements) {
+    ArenaAllocator arena(4096);
+    auto body = DomFactory::create_element(arena, TagNames::Body);
+    auto table = DomFactory::create_element(arena, TagNames::Table);
+    for (int r = 0; r < 3; ++r) {
+        auto row = DomFactory::create_element(arena, TagNames::Tr);
+        row->append_child(make_cell(arena, "alpha beta"));
+        row->append_child(make_cell(arena, "gamma"));
+        table->append_child(std::move(row));
+    }
+    body->append_child(std::move(table));
+
+    auto render_root = build_styled_tree(*body, "");
+    ASSERT_NE(render_root, nullptr);
+
+    TestGraphicsContext context;
+    render_root->layout(context, {0, 0, 400, 200});
+    const int calls = context.measure_text_calls;
+    const float width = render_root->get_children()[0]->get_rect().width;
+
+    render_root->layout(context, {0, 0, 400, 200});
+    EXPECT_EQ(context.measure_text_calls, calls);
+    EXPECT_FLOAT_EQ(render_root->get_children()[0]->get_rect().width, width);
+}
@@ -6,17 +6,20 @@
 // except text measurement, which uses a simple heuristic to return stable values.
 class TestGraphicsContext : public IGraphicsContext {
 public:
+    int measure_text_calls = 0;
+
     void set_viewport(const Hummingbird::Layout::Rect& /*viewport*/) override {}
     void clear(const Color& /*color*/) override {}
     void present() override {}
     void fill_rect(const Hummingbird::Layout::Rect& /*rect*/, const Color& /*color*/) override {}
 
-    TextMetrics measure_text(const std::string& text, const TextStyle& /*style*/) override {
+    TextMetrics measure_text(std::string_view text, const TextStyle& /*style*/) override {
+        ++measure_text_calls;
         // Approximate metrics based on character count to keep tests deterministic.
         constexpr float kAverageCharWidth = 8.0f;
         constexpr float kLineHeight = 16.0f;
         return TextMetrics{.width = static_cast<float>(text.size()) * kAverageCharWidth, .height = kLineHeight};
     }
 
-    void draw_text(const std::string& /*text*/, float /*x*/, float /*y*/, const TextStyle& /*style*/) override {}
+    void draw_text(std::string_view /*text*/, float /*x*/, float /*y*/, const TextStyle& /*style*/) override {}
 };
@@ -17,14 +17,14 @@ public:
     void present() override {}
     void fill_rect(const Hummingbird::Layout::Rect& /*rect*/, const Color& /*color*/) override {}
 
-    TextMetrics measure_text(const std::string& text, const TextStyle& style) override {
+    TextMetrics measure_text(std::string_view text, const TextStyle& style) override {
         last_font_path = style.font_path;
         constexpr float kAverageCharWidth = 8.0f;
         constexpr float kLineHeight = 16.0f;
         return TextMetrics{static_cast<float>(text.size()) * kAverageCharWidth, kLineHeight};
     }
 
-    void draw_text(const std::string& /*text*/, float /*x*/, float /*y*/, const TextStyle& /*style*/) override {}
+    void draw_text(std::string_view /*text*/, float /*x*/, float /*y*/, const TextStyle& /*style*/) override {}
 
     std::string last_font_path;
 };
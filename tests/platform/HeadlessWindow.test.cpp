@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "core/platform_api/WindowFactory.h"
+#include "layout/Geometry.h"
+
+namespace {
+bool has_png_signature(const std::vector<uint8_t>& bytes) {
+    static constexpr uint8_t kSignature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if (bytes.size() < sizeof(kSignature)) return false;
+    for (size_t i = 0; i < sizeof(kSignature); ++i) {
+        if (bytes[i] != kSignature[i]) return false;
+    }
+    return true;
+}
+}  // namespace
+
+TEST(HeadlessWindowTest, ReportsItsSizeAndOnlyScriptedEvents) {
+    auto window = create_headless_window(320, 200);
+    ASSERT_NE(window, nullptr);
+    window->open();
+    EXPECT_TRUE(window->is_open());
+    EXPECT_EQ(window->get_size(), std::make_pair(320, 200));
+
+    InputEvent event;
+    EXPECT_FALSE(window->poll_event(event));
+    EXPECT_FALSE(window->wait_event(event, 0));
+
+    window->close();
+    EXPECT_FALSE(window->is_open());
+}
+
+TEST(HeadlessWindowTest, GraphicsContextEncodesPng) {
+    auto context = create_offscreen_graphics_context(64, 32);
+    ASSERT_NE(context, nullptr);
+    EXPECT_EQ(context->get_size(), std::make_pair(64, 32));
+
+    context->clear(Color{255, 255, 255, 255});
+    context->fill_rect({4, 4, 16, 16}, Color{200, 0, 0, 255});
+    context->present();
+    EXPECT_TRUE(has_png_signature(context->encode_png()));
+
+    // Drawing keeps working after an encode.
+    context->fill_rect({8, 8, 4, 4}, Color{0, 0, 200, 255});
+    EXPECT_TRUE(has_png_signature(context->encode_png()));
+}
+
+TEST(HeadlessWindowTest, WorkerThreadsRasterizeTheSameImage) {
+    auto draw = [](IOffscreenGraphicsContext& context) {
+        TextStyle style;
+        style.font_path = "assets/fonts/Roboto-Regular.ttf";
+        context.clear(Color{255, 255, 255, 255});
+        context.set_viewport({0, 0, 120, 60});
+        for (int i = 0; i < 20; ++i) {
+            context.fill_rect({static_cast<float>(i * 7), static_cast<float>(i * 3), 30, 12},
+                              Color{static_cast<unsigned char>(i * 12), 80, 160, 200});
+        }
+        const TextRun runs[] = {{"Hello", 4, 4}, {"threads", 40, 30}};
+        context.draw_text_runs(runs, style);
+        context.present();
+    };
+    auto single = create_offscreen_graphics_context(128, 64);
+    auto threaded = create_offscreen_graphics_context(128, 64, 4);
+    ASSERT_NE(single, nullptr);
+    ASSERT_NE(threaded, nullptr);
+    draw(*single);
+    draw(*threaded);
+    EXPECT_EQ(threaded->encode_png(), single->encode_png());
+}
+
+TEST(HeadlessWindowTest, MeasuresTextWithTheBundledFont) {
+    auto context = create_offscreen_graphics_context(64, 32);
+    TextStyle style;
+    style.font_path = "assets/fonts/Roboto-Regular.ttf";
+    auto short_text = context->measure_text("Hi", style);
+    auto long_text = context->measure_text("Hello there", style);
+    EXPECT_GT(short_text.width, 0.0f);
+    EXPECT_GT(long_text.width, short_text.width);
+    EXPECT_FLOAT_EQ(long_text.height, short_text.height);
+}
@@ -10,3 +10,35 @@ TEST(ResourceProviderTest, LoadsTextFromAssets) {
     ASSERT_TRUE(text.has_value());
     EXPECT_NE(text->find("body"), std::string::npos);
 }
+
+TEST(ResourceProviderTest, MapsResourceWithoutCopy) {
+    auto provider = create_resource_provider();
+    ASSERT_NE(provider, nullptr);
+
+    auto view = provider->map_resource("assets/ua.css");
+    ASSERT_TRUE(view.has_value());
+    ASSERT_NE(view->owner, nullptr);
+    EXPECT_NE(view->bytes.find("body"), std::string_view::npos);
+
+    auto text = provider->load_text("assets/ua.css");
+    ASSERT_TRUE(text.has_value());
+    EXPECT_EQ(*text, view->bytes);
+}
+
+TEST(ResourceProviderTest, SharesMappingsAcrossProviders) {
+    auto first = create_resource_provider();
+    auto second = create_resource_provider();
+
+    auto a = first->map_resource("assets/ua.css");
+    auto b = second->map_resource("assets/ua.css");
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(b.has_value());
+    EXPECT_EQ(a->owner, b->owner);
+    EXPECT_EQ(a->bytes.data(), b->bytes.data());
+}
+
+TEST(ResourceProviderTest, MissingResourceIsUnavailable) {
+    auto provider = create_resource_provider();
+    EXPECT_FALSE(provider->map_resource("assets/does-not-exist.css").has_value());
+    EXPECT_FALSE(provider->load_text("").has_value());
+}
@@ -2,8 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
 #include <functional>
+#include <iterator>
+#include <span>
 
 #include "core/dom/Element.h"
 #include "core/platform_api/IGraphicsContext.h"
@@ -25,16 +28,28 @@ public:
     void present() override {}
     void fill_rect(const Hummingbird::Layout::Rect& rect, const Color&) override { fill_calls.push_back(rect); }
 
-    TextMetrics measure_text(const std::string& text, const TextStyle&) override {
+    TextMetrics measure_text(std::string_view text, const TextStyle&) override {
         return {static_cast<float>(text.size()) * 8.0f, 16.0f};
     }
 
-    void draw_text(const std::string& text, float, float, const TextStyle&) override {
+    void draw_text(std::string_view text, float, float, const TextStyle&) override {
         ++draw_calls;
         last_text = text;
     }
 
+    void fill_rects(std::span<const Hummingbird::Layout::Rect> rects, const Color& color) override {
+        fill_batches.push_back(rects.size());
+        IGraphicsContext::fill_rects(rects, color);
+    }
+
+    void draw_text_runs(std::span<const TextRun> runs, const TextStyle& style) override {
+        ++text_batches;
+        IGraphicsContext::draw_text_runs(runs, style);
+    }
+
     int draw_calls = 0;
+    int text_batches = 0;
+    std::vector<size_t> fill_batches;
     std::string last_text;
     std::vector<Hummingbird::Layout::Rect> fill_calls;
     Hummingbird::Layout::Rect viewport_{0, 0, 0, 0};
@@ -61,8 +76,9 @@ TEST(PainterIntegrationTest, PaintsTextNodesFromParserOutput) {
     Hummingbird::Renderer::PaintOptions opts;
     painter.paint(*render_tree, context, opts);
 
-    // Expect one draw call per tokenized run.
+    // Expect one draw call per tokenized run, submitted as one batch per text box.
     EXPECT_EQ(context.draw_calls, 6);
+    EXPECT_EQ(context.text_batches, 2);
     EXPECT_EQ(context.last_text, "line");
 }
 
@@ -90,6 +106,41 @@ TEST(PainterDebugTest, DrawsOutlinesWhenDebugEnabled) {
     EXPECT_FALSE(context.fill_calls.empty());
 }
 
+TEST(PainterDebugTest, BatchesOutlinesAndCullsThemToTheViewport) {
+    std::string html = "<html><body>";
+    for (int i = 0; i < 40; ++i) {
+        html += "<p>Paragraph</p>";
+    }
+    html += "</body></html>";
+    ArenaAllocator arena(64 * 1024);
+    Hummingbird::Html::Parser parser(arena, html);
+    auto result = parser.parse();
+
+    Hummingbird::Layout::TreeBuilder builder;
+    auto render_tree = builder.build(result.dom.get());
+    ASSERT_NE(render_tree, nullptr);
+
+    RecordingGraphicsContext context;
+    Hummingbird::Layout::Rect viewport{0, 0, 200, 100};
+    render_tree->layout(context, viewport);
+
+    Hummingbird::Renderer::Painter painter;
+    Hummingbird::Renderer::PaintOptions opts;
+    opts.debug_outlines = true;
+    painter.paint(*render_tree, context, opts);
+    ASSERT_EQ(context.fill_batches.size(), 1u);
+    const size_t all_outlines = context.fill_batches.back();
+    EXPECT_EQ(all_outlines % 4, 0u);
+
+    // With a viewport, only the boxes on screen are outlined, still in a single batch.
+    context.fill_batches.clear();
+    opts.viewport = viewport;
+    painter.paint(*render_tree, context, opts);
+    ASSERT_EQ(context.fill_batches.size(), 1u);
+    EXPECT_GT(context.fill_batches.back(), 0u);
+    EXPECT_LT(context.fill_batches.back() * 4, all_outlines);
+}
+
 TEST(PainterTest, PaintsBordersFromComputedStyle) {
     std::string_view html = "<html><body><div>Box</div></body></html>";
     ArenaAllocator arena(2048);
@@ -115,6 +166,8 @@ TEST(PainterTest, PaintsBordersFromComputedStyle) {
     painter.paint(*render_tree, context, opts);
 
     EXPECT_GE(context.fill_calls.size(), 4u);
+    // The four sides share the border color and arrive as one batch.
+    EXPECT_NE(std::find(context.fill_batches.begin(), context.fill_batches.end(), 4u), context.fill_batches.end());
 }
 
 namespace {
@@ -248,6 +301,37 @@ TEST(PainterTest, PaintsBackgroundForBoxes) {
     EXPECT_TRUE(found);
 }
 
+TEST(PainterTest, UnderlinesEachLineOfWrappedLink) {
+    std::string_view html = "<html><body><p><a>aaaa bbbb cccc</a></p></body></html>";
+    ArenaAllocator arena(2048);
+    Hummingbird::Html::Parser parser(arena, html);
+    auto result = parser.parse();
+
+    Stylesheet sheet;
+    StyleEngine engine;
+    engine.apply(sheet, result.dom.get());
+
+    Hummingbird::Layout::TreeBuilder builder;
+    auto render_tree = builder.build(result.dom.get());
+    ASSERT_NE(render_tree, nullptr);
+
+    // Words are 32 wide and spaces 8, so the third word wraps onto a second line.
+    RecordingGraphicsContext context;
+    render_tree->layout(context, {0, 0, 100, 200});
+
+    Hummingbird::Renderer::Painter painter;
+    Hummingbird::Renderer::PaintOptions opts;
+    painter.paint(*render_tree, context, opts);
+
+    std::vector<Hummingbird::Layout::Rect> underlines;
+    std::copy_if(context.fill_calls.begin(), context.fill_calls.end(), std::back_inserter(underlines),
+                 [](const Hummingbird::Layout::Rect& rect) { return rect.height == 1.0f; });
+    ASSERT_EQ(underlines.size(), 2u);
+    EXPECT_GT(underlines[0].width, underlines[1].width);
+    EXPECT_FLOAT_EQ(underlines[1].width, 32.0f);
+    EXPECT_FLOAT_EQ(underlines[1].y - underlines[0].y, 16.0f);
+}
+
 TEST(PainterTest, PaintsImagePlaceholderWithAltText) {
     std::string_view html = "<html><body><img alt=\"Logo\" width=\"32\" height=\"16\"></body></html>";
     ArenaAllocator arena(2048);
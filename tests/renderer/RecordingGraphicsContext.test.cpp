@@ -0,0 +1,145 @@
+#include "renderer/RecordingGraphicsContext.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "html/HtmlParser.h"
+#include "layout/RenderObject.h"
+#include "layout/TreeBuilder.h"
+#include "renderer/Painter.h"
+#include "style/CssParser.h"
+#include "style/StyleEngine.h"
+
+using Hummingbird::Renderer::RecordingGraphicsContext;
+
+namespace {
+constexpr Color kRed{255, 0, 0, 255};
+constexpr Color kBlue{0, 0, 255, 255};
+
+TextStyle text_style(float font_size) {
+    TextStyle style;
+    style.font_path = "fonts/test.ttf";
+    style.font_size = font_size;
+    return style;
+}
+}  // namespace
+
+TEST(RecordingGraphicsContextTest, ReplayReproducesTheRecordedCalls) {
+    RecordingGraphicsContext recording;
+    recording.set_viewport({0, 0, 200, 100});
+    recording.clear({255, 255, 255, 255});
+    recording.fill_rect({10, 10, 50, 20}, kRed);
+    recording.draw_text("hello", 5, 40, text_style(16));
+    recording.draw_text("world", 50, 40, text_style(16));
+    recording.draw_text("small", 5, 70, text_style(10));
+    recording.present();
+
+    RecordingGraphicsContext copy;
+    recording.replay(copy);
+    ASSERT_EQ(copy.commands().size(), recording.commands().size());
+    for (size_t i = 0; i < recording.commands().size(); ++i) {
+        const auto& expected = recording.commands()[i];
+        const auto& actual = copy.commands()[i];
+        EXPECT_EQ(actual.op, expected.op) << i;
+        EXPECT_EQ(actual.rect.x, expected.rect.x) << i;
+        EXPECT_EQ(actual.rect.width, expected.rect.width) << i;
+        EXPECT_EQ(copy.text(actual), recording.text(expected)) << i;
+    }
+    const auto& small = recording.commands()[5];
+    EXPECT_EQ(recording.text(small), "small");
+    EXPECT_EQ(recording.style(small).font_size, 10.0f);
+    EXPECT_EQ(copy.style(copy.commands()[5]).font_size, 10.0f);
+    // Equal styles share one table entry.
+    EXPECT_EQ(recording.commands()[3].style, recording.commands()[4].style);
+    EXPECT_NE(recording.commands()[3].style, small.style);
+
+    recording.reset();
+    EXPECT_TRUE(recording.commands().empty());
+    EXPECT_EQ(recording.analyze().text_bytes, 0u);
+}
+
+TEST(RecordingGraphicsContextTest, MeasuresWithTheGivenBackend) {
+    RecordingGraphicsContext metrics;  // heuristic: half the font size per character
+    RecordingGraphicsContext recording(&metrics);
+    const TextMetrics measured = recording.measure_text("abcd", text_style(20));
+    EXPECT_EQ(measured.width, 40.0f);
+    EXPECT_EQ(measured.height, 24.0f);
+}
+
+TEST(RecordingGraphicsContextTest, AnalysisFindsWasteAndOverdraw) {
+    RecordingGraphicsContext recording;
+    recording.set_viewport({0, 0, 100, 100});
+    recording.fill_rect({0, 0, 100, 100}, kRed);
+    recording.fill_rect({0, 0, 100, 100}, kRed);
+    recording.fill_rect({0, 0, 10, 10}, kBlue);     // three deep
+    recording.fill_rect({90, 90, 20, 20}, kBlue);   // clipped to 10x10
+    recording.fill_rect({0, 200, 100, 4}, kBlue);   // below the viewport
+    recording.fill_rect({0, 0, 0, 10}, kBlue);      // empty
+    recording.set_viewport({0, 0, 100, 100});       // redundant
+    recording.draw_text("", 0, 0, text_style(16));  // empty
+
+    const auto analysis = recording.analyze();
+    EXPECT_EQ(analysis.commands, 9u);
+    EXPECT_EQ(analysis.fill_rects, 6u);
+    EXPECT_EQ(analysis.draw_texts, 1u);
+    EXPECT_EQ(analysis.viewport_changes, 2u);
+    EXPECT_EQ(analysis.redundant_viewport_changes, 1u);
+    EXPECT_EQ(analysis.off_viewport_draws, 1u);
+    EXPECT_EQ(analysis.clipped_draws, 1u);
+    EXPECT_EQ(analysis.empty_draws, 2u);
+    EXPECT_EQ(analysis.color_changes, 1u);
+    EXPECT_DOUBLE_EQ(analysis.covered_area, 10000.0);
+    EXPECT_DOUBLE_EQ(analysis.painted_area, 20200.0);
+    EXPECT_DOUBLE_EQ(analysis.overdraw(), 2.02);
+    EXPECT_EQ(analysis.max_depth, 3u);
+
+    std::ostringstream report;
+    analysis.write_report(report);
+    EXPECT_NE(report.str().find("1 draws off the viewport"), std::string::npos);
+    EXPECT_NE(report.str().find("overdraw: 2.02x"), std::string::npos);
+}
+
+TEST(RecordingGraphicsContextTest, LargeSurfacesUseCoarserCells) {
+    RecordingGraphicsContext recording;
+    recording.fill_rect({0, 0, 1000, 20000}, kRed);
+    recording.fill_rect({0, 0, 1000, 10000}, kBlue);
+    const auto analysis = recording.analyze();
+    EXPECT_GT(analysis.coverage_cell_size, 1.0f);
+    EXPECT_NEAR(analysis.overdraw(), 1.5, 0.01);
+}
+
+// A bordered box far taller than the viewport, scrolled so the viewport shows its middle: the box intersects the
+// viewport, so it is painted, but its top and bottom borders fall entirely outside it.
+TEST(RecordingGraphicsContextTest, FindsBordersPaintedOutsideTheViewport) {
+    std::string html = "<html><body><div>";
+    for (int i = 0; i < 60; ++i) {
+        html += "<p>line " + std::to_string(i) + "</p>";
+    }
+    html += "</div></body></html>";
+    ArenaAllocator arena(64 * 1024);
+    Hummingbird::Html::Parser parser(arena, html);
+    auto result = parser.parse();
+    std::string css = "div { border-width: 2px; border-style: solid; border-color: red; }";
+    Hummingbird::Css::Parser css_parser(css);
+    auto sheet = css_parser.parse();
+    Hummingbird::Css::StyleEngine engine;
+    engine.apply(sheet, result.dom.get());
+    Hummingbird::Layout::TreeBuilder builder;
+    auto render_tree = builder.build(result.dom.get());
+    ASSERT_NE(render_tree, nullptr);
+
+    RecordingGraphicsContext recording;
+    render_tree->layout(recording, {0, 0, 400, 300});
+    Hummingbird::Renderer::PaintOptions options;
+    options.viewport = {0, 0, 400, 300};
+    options.scroll_y = 400.0f;
+    Hummingbird::Renderer::Painter painter;
+    painter.paint(*render_tree, recording, options);
+
+    const auto analysis = recording.analyze();
+    EXPECT_GE(analysis.fill_rects, 4u);
+    EXPECT_GE(analysis.off_viewport_draws, 2u);
+    EXPECT_GT(analysis.draw_texts, 0u);
+}
@@ -0,0 +1,59 @@
+#include "style/AncestorFilter.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "core/ArenaAllocator.h"
+#include "core/dom/DomFactory.h"
+#include "core/dom/Element.h"
+#include "html/HtmlAttributeNames.h"
+#include "html/HtmlTagNames.h"
+#include "style/CssParser.h"
+
+using namespace Hummingbird::Css;
+using namespace Hummingbird::DOM;
+namespace Attr = Hummingbird::Html::AttributeNames;
+
+namespace {
+Selector parse_first_selector(const std::string& css) {
+    Parser parser(css);
+    return parser.parse().rules.at(0).selectors.at(0);
+}
+}  // namespace
+
+TEST(AncestorFilterTest, TracksPushedAncestors) {
+    ArenaAllocator arena(1024);
+    auto nav = DomFactory::create_element(arena, "nav");
+    nav->set_attribute(Attr::Class, "top  menu");
+    nav->set_attribute(Attr::Id, "site");
+
+    AncestorFilter filter;
+    EXPECT_FALSE(filter.may_contain(selector_hash(SelectorType::Class, "menu")));
+
+    filter.push_element(*nav);
+    EXPECT_EQ(filter.depth(), 1u);
+    EXPECT_TRUE(filter.may_contain(selector_hash(SelectorType::Tag, "nav")));
+    EXPECT_TRUE(filter.may_contain(selector_hash(SelectorType::Class, "top")));
+    EXPECT_TRUE(filter.may_contain(selector_hash(SelectorType::Class, "menu")));
+    EXPECT_TRUE(filter.may_contain(selector_hash(SelectorType::Id, "site")));
+
+    filter.pop_element();
+    EXPECT_EQ(filter.depth(), 0u);
+    EXPECT_FALSE(filter.may_contain(selector_hash(SelectorType::Tag, "nav")));
+    EXPECT_FALSE(filter.may_contain(selector_hash(SelectorType::Class, "menu")));
+}
+
+TEST(AncestorFilterTest, RejectsSelectorsWhoseAncestorsAreAbsent) {
+    ArenaAllocator arena(1024);
+    auto nav = DomFactory::create_element(arena, "nav");
+    nav->set_attribute(Attr::Class, "menu");
+
+    AncestorFilter filter;
+    filter.push_element(*nav);
+
+    EXPECT_TRUE(filter.may_match(parse_first_selector("nav.menu a {}")));
+    EXPECT_TRUE(filter.may_match(parse_first_selector("a {}")));
+    EXPECT_FALSE(filter.may_match(parse_first_selector("footer a {}")));
+    EXPECT_FALSE(filter.may_match(parse_first_selector(".sidebar > a {}")));
+}
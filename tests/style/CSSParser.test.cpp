@@ -12,8 +12,8 @@ TEST(CSSParserTest, ParsesSingleRule) {
     ASSERT_EQ(sheet.rules.size(), 1u);
     const auto& rule = sheet.rules[0];
     ASSERT_EQ(rule.selectors.size(), 1u);
-    EXPECT_EQ(rule.selectors[0].type, SelectorType::Tag);
-    EXPECT_EQ(rule.selectors[0].value, Hummingbird::Html::TagNames::Div);
+    EXPECT_EQ(rule.selectors[0].compounds[0].simple_selectors[0].type, SelectorType::Tag);
+    EXPECT_EQ(rule.selectors[0].compounds[0].simple_selectors[0].value, Hummingbird::Html::TagNames::Div);
     ASSERT_EQ(rule.declarations.size(), 1u);
     EXPECT_EQ(rule.declarations[0].property, Property::Color);
     EXPECT_EQ(rule.declarations[0].value.type, Value::Type::Color);
@@ -28,12 +28,12 @@ TEST(CSSParserTest, ParsesSelectorList) {
     ASSERT_EQ(sheet.rules.size(), 1u);
     const auto& rule = sheet.rules[0];
     ASSERT_EQ(rule.selectors.size(), 3u);
-    EXPECT_EQ(rule.selectors[0].type, SelectorType::Tag);
-    EXPECT_EQ(rule.selectors[0].value, Hummingbird::Html::TagNames::H1);
-    EXPECT_EQ(rule.selectors[1].type, SelectorType::Tag);
-    EXPECT_EQ(rule.selectors[1].value, Hummingbird::Html::TagNames::H2);
-    EXPECT_EQ(rule.selectors[2].type, SelectorType::Class);
-    EXPECT_EQ(rule.selectors[2].value, "title");
+    EXPECT_EQ(rule.selectors[0].compounds[0].simple_selectors[0].type, SelectorType::Tag);
+    EXPECT_EQ(rule.selectors[0].compounds[0].simple_selectors[0].value, Hummingbird::Html::TagNames::H1);
+    EXPECT_EQ(rule.selectors[1].compounds[0].simple_selectors[0].type, SelectorType::Tag);
+    EXPECT_EQ(rule.selectors[1].compounds[0].simple_selectors[0].value, Hummingbird::Html::TagNames::H2);
+    EXPECT_EQ(rule.selectors[2].compounds[0].simple_selectors[0].type, SelectorType::Class);
+    EXPECT_EQ(rule.selectors[2].compounds[0].simple_selectors[0].value, "title");
     ASSERT_EQ(rule.declarations.size(), 1u);
     EXPECT_EQ(rule.declarations[0].property, Property::Margin);
     EXPECT_EQ(rule.declarations[0].value.type, Value::Type::Length);
@@ -86,3 +86,48 @@ TEST(CSSParserTest, ParsesBackgroundColorAndShortHex) {
     EXPECT_EQ(rule.declarations[1].value.color.g, 255);
     EXPECT_EQ(rule.declarations[1].value.color.b, 255);
 }
+
+TEST(CSSParserTest, InternsKeywordValues) {
+    Parser parser("div { display: inline-block; border-style: solid; float: left; color: #12345678; }");
+    auto sheet = parser.parse();
+    ASSERT_EQ(sheet.rules.size(), 1u);
+    const auto& rule = sheet.rules[0];
+    ASSERT_EQ(rule.declarations.size(), 4u);
+
+    ASSERT_EQ(rule.declarations[0].value.type, Value::Type::Keyword);
+    EXPECT_EQ(rule.declarations[0].value.keyword, Keyword::InlineBlock);
+    ASSERT_EQ(rule.declarations[1].value.type, Value::Type::Keyword);
+    EXPECT_EQ(rule.declarations[1].value.keyword, Keyword::Solid);
+    EXPECT_EQ(rule.declarations[2].property, Property::Unknown);
+    EXPECT_EQ(rule.declarations[2].value.keyword, Keyword::Unknown);
+    ASSERT_EQ(rule.declarations[3].value.type, Value::Type::Keyword);
+    EXPECT_EQ(rule.declarations[3].value.keyword, Keyword::Unknown);
+}
+
+TEST(CSSParserTest, ParsesCompoundAndComplexSelectors) {
+    Parser parser("ul > li.item a, div.note#intro { margin: 1px; }");
+    auto sheet = parser.parse();
+    ASSERT_EQ(sheet.rules.size(), 1u);
+    const auto& rule = sheet.rules[0];
+    ASSERT_EQ(rule.selectors.size(), 2u);
+
+    // Stored right-to-left: a <descendant- li.item <child- ul
+    const auto& complex = rule.selectors[0];
+    ASSERT_EQ(complex.compounds.size(), 3u);
+    EXPECT_EQ(complex.compounds[0].simple_selectors[0].value, "a");
+    EXPECT_EQ(complex.compounds[0].combinator, Combinator::Descendant);
+    ASSERT_EQ(complex.compounds[1].simple_selectors.size(), 2u);
+    EXPECT_EQ(complex.compounds[1].simple_selectors[0].value, "li");
+    EXPECT_EQ(complex.compounds[1].simple_selectors[1].type, SelectorType::Class);
+    EXPECT_EQ(complex.compounds[1].combinator, Combinator::Child);
+    EXPECT_EQ(complex.compounds[2].simple_selectors[0].value, "ul");
+    EXPECT_EQ(complex.compounds[2].combinator, Combinator::None);
+    EXPECT_EQ(complex.specificity(), 13);
+    EXPECT_NE(complex.ancestor_hashes[0], 0u);
+
+    const auto& compound = rule.selectors[1];
+    ASSERT_EQ(compound.compounds.size(), 1u);
+    EXPECT_EQ(compound.compounds[0].simple_selectors.size(), 3u);
+    EXPECT_EQ(compound.specificity(), 111);
+    EXPECT_EQ(compound.ancestor_hashes[0], 0u);
+}
@@ -0,0 +1,30 @@
+#include "style/CascadedProperties.h"
+
+#include <gtest/gtest.h>
+
+using namespace Hummingbird::Css;
+
+TEST(CascadedPropertiesTest, KeepsWinningDeclarationPerProperty) {
+    CascadedProperties properties;
+    properties.offer(Property::Margin, {Origin::Author, 10, 0, Value::length_value(4.0f, Unit::Px)});
+    properties.offer(Property::Margin, {Origin::Author, 1, 1, Value::length_value(8.0f, Unit::Px)});
+    properties.offer(Property::Margin, {Origin::UserAgent, 100, 2, Value::length_value(16.0f, Unit::Px)});
+    properties.offer(Property::Padding, {Origin::UserAgent, 1, 3, Value::length_value(2.0f, Unit::Px)});
+
+    const Value* margin = properties.find(Property::Margin);
+    ASSERT_NE(margin, nullptr);
+    EXPECT_FLOAT_EQ(margin->length.value, 4.0f);
+    EXPECT_TRUE(properties.has(Property::Padding));
+    EXPECT_EQ(properties.find(Property::Width), nullptr);
+}
+
+TEST(CascadedPropertiesTest, ClearForgetsPreviousNode) {
+    CascadedProperties properties;
+    properties.offer(Property::Display, {Origin::Author, 1, 0, Value::keyword_value(Keyword::None)});
+    properties.clear();
+    EXPECT_FALSE(properties.has(Property::Display));
+
+    properties.offer(Property::Display, {Origin::UserAgent, 1, 0, Value::keyword_value(Keyword::Block)});
+    ASSERT_NE(properties.find(Property::Display), nullptr);
+    EXPECT_EQ(properties.find(Property::Display)->keyword, Keyword::Block);
+}
@@ -0,0 +1,51 @@
+#include "style/CssTokenizer.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace Hummingbird::Css;
+
+namespace {
+std::vector<Token> drain(Tokenizer& tokenizer) {
+    std::vector<Token> tokens;
+    while (true) {
+        Token token = tokenizer.next_token();
+        tokens.push_back(token);
+        if (token.type == TokenType::End) break;
+    }
+    return tokens;
+}
+}  // namespace
+
+TEST(CssTokenizerTest, StreamsTokensOnDemand) {
+    Tokenizer tokenizer(".box { margin: 10px; }");
+    auto tokens = drain(tokenizer);
+
+    ASSERT_EQ(tokens.size(), 10u);
+    EXPECT_EQ(tokens[0].type, TokenType::Dot);
+    EXPECT_EQ(tokens[1].type, TokenType::Identifier);
+    EXPECT_EQ(tokens[1].lexeme, "box");
+    EXPECT_EQ(tokens[2].type, TokenType::LBrace);
+    EXPECT_EQ(tokens[3].lexeme, "margin");
+    EXPECT_EQ(tokens[4].type, TokenType::Colon);
+    EXPECT_EQ(tokens[5].type, TokenType::Number);
+    EXPECT_EQ(tokens[5].lexeme, "10");
+    EXPECT_EQ(tokens[6].lexeme, "px");
+    EXPECT_EQ(tokens[7].type, TokenType::Semicolon);
+    EXPECT_EQ(tokens[8].type, TokenType::RBrace);
+    EXPECT_EQ(tokens[9].type, TokenType::End);
+}
+
+TEST(CssTokenizerTest, LexemesViewIntoInput) {
+    std::string_view input = "div{}";
+    Tokenizer tokenizer(input);
+    Token token = tokenizer.next_token();
+    EXPECT_EQ(token.lexeme.data(), input.data());
+}
+
+TEST(CssTokenizerTest, KeepsReturningEndAfterExhaustion) {
+    Tokenizer tokenizer("  @ ");
+    EXPECT_EQ(tokenizer.next_token().type, TokenType::End);
+    EXPECT_EQ(tokenizer.next_token().type, TokenType::End);
+}
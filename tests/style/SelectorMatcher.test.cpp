@@ -2,11 +2,15 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <string_view>
+
 #include "core/ArenaAllocator.h"
 #include "core/dom/DomFactory.h"
 #include "core/dom/Element.h"
 #include "html/HtmlAttributeNames.h"
 #include "html/HtmlTagNames.h"
+#include "style/CssParser.h"
 
 using namespace Hummingbird::Css;
 using namespace Hummingbird::DOM;
@@ -26,3 +30,32 @@ TEST(SelectorMatcherTest, MatchesTagClassId) {
     EXPECT_TRUE(matches_selector(elem.get(), Selector{SelectorType::Id, "main"}));
     EXPECT_FALSE(matches_selector(elem.get(), Selector{SelectorType::Id, "other"}));
 }
+
+TEST(SelectorMatcherTest, MatchesCombinatorsRightToLeft) {
+    // <ul class="menu"><li><span><a></a></span></li></ul>
+    ArenaAllocator arena(4096);
+    auto ul = DomFactory::create_element(arena, Hummingbird::Html::TagNames::Ul);
+    ul->set_attribute(Attr::Class, "menu");
+    auto li = DomFactory::create_element(arena, Hummingbird::Html::TagNames::Li);
+    auto span = DomFactory::create_element(arena, Hummingbird::Html::TagNames::Span);
+    auto anchor = DomFactory::create_element(arena, Hummingbird::Html::TagNames::A);
+    auto* anchor_ptr = anchor.get();
+    auto* li_ptr = li.get();
+    span->append_child(std::move(anchor));
+    li->append_child(std::move(span));
+    ul->append_child(std::move(li));
+
+    auto parse_selector = [](std::string_view text) {
+        std::string css = std::string(text) + " {}";
+        Parser parser(css);
+        return parser.parse().rules.at(0).selectors.at(0);
+    };
+
+    EXPECT_TRUE(matches_selector(anchor_ptr, parse_selector("ul a")));
+    EXPECT_TRUE(matches_selector(anchor_ptr, parse_selector(".menu li a")));
+    EXPECT_TRUE(matches_selector(anchor_ptr, parse_selector("li > span > a")));
+    EXPECT_FALSE(matches_selector(anchor_ptr, parse_selector("li > a")));
+    EXPECT_FALSE(matches_selector(anchor_ptr, parse_selector("ol a")));
+    EXPECT_TRUE(matches_selector(li_ptr, parse_selector("ul.menu > li")));
+    EXPECT_FALSE(matches_selector(li_ptr, parse_selector("ul.other > li")));
+}
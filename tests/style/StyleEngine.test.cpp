@@ -169,6 +169,30 @@ TEST(StyleEngineTest, LaterRuleWinsOnEqualSpecificity) {
     EXPECT_FLOAT_EQ(style->margin.top, 9.0f);
 }
 
+TEST(StyleEngineTest, AuthorSheetsWinOverUserAgentRegardlessOfSpecificity) {
+    ArenaAllocator arena(2048);
+    auto root = DomFactory::create_element(arena, Hummingbird::Html::TagNames::P);
+    root->set_attribute(Attr::Id, "main");
+
+    Parser ua_parser("#main { margin: 1px; padding: 2px; }");
+    auto ua_sheet = ua_parser.parse();
+    Parser linked_parser("p { margin: 5px; }");
+    auto linked_sheet = linked_parser.parse();
+    Parser inline_parser("p { margin: 7px; }");
+    auto inline_sheet = inline_parser.parse();
+
+    const CascadeSheet sheets[] = {{&ua_sheet, Origin::UserAgent},
+                                   {&linked_sheet, Origin::Author},
+                                   {&inline_sheet, Origin::Author}};
+    StyleEngine engine;
+    engine.apply(sheets, root.get());
+
+    auto style = root->get_computed_style();
+    ASSERT_TRUE(style);
+    EXPECT_FLOAT_EQ(style->margin.top, 7.0f);
+    EXPECT_FLOAT_EQ(style->padding.top, 2.0f);
+}
+
 TEST(StyleEngineTest, AppliesBorderProperties) {
     ArenaAllocator arena(2048);
     auto root = DomFactory::create_element(arena, Hummingbird::Html::TagNames::Div);
@@ -262,6 +286,23 @@ TEST(StyleEngineTest, EmInheritsHeadingTypography) {
     EXPECT_EQ(em_style->style, ComputedStyle::FontStyle::Italic);
 }
 
+TEST(StyleEngineTest, TextWrapPrettyIsInherited) {
+    ArenaAllocator arena(2048);
+    auto div = DomFactory::create_element(arena, Hummingbird::Html::TagNames::Div);
+    div->append_child(DomFactory::create_element(arena, Hummingbird::Html::TagNames::Span));
+
+    Parser parser("div { text-wrap: pretty; }");
+    auto sheet = parser.parse();
+    StyleEngine engine;
+    engine.apply(sheet, div.get());
+
+    ASSERT_TRUE(div->get_computed_style());
+    EXPECT_EQ(div->get_computed_style()->text_wrap, ComputedStyle::TextWrap::Pretty);
+    auto span_style = div->get_children()[0]->get_computed_style();
+    ASSERT_TRUE(span_style);
+    EXPECT_EQ(span_style->text_wrap, ComputedStyle::TextWrap::Pretty);
+}
+
 TEST(StyleEngineTest, AlignAttributeMapsToTextAlign) {
     ArenaAllocator arena(2048);
     auto cell = DomFactory::create_element(arena, Hummingbird::Html::TagNames::Td);
@@ -337,3 +378,107 @@ TEST(StyleEngineTest, FontTagMapsSizeAndFace) {
     EXPECT_EQ(font_style->font_face, "sans-serif");
     EXPECT_EQ(font_style->display, ComputedStyle::Display::Inline);
 }
+
+TEST(StyleEngineTest, AppliesDescendantAndChildSelectors) {
+    // <div class="card"><p><span></span></p></div><p></p>
+    ArenaAllocator arena(4096);
+    auto root = DomFactory::create_element(arena, Hummingbird::Html::TagNames::Body);
+    auto card = DomFactory::create_element(arena, Hummingbird::Html::TagNames::Div);
+    card->set_attribute(Attr::Class, "card");
+    auto inner_p = DomFactory::create_element(arena, Hummingbird::Html::TagNames::P);
+    inner_p->append_child(DomFactory::create_element(arena, Hummingbird::Html::TagNames::Span));
+    auto* inner_p_ptr = inner_p.get();
+    card->append_child(std::move(inner_p));
+    root->append_child(std::move(card));
+    auto outer_p = DomFactory::create_element(arena, Hummingbird::Html::TagNames::P);
+    auto* outer_p_ptr = outer_p.get();
+    root->append_child(std::move(outer_p));
+
+    Parser parser(".card p { margin: 7px; } .card > span { padding: 9px; } div > p span { padding: 4px; }");
+    auto sheet = parser.parse();
+    StyleEngine engine;
+    engine.apply(sheet, root.get());
+
+    EXPECT_FLOAT_EQ(inner_p_ptr->get_computed_style()->margin.top, 7.0f);
+    EXPECT_FLOAT_EQ(outer_p_ptr->get_computed_style()->margin.top, 0.0f);
+    auto span_style = inner_p_ptr->get_children()[0]->get_computed_style();
+    EXPECT_FLOAT_EQ(span_style->padding.top, 4.0f);
+
+    // Restyling a subtree still sees ancestors above the starting node.
+    engine.apply(sheet, inner_p_ptr);
+    EXPECT_FLOAT_EQ(inner_p_ptr->get_computed_style()->margin.top, 7.0f);
+}
+
+namespace {
+// <body><ul id="menu"><li><span>text</span></li><li></li></ul><p></p></body>
+struct MenuTree {
+    ArenaAllocator arena{8192};
+    ArenaPtr<Element> body = DomFactory::create_element(arena, Hummingbird::Html::TagNames::Body);
+    Element* ul = nullptr;
+    Element* first_li = nullptr;
+    Element* span = nullptr;
+    Element* p = nullptr;
+
+    MenuTree() {
+        auto ul_node = DomFactory::create_element(arena, Hummingbird::Html::TagNames::Ul);
+        ul_node->set_attribute(Attr::Id, "menu");
+        auto li1 = DomFactory::create_element(arena, Hummingbird::Html::TagNames::Li);
+        auto span_node = DomFactory::create_element(arena, Hummingbird::Html::TagNames::Span);
+        span_node->append_child(DomFactory::create_text(arena, "text"));
+        span = span_node.get();
+        li1->append_child(std::move(span_node));
+        first_li = li1.get();
+        ul_node->append_child(std::move(li1));
+        ul_node->append_child(DomFactory::create_element(arena, Hummingbird::Html::TagNames::Li));
+        ul = ul_node.get();
+        body->append_child(std::move(ul_node));
+        auto p_node = DomFactory::create_element(arena, Hummingbird::Html::TagNames::P);
+        p = p_node.get();
+        body->append_child(std::move(p_node));
+    }
+};
+}  // namespace
+
+TEST(StyleEngineTest, RestyleOnlyTouchesElementsAffectedByMutation) {
+    MenuTree tree;
+    Parser parser(".open li { margin: 6px; } .active { padding: 3px; }");
+    auto sheet = parser.parse();
+    StyleEngine engine;
+    engine.apply(sheet, tree.body.get());
+    EXPECT_EQ(engine.restyle_count(), 7u);
+
+    // Class only used in subject position: just the element itself.
+    tree.p->set_attribute(Attr::Class, "active");
+    engine.restyle(sheet, tree.body.get());
+    EXPECT_EQ(engine.restyle_count(), 1u);
+    EXPECT_FLOAT_EQ(tree.p->get_computed_style()->padding.top, 3.0f);
+
+    // Class used left of a combinator: the <li> descendants, but not the <span>.
+    tree.ul->set_attribute(Attr::Class, "open");
+    engine.restyle(sheet, tree.body.get());
+    EXPECT_EQ(engine.restyle_count(), 2u);
+    EXPECT_FLOAT_EQ(tree.first_li->get_computed_style()->margin.top, 6.0f);
+
+    // Classes no selector mentions cost nothing.
+    tree.ul->set_attribute(Attr::Class, "open unrelated");
+    engine.restyle(sheet, tree.body.get());
+    EXPECT_EQ(engine.restyle_count(), 0u);
+
+    // Nothing recorded: nothing restyled.
+    engine.restyle(sheet, tree.body.get());
+    EXPECT_EQ(engine.restyle_count(), 0u);
+}
+
+TEST(StyleEngineTest, RestylePropagatesInheritedChangesToDescendants) {
+    MenuTree tree;
+    Parser parser(".warning { color: red; }");
+    auto sheet = parser.parse();
+    StyleEngine engine;
+    engine.apply(sheet, tree.body.get());
+
+    // color inherits, so the span's subtree (span + text) is recomputed; siblings are not.
+    tree.span->set_attribute(Attr::Class, "warning");
+    engine.restyle(sheet, tree.body.get());
+    EXPECT_EQ(engine.restyle_count(), 2u);
+    EXPECT_EQ(tree.span->get_children()[0]->get_computed_style()->color.r, 255);
+}
@@ -0,0 +1,60 @@
+#include "style/StylesheetCache.h"
+
+#include <gtest/gtest.h>
+
+using namespace Hummingbird::Css;
+
+TEST(StylesheetCacheTest, ReusesParsedSheetForSameSourceAndContent) {
+    StylesheetCache cache;
+    auto first = cache.get_or_parse("https://example.dev/site.css", "p { color: red; }");
+    auto second = cache.get_or_parse("https://example.dev/site.css", "p { color: red; }");
+
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(cache.parse_count(), 1u);
+    ASSERT_EQ(first->rules.size(), 1u);
+}
+
+TEST(StylesheetCacheTest, ReparsesWhenContentChanges) {
+    StylesheetCache cache;
+    auto first = cache.get_or_parse("site.css", "p { color: red; }");
+    auto second = cache.get_or_parse("site.css", "p { color: blue; } div { margin: 1px; }");
+
+    EXPECT_NE(first, second);
+    EXPECT_EQ(cache.parse_count(), 2u);
+    EXPECT_EQ(second->rules.size(), 2u);
+}
+
+TEST(StylesheetCacheTest, KeysInlineBlocksByContent) {
+    StylesheetCache cache;
+    auto a = cache.get_or_parse({}, "p { color: red; }");
+    auto b = cache.get_or_parse({}, "p { color: red; }");
+    auto c = cache.get_or_parse({}, "p { color: blue; }");
+
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(StylesheetCacheTest, EvictsLeastRecentlyUsedEntries) {
+    StylesheetCache cache(2);
+    auto a = cache.get_or_parse("a.css", "a { color: red; }");
+    cache.get_or_parse("b.css", "b { color: red; }");
+    cache.get_or_parse("a.css", "a { color: red; }");  // refresh a
+    cache.get_or_parse("c.css", "i { color: red; }");  // evicts b
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.get_or_parse("a.css", "a { color: red; }"), a);
+    EXPECT_EQ(cache.parse_count(), 3u);
+    cache.get_or_parse("b.css", "b { color: red; }");
+    EXPECT_EQ(cache.parse_count(), 4u);
+}
+
+TEST(StylesheetCacheTest, CachedSheetOutlivesEviction) {
+    StylesheetCache cache(1);
+    auto a = cache.get_or_parse("a.css", "a { color: red; }");
+    cache.get_or_parse("b.css", "b { color: red; }");
+
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a->rules.size(), 1u);
+}